@@ -6,22 +6,53 @@
  */
 
 #include "Mesh.hpp"
+#include "MeshOptimizer.hpp"
+#include "MeshSimplifier.hpp"
 #include <Utils/Convert.hpp>
 #include <Utils/XML.hpp>
 #include <Utils/File/Logfile.hpp>
 #include <Utils/File/FileUtils.hpp>
 #include <Utils/StringUtils.hpp>
+#include <Utils/Events/Stream/Stream.hpp>
 #include <Graphics/Texture/TextureManager.hpp>
 #include <Graphics/Shader/ShaderManager.hpp>
 #include <Graphics/Renderer.hpp>
 #include <vector>
 #include <string>
+#include <fstream>
 #include <tinyxml2.h>
 
 using namespace tinyxml2;
 
 namespace sgl {
 
+static void logMeshOptimizationReport(const char *filename, const MeshOptimizationReport &report)
+{
+    Logfile::get()->write(std::string() + "INFO: Mesh::loadFromXML: Optimized submesh of \"" + filename + "\". "
+            + "ACMR: " + toString(report.statisticsBefore.acmr) + " -> " + toString(report.statisticsAfter.acmr)
+            + ", ATVR: " + toString(report.statisticsBefore.atvr) + " -> " + toString(report.statisticsAfter.atvr),
+            BLUE);
+}
+
+//! Version of the binary level of detail cache files written by Mesh::generateLods
+#define MESH_LOD_CACHE_FORMAT_VERSION 2u
+
+//! FNV-1a hash of the index and position buffers. Used for checking whether a level of detail cache file belongs to a
+//! submesh (a change of the positions with the same topology also results in different levels of detail).
+static uint64_t hashGeometry(const std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const uint8_t *buffers[] = { (const uint8_t*)indices.data(), (const uint8_t*)positions.data() };
+    const size_t bufferSizes[] = { indices.size() * sizeof(uint32_t), positions.size() * sizeof(glm::vec3) };
+    for (int i = 0; i < 2; i++) {
+        for (size_t j = 0; j < bufferSizes[i]; j++) {
+            hash ^= uint64_t(buffers[i][j]);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
 void Mesh::render()
 {
     for (auto it = submeshes.begin(); it != submeshes.end(); ++it) {
@@ -37,7 +68,7 @@ void Mesh::computeAABB()
     }
 }
 
-bool Mesh::loadFromXML(const char *filename)
+bool Mesh::loadFromXML(const char *filename, bool optimize, bool keepCpuGeometry)
 {
     XMLDocument doc;
     if (doc.LoadFile(filename) != 0) {
@@ -81,6 +112,17 @@ bool Mesh::loadFromXML(const char *filename)
         SubMeshPtr subMeshData(new SubMesh(textured));
         subMeshData->setVertexMode(vertexMode);
 
+        // Read the indices
+        std::vector<uint32_t> indices;
+        if (useIndices) {
+            std::vector<std::string> indexStringList;
+            splitString(indexDataElement->Attribute("data"), ' ', indexStringList);
+            indices.reserve(numIndices);
+            for (size_t i = 0; i < indexStringList.size(); ++i)
+                indices.push_back(fromString<uint32_t>(indexStringList.at(i)));
+        }
+        bool optimizeSubMesh = optimize && useIndices && vertexMode == VERTEX_MODE_TRIANGLES;
+
         // Set the vertices
         if (textured) {
             // Textured
@@ -95,8 +137,23 @@ bool Mesh::loadFromXML(const char *filename)
                 if (childElement->NextSibling() == 0)
                     break;
             }
+            if (!areIndicesInRange(indices.data(), indices.size(), vertices.size())) {
+                Logfile::get()->writeError(std::string() + "Mesh::loadFromXML: Index out of range in \""
+                        + filename + "\"!");
+                return false;
+            }
+            if (optimizeSubMesh) {
+                logMeshOptimizationReport(filename, optimizeMesh(vertices, indices));
+            }
             numVertices = vertices.size();
             subMeshData->createVertices(&vertices.front(), vertices.size());
+            if (keepCpuGeometry) {
+                std::vector<glm::vec3> positions;
+                positions.reserve(numVertices);
+                for (const auto &vertex : vertices)
+                    positions.push_back(vertex.position);
+                subMeshData->setCpuGeometry(positions, indices);
+            }
         } else {
             // Not textured
             std::vector<VertexPlain> vertices;
@@ -109,39 +166,36 @@ bool Mesh::loadFromXML(const char *filename)
                 if (childElement->NextSibling() == 0)
                     break;
             }
+            if (!areIndicesInRange(indices.data(), indices.size(), vertices.size())) {
+                Logfile::get()->writeError(std::string() + "Mesh::loadFromXML: Index out of range in \""
+                        + filename + "\"!");
+                return false;
+            }
+            if (optimizeSubMesh) {
+                logMeshOptimizationReport(filename, optimizeMesh(vertices, indices));
+            }
             numVertices = vertices.size();
             subMeshData->createVertices(&vertices.front(), vertices.size());
+            if (keepCpuGeometry) {
+                std::vector<glm::vec3> positions;
+                positions.reserve(numVertices);
+                for (const auto &vertex : vertices)
+                    positions.push_back(vertex.position);
+                subMeshData->setCpuGeometry(positions, indices);
+            }
         }
 
         if (useIndices) {
-            std::vector<std::string> indexStringList;
-            splitString(indexDataElement->Attribute("data"), ' ', indexStringList);
-            numIndices = indexStringList.size();
-
             // Add 8-/16-/32-bit indices
             if (numVertices <= UINT8_MAX) {
-                std::vector<uint8_t> indices;
-                indices.reserve(numIndices);
-                for (size_t i = 0; i < indexStringList.size(); ++i)
-                    indices.push_back(fromString<uint32_t>(indexStringList.at(i)));
-                numIndices = indices.size();
-                subMeshData->createIndices(&indices.front(), indices.size());
+                std::vector<uint8_t> indices8(indices.begin(), indices.end());
+                subMeshData->createIndices(&indices8.front(), indices8.size());
             } else if (numVertices <= UINT16_MAX) {
-                std::vector<uint16_t> indices;
-                indices.reserve(numIndices);
-                for (size_t i = 0; i < indexStringList.size(); ++i)
-                    indices.push_back(fromString<uint32_t>(indexStringList.at(i)));
-                numIndices = indices.size();
-                subMeshData->createIndices(&indices.front(), indices.size());
+                std::vector<uint16_t> indices16(indices.begin(), indices.end());
+                subMeshData->createIndices(&indices16.front(), indices16.size());
             } else {
-                std::vector<uint32_t> indices;
-                indices.reserve(numIndices);
-                for (size_t i = 0; i < indexStringList.size(); ++i)
-                    indices.push_back(fromString<uint32_t>(indexStringList.at(i)));
-                numIndices = indices.size();
                 subMeshData->createIndices(&indices.front(), indices.size());
             }
-
         }
 
         // Read the material data
@@ -208,4 +262,182 @@ void Mesh::finalizeManualMesh()
     computeAABB();
 }
 
+void Mesh::buildMeshlets(size_t maxVertices, size_t maxTriangles)
+{
+    for (SubMeshPtr &submesh : submeshes) {
+        if (!submesh->getCpuIndices().empty()) {
+            submesh->buildMeshlets(maxVertices, maxTriangles);
+        }
+    }
+}
+
+void Mesh::setMeshletCulling(bool enabled)
+{
+    for (SubMeshPtr &submesh : submeshes) {
+        submesh->setMeshletCulling(enabled);
+    }
+}
+
+void Mesh::generateLods(size_t numLods, float reductionFactor, const std::string &cacheFilename)
+{
+    std::vector<SubMesh*> submeshPointers;
+    for (SubMeshPtr &submesh : submeshes) {
+        submeshPointers.push_back(submesh.get());
+    }
+    const size_t numSubmeshes = submeshPointers.size();
+    std::vector<std::vector<MeshLod>> submeshLods(numSubmeshes);
+
+    bool loadedFromCache = !cacheFilename.empty() && FileUtils::get()->exists(cacheFilename)
+            && loadLodCache(cacheFilename, numLods, reductionFactor, submeshLods);
+    if (!loadedFromCache) {
+        // Discard what an invalid cache file might have filled in.
+        submeshLods.clear();
+        submeshLods.resize(numSubmeshes);
+        #pragma omp parallel for shared(submeshPointers, submeshLods, numSubmeshes, numLods, reductionFactor) \
+                schedule(dynamic) default(none)
+        for (size_t i = 0; i < numSubmeshes; i++) {
+            SubMesh *submesh = submeshPointers[i];
+            const std::vector<glm::vec3> &positions = submesh->getCpuPositions();
+            const std::vector<uint32_t> &indices = submesh->getCpuIndices();
+            if (positions.empty() || indices.empty()
+                    || submesh->renderData->getVertexMode() != VERTEX_MODE_TRIANGLES) {
+                continue;
+            }
+            generateLodChain(submeshLods[i], &indices.front(), indices.size(), &positions.front(), positions.size(),
+                    numLods, reductionFactor);
+        }
+        if (!cacheFilename.empty()) {
+            saveLodCache(cacheFilename, numLods, reductionFactor, submeshLods);
+        }
+    }
+
+    // The upload needs to happen on the thread owning the rendering context
+    for (size_t i = 0; i < numSubmeshes; i++) {
+        if (!submeshLods[i].empty()) {
+            submeshPointers[i]->setLods(submeshLods[i]);
+        }
+    }
+}
+
+void Mesh::setLodSelection(bool enabled, float maxPixelError)
+{
+    for (SubMeshPtr &submesh : submeshes) {
+        submesh->setLodSelection(enabled, maxPixelError);
+    }
+}
+
+bool Mesh::loadLodCache(const std::string &filename, size_t numLods, float reductionFactor,
+        std::vector<std::vector<MeshLod>> &submeshLods)
+{
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    if (!file.is_open()) {
+        Logfile::get()->writeError(std::string() + "Mesh::loadLodCache: Couldn't open file \"" + filename + "\"!");
+        return false;
+    }
+
+    file.seekg(0, file.end);
+    size_t size = file.tellg();
+    file.seekg(0);
+    char *buffer = new char[size];
+    file.read(buffer, size);
+    file.close();
+
+    // The cache is only valid if the version, the settings and the original geometry match
+    BinaryReadStream stream(buffer, size);
+    uint32_t version = 0, numSubmeshesFile = 0, numLodsFile = 0;
+    float reductionFactorFile = 0.0f;
+    stream.read(version);
+    stream.read(numLodsFile);
+    stream.read(reductionFactorFile);
+    stream.read(numSubmeshesFile);
+    if (version != MESH_LOD_CACHE_FORMAT_VERSION || numLodsFile != numLods || reductionFactorFile != reductionFactor
+            || numSubmeshesFile != submeshes.size()) {
+        Logfile::get()->write(std::string() + "INFO: Mesh::loadLodCache: Outdated cache file \"" + filename + "\".",
+                BLUE);
+        return false;
+    }
+
+    bool isCorrupted = false;
+    for (size_t i = 0; i < submeshes.size(); i++) {
+        uint32_t numVertices = 0, numIndices = 0, numSubmeshLods = 0;
+        uint64_t geometryHash = 0;
+        stream.read(numVertices);
+        stream.read(numIndices);
+        stream.read(geometryHash);
+        stream.read(numSubmeshLods);
+        const std::vector<glm::vec3> &positions = submeshes.at(i)->getCpuPositions();
+        const std::vector<uint32_t> &indices = submeshes.at(i)->getCpuIndices();
+        if (numVertices != positions.size() || numIndices != indices.size()
+                || geometryHash != hashGeometry(indices, positions)) {
+            Logfile::get()->write(std::string() + "INFO: Mesh::loadLodCache: Outdated cache file \"" + filename
+                    + "\".", BLUE);
+            return false;
+        }
+        if (stream.getHasReadError() || numSubmeshLods > numLods) {
+            isCorrupted = true;
+            break;
+        }
+
+        // A corrupted file must neither result in huge allocations nor in indices out of the vertex buffer.
+        submeshLods.at(i).resize(numSubmeshLods);
+        for (MeshLod &lod : submeshLods.at(i)) {
+            uint32_t numLodIndices = 0;
+            stream.read(lod.error);
+            stream.read(numLodIndices);
+            if (stream.getHasReadError() || size_t(numLodIndices) * sizeof(uint32_t) > stream.getNumBytesLeft()) {
+                isCorrupted = true;
+                break;
+            }
+            lod.indices.resize(numLodIndices);
+            if (numLodIndices > 0) {
+                stream.read(&lod.indices.front(), numLodIndices * sizeof(uint32_t));
+            }
+            for (uint32_t index : lod.indices) {
+                isCorrupted = isCorrupted || index >= numVertices;
+            }
+        }
+        if (isCorrupted) {
+            break;
+        }
+    }
+
+    if (isCorrupted || stream.getHasReadError() || stream.getNumBytesLeft() != 0) {
+        Logfile::get()->writeError(std::string() + "ERROR: Mesh::loadLodCache: Corrupted cache file \"" + filename
+                + "\".");
+        return false;
+    }
+    return true;
+}
+
+bool Mesh::saveLodCache(const std::string &filename, size_t numLods, float reductionFactor,
+        const std::vector<std::vector<MeshLod>> &submeshLods)
+{
+    std::ofstream file(filename.c_str(), std::ofstream::binary);
+    if (!file.is_open()) {
+        Logfile::get()->writeError(std::string() + "Mesh::saveLodCache: Couldn't open file \"" + filename + "\"!");
+        return false;
+    }
+
+    BinaryWriteStream stream;
+    stream.write((uint32_t)MESH_LOD_CACHE_FORMAT_VERSION);
+    stream.write((uint32_t)numLods);
+    stream.write(reductionFactor);
+    stream.write((uint32_t)submeshes.size());
+    for (size_t i = 0; i < submeshes.size(); i++) {
+        const std::vector<uint32_t> &indices = submeshes.at(i)->getCpuIndices();
+        stream.write((uint32_t)submeshes.at(i)->getCpuPositions().size());
+        stream.write((uint32_t)indices.size());
+        stream.write(hashGeometry(indices, submeshes.at(i)->getCpuPositions()));
+        stream.write((uint32_t)submeshLods.at(i).size());
+        for (const MeshLod &lod : submeshLods.at(i)) {
+            stream.write(lod.error);
+            stream.writeArray(lod.indices);
+        }
+    }
+    file.write((const char*)stream.getBuffer(), stream.getSize());
+    file.close();
+
+    return true;
+}
+
 }
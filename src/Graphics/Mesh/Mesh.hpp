@@ -10,6 +10,7 @@
 
 #include "SubMesh.hpp"
 #include <vector>
+#include <string>
 
 namespace sgl {
 
@@ -17,15 +18,40 @@ class DLL_OBJECT Mesh
 {
 public:
     void render();
-    bool loadFromXML(const char *filename);
+    /*! Loads a mesh from a MeshXML file.
+     * \param optimize Whether to reorder the vertices and indices of triangle submeshes for better vertex cache
+     * locality, less overdraw and better vertex fetch locality before uploading them (see MeshOptimizer.hpp).
+     * \param keepCpuGeometry Whether the submeshes keep a CPU-side copy of their positions and indices
+     * (needed for e.g. meshlet culling). */
+    bool loadFromXML(const char *filename, bool optimize = false, bool keepCpuGeometry = false);
     inline const AABB3 &getAABB() const { return aabb; }
+    inline const std::vector<SubMeshPtr> &getSubMeshes() const { return submeshes; }
 
     //! Call these functions to create a mesh manually
     void addSubMesh(SubMeshPtr &submesh);
     void finalizeManualMesh();
 
+    //! Splits all submeshes with CPU-side geometry into meshlets (see SubMesh::buildMeshlets).
+    void buildMeshlets(size_t maxVertices = 64, size_t maxTriangles = 124);
+    //! If enabled, only the meshlets visible for the current camera are rendered.
+    void setMeshletCulling(bool enabled);
+
+    /*! Generates numLods levels of detail (including the original geometry as level 0) for all submeshes with
+     * CPU-side indexed triangle data using quadric simplification (see MeshSimplifier.hpp). The submeshes are
+     * simplified in parallel.
+     * \param cacheFilename If not empty, the levels of detail are loaded from this binary file if it matches the
+     * mesh and the passed settings. Otherwise, they are generated and saved to this file. */
+    void generateLods(size_t numLods = 4, float reductionFactor = 0.5f, const std::string &cacheFilename = "");
+    /*! If enabled, every submesh renders the coarsest level of detail whose error projected to the viewport is at
+     * most maxPixelError pixels (see SubMesh::selectLod). */
+    void setLodSelection(bool enabled, float maxPixelError = 1.0f);
+
 private:
     void computeAABB();
+    bool loadLodCache(const std::string &filename, size_t numLods, float reductionFactor,
+            std::vector<std::vector<MeshLod>> &submeshLods);
+    bool saveLodCache(const std::string &filename, size_t numLods, float reductionFactor,
+            const std::vector<std::vector<MeshLod>> &submeshLods);
     std::vector<SubMeshPtr> submeshes;
     AABB3 aabb;
 };
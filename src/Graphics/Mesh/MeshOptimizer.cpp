@@ -0,0 +1,379 @@
+/*
+ * MeshOptimizer.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MeshOptimizer.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace sgl {
+
+bool areIndicesInRange(const uint32_t *indices, size_t numIndices, size_t numVertices)
+{
+    for (size_t i = 0; i < numIndices; ++i) {
+        if (indices[i] >= numVertices) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*! Simulates a FIFO cache using timestamps. A vertex is in the cache if it was inserted less than cacheSize insertions
+ * ago. Returns the number of cache misses of the passed triangle. */
+class FifoCacheSimulator {
+public:
+    FifoCacheSimulator(size_t numVertices, size_t cacheSize)
+        : cacheTimestamps(numVertices, 0), cacheSize(cacheSize), timestamp(cacheSize + 1) {}
+
+    inline int processTriangle(const uint32_t *triangle) {
+        int misses = 0;
+        for (int i = 0; i < 3; ++i) {
+            uint32_t vertexIdx = triangle[i];
+            if (timestamp - cacheTimestamps[vertexIdx] > cacheSize) {
+                cacheTimestamps[vertexIdx] = timestamp++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+
+    //! Invalidates all entries in the cache
+    inline void flush() { timestamp += cacheSize + 1; }
+
+private:
+    std::vector<size_t> cacheTimestamps;
+    size_t cacheSize;
+    size_t timestamp;
+};
+
+VertexCacheStatistics analyzeVertexCache(
+        const uint32_t *indices, size_t numIndices, size_t numVertices, size_t cacheSize)
+{
+    VertexCacheStatistics statistics;
+    statistics.numTriangles = numIndices / 3;
+    if (statistics.numTriangles == 0) {
+        return statistics;
+    }
+
+    FifoCacheSimulator cache(numVertices, cacheSize);
+    std::vector<bool> vertexReferenced(numVertices, false);
+    for (size_t i = 0; i + 2 < numIndices; i += 3) {
+        statistics.numTransformedVertices += cache.processTriangle(indices + i);
+        for (int j = 0; j < 3; ++j) {
+            if (!vertexReferenced[indices[i + j]]) {
+                vertexReferenced[indices[i + j]] = true;
+                statistics.numVertices++;
+            }
+        }
+    }
+
+    statistics.acmr = float(statistics.numTransformedVertices) / float(statistics.numTriangles);
+    statistics.atvr = float(statistics.numTransformedVertices) / float(statistics.numVertices);
+    return statistics;
+}
+
+
+
+// ---------------------------------------------- Forsyth's algorithm ----------------------------------------------
+
+const int FORSYTH_CACHE_SIZE = 32;
+const int FORSYTH_MAX_VALENCE = 32;
+const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+struct ForsythScoreTables {
+    ForsythScoreTables() {
+        for (int i = 0; i < FORSYTH_CACHE_SIZE; ++i) {
+            if (i < 3) {
+                // The vertices of the last triangle are used with a fixed score to avoid hitting them too often.
+                cacheScore[i] = FORSYTH_LAST_TRIANGLE_SCORE;
+            } else {
+                const float scaler = 1.0f / float(FORSYTH_CACHE_SIZE - 3);
+                cacheScore[i] = std::pow(1.0f - float(i - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+            }
+        }
+        valenceScore[0] = 0.0f;
+        for (int i = 1; i < FORSYTH_MAX_VALENCE; ++i) {
+            // Bonus points for vertices with only few triangles left to avoid lone triangles at the end.
+            valenceScore[i] = FORSYTH_VALENCE_BOOST_SCALE * std::pow(float(i), -FORSYTH_VALENCE_BOOST_POWER);
+        }
+    }
+
+    inline float getVertexScore(int cachePosition, uint32_t numLiveTriangles) const {
+        if (numLiveTriangles == 0) {
+            // No triangles left that use this vertex
+            return -1.0f;
+        }
+        float score = cachePosition >= 0 ? cacheScore[cachePosition] : 0.0f;
+        score += numLiveTriangles < uint32_t(FORSYTH_MAX_VALENCE) ? valenceScore[numLiveTriangles]
+                : FORSYTH_VALENCE_BOOST_SCALE * std::pow(float(numLiveTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    float cacheScore[FORSYTH_CACHE_SIZE];
+    float valenceScore[FORSYTH_MAX_VALENCE];
+};
+
+void optimizeVertexCache(uint32_t *indices, size_t numIndices, size_t numVertices)
+{
+    static const ForsythScoreTables scoreTables;
+    const size_t numTriangles = numIndices / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    // Build the vertex -> triangle adjacency in a compressed row storage layout.
+    std::vector<uint32_t> numLiveTriangles(numVertices, 0);
+    for (size_t i = 0; i < numTriangles * 3; ++i) {
+        numLiveTriangles[indices[i]]++;
+    }
+    std::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (size_t i = 0; i < numVertices; ++i) {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + numLiveTriangles[i];
+    }
+    std::vector<uint32_t> adjacentTriangles(numTriangles * 3);
+    std::vector<uint32_t> fillCounts(numVertices, 0);
+    for (size_t triangleIdx = 0; triangleIdx < numTriangles; ++triangleIdx) {
+        for (int j = 0; j < 3; ++j) {
+            uint32_t vertexIdx = indices[triangleIdx * 3 + j];
+            adjacentTriangles[adjacencyOffsets[vertexIdx] + fillCounts[vertexIdx]++] = uint32_t(triangleIdx);
+        }
+    }
+
+    // Initial scores
+    std::vector<float> vertexScores(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        vertexScores[i] = scoreTables.getVertexScore(-1, numLiveTriangles[i]);
+    }
+    std::vector<float> triangleScores(numTriangles);
+    std::vector<bool> triangleEmitted(numTriangles, false);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        const uint32_t *triangle = indices + i * 3;
+        triangleScores[i] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+    }
+
+    std::vector<uint32_t> newIndices(numTriangles * 3);
+    int cache[FORSYTH_CACHE_SIZE + 3];
+    int newCache[FORSYTH_CACHE_SIZE + 3];
+    int cacheCount = 0;
+    size_t nextUnemittedTriangle = 0;
+
+    uint32_t bestTriangle = UINT32_MAX;
+    float bestScore = -1.0f;
+    for (size_t i = 0; i < numTriangles; ++i) {
+        if (triangleScores[i] > bestScore) {
+            bestScore = triangleScores[i];
+            bestTriangle = uint32_t(i);
+        }
+    }
+
+    for (size_t outputTriangle = 0; outputTriangle < numTriangles; ++outputTriangle) {
+        if (bestTriangle == UINT32_MAX) {
+            // No triangle in the cache neighborhood: Continue with the next triangle in input order.
+            while (triangleEmitted[nextUnemittedTriangle]) {
+                nextUnemittedTriangle++;
+            }
+            bestTriangle = uint32_t(nextUnemittedTriangle);
+        }
+
+        const uint32_t *triangle = indices + bestTriangle * 3;
+        triangleEmitted[bestTriangle] = true;
+        for (int j = 0; j < 3; ++j) {
+            uint32_t vertexIdx = triangle[j];
+            newIndices[outputTriangle * 3 + j] = vertexIdx;
+
+            // Remove the emitted triangle from the adjacency list of the vertex
+            uint32_t *begin = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+            uint32_t *end = begin + numLiveTriangles[vertexIdx];
+            uint32_t *it = std::find(begin, end, bestTriangle);
+            std::swap(*it, *(end - 1));
+            numLiveTriangles[vertexIdx]--;
+        }
+
+        // Move the vertices of the emitted triangle to the front of the LRU cache
+        int newCacheCount = 0;
+        for (int j = 0; j < 3; ++j) {
+            // Degenerate triangles may reference the same vertex multiple times
+            if (std::find(newCache, newCache + newCacheCount, int(triangle[j])) == newCache + newCacheCount) {
+                newCache[newCacheCount++] = int(triangle[j]);
+            }
+        }
+        for (int j = 0; j < cacheCount; ++j) {
+            int vertexIdx = cache[j];
+            if (vertexIdx != int(triangle[0]) && vertexIdx != int(triangle[1]) && vertexIdx != int(triangle[2])) {
+                newCache[newCacheCount++] = vertexIdx;
+            }
+        }
+        std::copy(newCache, newCache + newCacheCount, cache);
+        cacheCount = newCacheCount;
+
+        // Update the scores of all vertices in the cache and of all triangles adjacent to them
+        for (int j = 0; j < cacheCount; ++j) {
+            int vertexIdx = cache[j];
+            int cachePosition = j < FORSYTH_CACHE_SIZE ? j : -1;
+            float newScore = scoreTables.getVertexScore(cachePosition, numLiveTriangles[vertexIdx]);
+            float scoreDiff = newScore - vertexScores[vertexIdx];
+            vertexScores[vertexIdx] = newScore;
+
+            const uint32_t *adjacencyBegin = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+            for (uint32_t k = 0; k < numLiveTriangles[vertexIdx]; ++k) {
+                triangleScores[adjacencyBegin[k]] += scoreDiff;
+            }
+        }
+        cacheCount = std::min(cacheCount, FORSYTH_CACHE_SIZE);
+
+        // Only triangles adjacent to the cached vertices can have changed their score
+        bestTriangle = UINT32_MAX;
+        bestScore = -1.0f;
+        for (int j = 0; j < cacheCount; ++j) {
+            int vertexIdx = cache[j];
+            const uint32_t *adjacencyBegin = &adjacentTriangles[adjacencyOffsets[vertexIdx]];
+            for (uint32_t k = 0; k < numLiveTriangles[vertexIdx]; ++k) {
+                uint32_t triangleIdx = adjacencyBegin[k];
+                if (triangleScores[triangleIdx] > bestScore) {
+                    bestScore = triangleScores[triangleIdx];
+                    bestTriangle = triangleIdx;
+                }
+            }
+        }
+    }
+
+    std::copy(newIndices.begin(), newIndices.end(), indices);
+}
+
+
+
+// ---------------------------------------------- Overdraw optimization ----------------------------------------------
+
+struct TriangleCluster {
+    size_t firstTriangle, numTriangles;
+    float sortKey;
+};
+
+void optimizeOverdraw(
+        uint32_t *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+        size_t positionStride, float threshold)
+{
+    const size_t cacheSize = 16;
+    const size_t numTriangles = numIndices / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+
+    const uint8_t *positionBytes = reinterpret_cast<const uint8_t*>(positions);
+    auto getPosition = [positionBytes, positionStride](uint32_t vertexIdx) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(positionBytes + positionStride * vertexIdx);
+    };
+
+    // 1. Hard boundaries: The cache was effectively flushed if a triangle misses all of its vertices.
+    std::vector<size_t> hardBoundaries;
+    FifoCacheSimulator cache(numVertices, cacheSize);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        if (cache.processTriangle(indices + i * 3) == 3) {
+            hardBoundaries.push_back(i);
+        }
+    }
+    hardBoundaries.push_back(numTriangles);
+
+    // 2. Soft boundaries: Split the hard clusters further as long as the ACMR doesn't get worse than the threshold.
+    std::vector<TriangleCluster> clusters;
+    for (size_t hardIdx = 0; hardIdx + 1 < hardBoundaries.size(); ++hardIdx) {
+        size_t begin = hardBoundaries.at(hardIdx), end = hardBoundaries.at(hardIdx + 1);
+
+        cache.flush();
+        size_t clusterMisses = 0;
+        for (size_t i = begin; i < end; ++i) {
+            clusterMisses += cache.processTriangle(indices + i * 3);
+        }
+        float clusterThreshold = threshold * float(clusterMisses) / float(end - begin);
+
+        cache.flush();
+        size_t subclusterBegin = begin;
+        size_t subclusterMisses = 0;
+        for (size_t i = begin; i < end; ++i) {
+            subclusterMisses += cache.processTriangle(indices + i * 3);
+            if (float(subclusterMisses) / float(i + 1 - subclusterBegin) <= clusterThreshold || i + 1 == end) {
+                TriangleCluster cluster;
+                cluster.firstTriangle = subclusterBegin;
+                cluster.numTriangles = i + 1 - subclusterBegin;
+                clusters.push_back(cluster);
+                subclusterBegin = i + 1;
+                subclusterMisses = 0;
+                cache.flush();
+            }
+        }
+    }
+
+    // 3. Sort the clusters by their dot product of the cluster normal and the offset to the mesh centroid.
+    // Clusters facing away from the mesh center are likely to occlude the other clusters.
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    std::vector<glm::vec3> clusterCentroids(clusters.size());
+    std::vector<glm::vec3> clusterNormals(clusters.size());
+    for (size_t clusterIdx = 0; clusterIdx < clusters.size(); ++clusterIdx) {
+        const TriangleCluster &cluster = clusters.at(clusterIdx);
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        float clusterArea = 0.0f;
+        for (size_t i = cluster.firstTriangle; i < cluster.firstTriangle + cluster.numTriangles; ++i) {
+            const glm::vec3 &p0 = getPosition(indices[i * 3]);
+            const glm::vec3 &p1 = getPosition(indices[i * 3 + 1]);
+            const glm::vec3 &p2 = getPosition(indices[i * 3 + 2]);
+            glm::vec3 areaNormal = glm::cross(p1 - p0, p2 - p0);
+            float area = glm::length(areaNormal);
+            centroid += (p0 + p1 + p2) * (area / 3.0f);
+            normal += areaNormal;
+            clusterArea += area;
+        }
+        meshCentroid += centroid;
+        meshArea += clusterArea;
+        clusterCentroids.at(clusterIdx) = clusterArea > 0.0f ? centroid / clusterArea : centroid;
+        float normalLength = glm::length(normal);
+        clusterNormals.at(clusterIdx) = normalLength > 0.0f ? normal / normalLength : normal;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+    for (size_t clusterIdx = 0; clusterIdx < clusters.size(); ++clusterIdx) {
+        clusters.at(clusterIdx).sortKey = glm::dot(
+                clusterCentroids.at(clusterIdx) - meshCentroid, clusterNormals.at(clusterIdx));
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const TriangleCluster &a, const TriangleCluster &b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<uint32_t> newIndices;
+    newIndices.reserve(numTriangles * 3);
+    for (const TriangleCluster &cluster : clusters) {
+        newIndices.insert(newIndices.end(), indices + cluster.firstTriangle * 3,
+                indices + (cluster.firstTriangle + cluster.numTriangles) * 3);
+    }
+    std::copy(newIndices.begin(), newIndices.end(), indices);
+}
+
+
+
+// --------------------------------------------- Vertex fetch optimization ---------------------------------------------
+
+size_t optimizeVertexFetchRemap(
+        std::vector<uint32_t> &remapTable, uint32_t *indices, size_t numIndices, size_t numVertices)
+{
+    remapTable.clear();
+    remapTable.resize(numVertices, UINT32_MAX);
+
+    uint32_t numRemappedVertices = 0;
+    for (size_t i = 0; i < numIndices; ++i) {
+        uint32_t &remappedIndex = remapTable[indices[i]];
+        if (remappedIndex == UINT32_MAX) {
+            remappedIndex = numRemappedVertices++;
+        }
+        indices[i] = remappedIndex;
+    }
+    return numRemappedVertices;
+}
+
+}
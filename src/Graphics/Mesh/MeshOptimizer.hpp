@@ -0,0 +1,115 @@
+/*!
+ * MeshOptimizer.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_MESHOPTIMIZER_HPP_
+#define GRAPHICS_MESH_MESHOPTIMIZER_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+
+namespace sgl {
+
+/*! Mesh optimization stage for indexed triangle lists. All functions work on CPU-side arrays and are meant to be
+ * called before the data is uploaded to the GPU (e.g. before SubMesh::createVertices/createIndices).
+ * The recommended order is: optimizeVertexCache -> optimizeOverdraw -> optimizeVertexFetch. */
+
+//! Statistics of the post-transform vertex cache (simulated as a FIFO cache like on most hardware).
+struct DLL_OBJECT VertexCacheStatistics {
+    VertexCacheStatistics() : numTransformedVertices(0), numTriangles(0), numVertices(0), acmr(0.0f), atvr(0.0f) {}
+    size_t numTransformedVertices;
+    size_t numTriangles;
+    size_t numVertices;
+    //! Average cache miss ratio: Transformed vertices per triangle (best case ~0.5, worst case 3).
+    float acmr;
+    //! Average transformed vertex ratio: Transformed vertices per referenced vertex (best case 1).
+    float atvr;
+};
+
+/*! Returns whether all indices are smaller than numVertices. The functions below expect valid indices, so check
+ * indices from untrusted sources (e.g. files) with this function first. */
+DLL_OBJECT bool areIndicesInRange(const uint32_t *indices, size_t numIndices, size_t numVertices);
+
+/*! Simulates a FIFO post-transform cache with the passed size and computes the ACMR and ATVR.
+ * \param numVertices is the number of vertices in the vertex buffer the indices refer to. */
+DLL_OBJECT VertexCacheStatistics analyzeVertexCache(
+        const uint32_t *indices, size_t numIndices, size_t numVertices, size_t cacheSize = 16);
+
+/*! Reorders the triangles to maximize the post-transform vertex cache hit rate.
+ * Uses Tom Forsyth's linear-speed vertex cache optimization algorithm with a simulated LRU cache of size 32.
+ * For more details see: https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html */
+DLL_OBJECT void optimizeVertexCache(uint32_t *indices, size_t numIndices, size_t numVertices);
+
+/*! Reorders clusters of triangles to reduce overdraw without destroying the vertex cache locality too much.
+ * Expects indices that were already optimized with optimizeVertexCache.
+ * Based on: Sander et al. 2007, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw".
+ * \param positions points to the position of the first vertex.
+ * \param positionStride is the offset in byte between two vertex positions (e.g. sizeof(VertexTextured)).
+ * \param threshold is the ACMR factor a cluster may get worse compared to the original order (e.g. 1.05). */
+DLL_OBJECT void optimizeOverdraw(
+        uint32_t *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+        size_t positionStride = sizeof(glm::vec3), float threshold = 1.05f);
+
+/*! Computes a remapping table that reorders the vertices in the order they are first referenced by the indices.
+ * The indices are updated in place. Unreferenced vertices are dropped (they are mapped to UINT32_MAX).
+ * Use remapVertexBuffer afterwards to reorder the vertex data.
+ * \return The number of vertices in the remapped vertex buffer. */
+DLL_OBJECT size_t optimizeVertexFetchRemap(
+        std::vector<uint32_t> &remapTable, uint32_t *indices, size_t numIndices, size_t numVertices);
+
+//! Reorders the vertices using a remapping table created by optimizeVertexFetchRemap.
+template<class VertexType>
+void remapVertexBuffer(std::vector<VertexType> &vertices, const std::vector<uint32_t> &remapTable,
+        size_t numRemappedVertices)
+{
+    std::vector<VertexType> remappedVertices;
+    remappedVertices.reserve(numRemappedVertices);
+    // Vertex types may not be default-constructible, so fill the array with copies first.
+    remappedVertices.resize(numRemappedVertices, vertices.front());
+    for (size_t i = 0; i < vertices.size(); ++i) {
+        if (remapTable.at(i) != UINT32_MAX) {
+            remappedVertices.at(remapTable.at(i)) = vertices.at(i);
+        }
+    }
+    vertices.swap(remappedVertices);
+}
+
+struct DLL_OBJECT MeshOptimizationReport {
+    VertexCacheStatistics statisticsBefore;
+    VertexCacheStatistics statisticsAfter;
+};
+
+/*! Runs the full optimization pipeline (vertex cache, overdraw and vertex fetch) on an indexed triangle list.
+ * VertexType needs a member "glm::vec3 position" (e.g. VertexPlain or VertexTextured).
+ * If an index is out of range, the data is left unchanged and an empty report is returned. */
+template<class VertexType>
+MeshOptimizationReport optimizeMesh(std::vector<VertexType> &vertices, std::vector<uint32_t> &indices)
+{
+    MeshOptimizationReport report;
+    if (vertices.empty() || indices.size() < 3
+            || !areIndicesInRange(&indices.front(), indices.size(), vertices.size())) {
+        return report;
+    }
+
+    report.statisticsBefore = analyzeVertexCache(&indices.front(), indices.size(), vertices.size());
+    optimizeVertexCache(&indices.front(), indices.size(), vertices.size());
+    optimizeOverdraw(&indices.front(), indices.size(), &vertices.front().position, vertices.size(),
+            sizeof(VertexType));
+
+    std::vector<uint32_t> remapTable;
+    size_t numRemappedVertices = optimizeVertexFetchRemap(
+            remapTable, &indices.front(), indices.size(), vertices.size());
+    remapVertexBuffer(vertices, remapTable, numRemappedVertices);
+    report.statisticsAfter = analyzeVertexCache(&indices.front(), indices.size(), vertices.size());
+    return report;
+}
+
+}
+
+/*! GRAPHICS_MESH_MESHOPTIMIZER_HPP_ */
+#endif
@@ -0,0 +1,198 @@
+/*
+ * MeshPicker.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MeshPicker.hpp"
+#include <set>
+#include <Graphics/Scene/Camera.hpp>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+size_t MeshPicker::addInstance(const MeshPtr &mesh, const glm::mat4 &modelMatrix)
+{
+    PickingInstance instance;
+    instance.mesh = mesh;
+    instance.modelMatrix = modelMatrix;
+    instance.inverseModelMatrix = glm::inverse(modelMatrix);
+    instance.isUsed = true;
+
+    size_t instanceId;
+    if (freeInstanceIds.empty()) {
+        instanceId = instances.size();
+        instances.push_back(instance);
+    } else {
+        instanceId = freeInstanceIds.back();
+        freeInstanceIds.pop_back();
+        instances.at(instanceId) = instance;
+    }
+    topLevelRebuildNeeded = true;
+    return instanceId;
+}
+
+void MeshPicker::removeInstance(size_t instanceId)
+{
+    if (instanceId >= instances.size() || !instances.at(instanceId).isUsed) {
+        Logfile::get()->writeError(std::string() + "ERROR: MeshPicker::removeInstance: Invalid instance ID.");
+        return;
+    }
+    instances.at(instanceId) = PickingInstance();
+    instances.at(instanceId).isUsed = false;
+    freeInstanceIds.push_back(instanceId);
+    topLevelRebuildNeeded = true;
+}
+
+void MeshPicker::setInstanceTransform(size_t instanceId, const glm::mat4 &modelMatrix)
+{
+    if (instanceId >= instances.size() || !instances.at(instanceId).isUsed) {
+        Logfile::get()->writeError(std::string() + "ERROR: MeshPicker::setInstanceTransform: Invalid instance ID.");
+        return;
+    }
+    PickingInstance &instance = instances.at(instanceId);
+    instance.modelMatrix = modelMatrix;
+    instance.inverseModelMatrix = glm::inverse(modelMatrix);
+    topLevelRefitNeeded = true;
+}
+
+void MeshPicker::updateSubMeshGeometry(SubMesh *submesh)
+{
+    auto it = triangleBVHs.find(submesh);
+    if (it == triangleBVHs.end()) {
+        return;
+    }
+    const std::vector<glm::vec3> &positions = submesh->getCpuPositions();
+    if (positions.empty()) {
+        triangleBVHs.erase(it);
+        topLevelRebuildNeeded = true;
+        return;
+    }
+    it->second.triangleBVH.refit(&positions.front());
+    topLevelRefitNeeded = true;
+}
+
+void MeshPicker::clear()
+{
+    instances.clear();
+    freeInstanceIds.clear();
+    triangleBVHs.clear();
+    instanceSubMeshes.clear();
+    topLevelBVH = BVH();
+    topLevelRebuildNeeded = false;
+    topLevelRefitNeeded = false;
+}
+
+const TriangleBVH *MeshPicker::getTriangleBVH(const SubMeshPtr &submesh)
+{
+    auto it = triangleBVHs.find(submesh.get());
+    if (it != triangleBVHs.end()) {
+        return &it->second.triangleBVH;
+    }
+
+    const std::vector<glm::vec3> &positions = submesh->getCpuPositions();
+    const std::vector<uint32_t> &indices = submesh->getCpuIndices();
+    if (positions.empty() || indices.size() < 3) {
+        return nullptr;
+    }
+    CachedTriangleBVH &cachedTriangleBVH = triangleBVHs[submesh.get()];
+    cachedTriangleBVH.submesh = submesh;
+    cachedTriangleBVH.triangleBVH.build(positions, indices);
+    return &cachedTriangleBVH.triangleBVH;
+}
+
+void MeshPicker::computeInstanceSubMeshAABBs(std::vector<AABB3> &aabbs)
+{
+    aabbs.resize(instanceSubMeshes.size());
+    for (size_t i = 0; i < instanceSubMeshes.size(); i++) {
+        const InstanceSubMesh &instanceSubMesh = instanceSubMeshes.at(i);
+        aabbs.at(i) = instanceSubMesh.triangleBVH->getAABB().transformed(
+                instances.at(instanceSubMesh.instanceId).modelMatrix);
+    }
+}
+
+void MeshPicker::updateTopLevelBVH()
+{
+    std::vector<AABB3> aabbs;
+    if (topLevelRebuildNeeded) {
+        // Collect the pickable submeshes and drop the triangle BVHs of submeshes that are no longer referenced
+        std::set<SubMesh*> usedSubMeshes;
+        instanceSubMeshes.clear();
+        for (size_t instanceId = 0; instanceId < instances.size(); instanceId++) {
+            const PickingInstance &instance = instances.at(instanceId);
+            if (!instance.isUsed) {
+                continue;
+            }
+            for (const SubMeshPtr &submeshPtr : instance.mesh->getSubMeshes()) {
+                InstanceSubMesh instanceSubMesh;
+                instanceSubMesh.instanceId = instanceId;
+                instanceSubMesh.submesh = submeshPtr.get();
+                instanceSubMesh.triangleBVH = getTriangleBVH(submeshPtr);
+                if (instanceSubMesh.triangleBVH != nullptr) {
+                    instanceSubMeshes.push_back(instanceSubMesh);
+                    usedSubMeshes.insert(instanceSubMesh.submesh);
+                }
+            }
+        }
+        for (auto it = triangleBVHs.begin(); it != triangleBVHs.end(); ) {
+            if (usedSubMeshes.find(it->first) == usedSubMeshes.end()) {
+                it = triangleBVHs.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        computeInstanceSubMeshAABBs(aabbs);
+        topLevelBVH.build(aabbs);
+    } else if (topLevelRefitNeeded && !instanceSubMeshes.empty()) {
+        computeInstanceSubMeshAABBs(aabbs);
+        topLevelBVH.refit(&aabbs.front());
+    }
+    topLevelRebuildNeeded = false;
+    topLevelRefitNeeded = false;
+}
+
+bool MeshPicker::pick(const Ray3 &ray, PickingHit &hit, float tMax)
+{
+    hit = PickingHit();
+    updateTopLevelBVH();
+
+    // The ray is transformed to object space without normalizing the direction, so t is the same in both spaces
+    TriangleHit closestTriangleHit;
+    BVHRayHit topLevelHit;
+    const std::vector<InstanceSubMesh> &candidates = instanceSubMeshes;
+    const std::vector<PickingInstance> &pickingInstances = instances;
+    auto intersectInstanceSubMesh = [&](uint32_t primitiveIndex, float tClosest, float &t) {
+        const InstanceSubMesh &instanceSubMesh = candidates[primitiveIndex];
+        const glm::mat4 &inverseModelMatrix = pickingInstances[instanceSubMesh.instanceId].inverseModelMatrix;
+        Ray3 objectSpaceRay(transformPoint(inverseModelMatrix, ray.getOrigin()),
+                transformDirection(inverseModelMatrix, ray.getDirection()));
+        TriangleHit triangleHit;
+        if (!instanceSubMesh.triangleBVH->intersectRay(objectSpaceRay, triangleHit, tClosest)) {
+            return false;
+        }
+        t = triangleHit.t;
+        closestTriangleHit = triangleHit;
+        return true;
+    };
+    if (!topLevelBVH.intersectRayFirst(ray, topLevelHit, intersectInstanceSubMesh, tMax)) {
+        return false;
+    }
+
+    const InstanceSubMesh &instanceSubMesh = instanceSubMeshes.at(topLevelHit.primitiveIndex);
+    hit.instanceId = instanceSubMesh.instanceId;
+    hit.submesh = instanceSubMesh.submesh;
+    hit.triangleIndex = closestTriangleHit.triangleIndex;
+    hit.barycentrics = closestTriangleHit.barycentrics;
+    hit.t = topLevelHit.t;
+    hit.position = ray.getPoint(topLevelHit.t);
+    return true;
+}
+
+bool MeshPicker::pick(Camera &camera, const glm::vec2 &screenPos, PickingHit &hit)
+{
+    return pick(camera.getCameraToViewportRay(screenPos), hit);
+}
+
+}
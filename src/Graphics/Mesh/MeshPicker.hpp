@@ -0,0 +1,102 @@
+/*!
+ * MeshPicker.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_MESHPICKER_HPP_
+#define GRAPHICS_MESH_MESHPICKER_HPP_
+
+#include <vector>
+#include <map>
+#include <cfloat>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include <Math/Geometry/BVH.hpp>
+#include <Math/Geometry/MatrixUtil.hpp>
+#include "Mesh.hpp"
+#include "TriangleBVH.hpp"
+
+namespace sgl {
+
+class Camera;
+
+struct DLL_OBJECT PickingHit {
+    PickingHit() : instanceId(SIZE_MAX), submesh(nullptr), triangleIndex(UINT32_MAX), barycentrics(0.0f),
+            t(FLT_MAX), position(0.0f) {}
+    //! ID returned by MeshPicker::addInstance
+    size_t instanceId;
+    SubMesh *submesh;
+    //! Index of the triangle in the CPU-side index buffer of the submesh
+    uint32_t triangleIndex;
+    //! See TriangleHit::barycentrics
+    glm::vec2 barycentrics;
+    //! Ray parameter of the hit (the world space position is ray.getPoint(t))
+    float t;
+    //! World space position of the hit
+    glm::vec3 position;
+};
+
+/*! Ray picking of mesh instances on the CPU (i.e., without reading back a GPU picking buffer).
+ * Every submesh gets a triangle BVH (see TriangleBVH.hpp) built from its CPU-side geometry (see
+ * SubMesh::setCpuGeometry), which is shared by all instances of the submesh. A top-level BVH over the world space
+ * bounding boxes of all instance submeshes finds the candidates for a ray. The top-level BVH is updated lazily
+ * before the next pick: it is rebuilt after instances were added or removed, and only refitted after transforms
+ * changed. Submeshes without CPU-side geometry can't be picked. */
+class DLL_OBJECT MeshPicker {
+public:
+    //! Returns the ID of the instance, which stays valid until the instance is removed.
+    size_t addInstance(const MeshPtr &mesh, const glm::mat4 &modelMatrix = matrixIdentity());
+    void removeInstance(size_t instanceId);
+    void setInstanceTransform(size_t instanceId, const glm::mat4 &modelMatrix);
+    /*! Call this after the CPU-side positions of a submesh changed (with the same indices). The triangle BVH of the
+     * submesh is refitted instead of rebuilt. */
+    void updateSubMeshGeometry(SubMesh *submesh);
+    void clear();
+
+    //! Returns the closest hit of the world space ray with t in [0, tMax).
+    bool pick(const Ray3 &ray, PickingHit &hit, float tMax = FLT_MAX);
+    //! screenPos has to be in relative window coordinates [0,1]x[0,1] (see Camera::getCameraToViewportRay).
+    bool pick(Camera &camera, const glm::vec2 &screenPos, PickingHit &hit);
+
+private:
+    struct PickingInstance {
+        MeshPtr mesh;
+        glm::mat4 modelMatrix;
+        glm::mat4 inverseModelMatrix;
+        bool isUsed;
+    };
+    //! Primitive of the top-level BVH
+    struct InstanceSubMesh {
+        size_t instanceId;
+        SubMesh *submesh;
+        const TriangleBVH *triangleBVH;
+    };
+
+    /*! The cache keeps a reference to the submesh, so the address used as the key can't be reused by another
+     * submesh while the triangle BVH is cached (e.g. after the last instance of a mesh was removed and a new mesh
+     * was added before the next pick). */
+    struct CachedTriangleBVH {
+        SubMeshPtr submesh;
+        TriangleBVH triangleBVH;
+    };
+
+    const TriangleBVH *getTriangleBVH(const SubMeshPtr &submesh);
+    void updateTopLevelBVH();
+    void computeInstanceSubMeshAABBs(std::vector<AABB3> &aabbs);
+
+    std::vector<PickingInstance> instances;
+    std::vector<size_t> freeInstanceIds;
+    std::map<SubMesh*, CachedTriangleBVH> triangleBVHs;
+
+    BVH topLevelBVH;
+    std::vector<InstanceSubMesh> instanceSubMeshes;
+    bool topLevelRebuildNeeded = false;
+    bool topLevelRefitNeeded = false;
+};
+
+}
+
+/*! GRAPHICS_MESH_MESHPICKER_HPP_ */
+#endif
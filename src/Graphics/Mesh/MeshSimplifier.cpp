@@ -0,0 +1,333 @@
+/*
+ * MeshSimplifier.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+namespace sgl {
+
+//! Symmetric 4x4 matrix of the quadric error metric (stored as upper triangle) and the accumulated weight.
+struct Quadric {
+    double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+    double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+    double a22 = 0.0, a23 = 0.0;
+    double a33 = 0.0;
+    double weight = 0.0;
+
+    //! Adds the quadric of the plane dot(normal, p) + d = 0 (normal must be normalized).
+    void addPlane(const glm::vec3 &normal, float d, double planeWeight) {
+        double a = normal.x, b = normal.y, c = normal.z, dd = d;
+        a00 += planeWeight * a * a; a01 += planeWeight * a * b; a02 += planeWeight * a * c; a03 += planeWeight * a * dd;
+        a11 += planeWeight * b * b; a12 += planeWeight * b * c; a13 += planeWeight * b * dd;
+        a22 += planeWeight * c * c; a23 += planeWeight * c * dd;
+        a33 += planeWeight * dd * dd;
+        weight += planeWeight;
+    }
+
+    void operator+=(const Quadric &other) {
+        a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+        a11 += other.a11; a12 += other.a12; a13 += other.a13;
+        a22 += other.a22; a23 += other.a23;
+        a33 += other.a33;
+        weight += other.weight;
+    }
+
+    //! Returns the weighted mean of the squared distances of p to the accumulated planes.
+    double evaluate(const glm::vec3 &p) const {
+        double x = p.x, y = p.y, z = p.z;
+        double error =
+                a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x
+                + a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y
+                + a22 * z * z + 2.0 * a23 * z
+                + a33;
+        return weight > 0.0 ? std::max(error, 0.0) / weight : 0.0;
+    }
+};
+
+struct CollapseCandidate {
+    uint32_t from, to;
+    float cost;
+    bool operator<(const CollapseCandidate &other) const { return cost < other.cost; }
+};
+
+//! Boundary constraint planes are weighted stronger than the surface planes to keep the silhouette of open meshes.
+#define BOUNDARY_QUADRIC_WEIGHT 10.0
+
+/*! Performs the actual simplification. The targets need to be sorted in descending order. Whenever a target number
+ * of indices is reached, the current state of the index buffer is appended to lods. */
+static void simplifyMeshInternal(
+        std::vector<MeshLod> &lods, const uint32_t *indices, size_t numIndices,
+        const glm::vec3 *positions, size_t numVertices, size_t positionStride,
+        const std::vector<size_t> &targetNumIndicesList, float maxError)
+{
+    const uint8_t *positionBytes = reinterpret_cast<const uint8_t*>(positions);
+    auto getPosition = [positionBytes, positionStride](uint32_t vertexIdx) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(positionBytes + positionStride * vertexIdx);
+    };
+
+    std::vector<uint32_t> currentIndices(indices, indices + numIndices - numIndices % 3);
+
+    // Lock all vertices on attribute seams (i.e., several vertices share the same position). Collapsing them would
+    // tear the seam open.
+    std::vector<bool> isLocked(numVertices, false);
+    std::vector<uint32_t> sortedVertices(numVertices);
+    for (size_t i = 0; i < numVertices; i++) {
+        sortedVertices[i] = uint32_t(i);
+    }
+    auto positionLess = [&getPosition](uint32_t i, uint32_t j) {
+        const glm::vec3 &p = getPosition(i), &q = getPosition(j);
+        return p.x < q.x || (p.x == q.x && (p.y < q.y || (p.y == q.y && p.z < q.z)));
+    };
+    std::sort(sortedVertices.begin(), sortedVertices.end(), positionLess);
+    for (size_t i = 1; i < numVertices; i++) {
+        if (getPosition(sortedVertices[i - 1]) == getPosition(sortedVertices[i])) {
+            isLocked[sortedVertices[i - 1]] = true;
+            isLocked[sortedVertices[i]] = true;
+        }
+    }
+
+    // Plane quadrics weighted by the triangle area
+    std::vector<Quadric> quadrics(numVertices);
+    std::vector<std::pair<uint64_t, glm::vec3>> directedEdges;
+    directedEdges.reserve(currentIndices.size());
+    for (size_t i = 0; i < currentIndices.size(); i += 3) {
+        const uint32_t *triangle = &currentIndices[i];
+        const glm::vec3 &p0 = getPosition(triangle[0]);
+        glm::vec3 normal = glm::cross(getPosition(triangle[1]) - p0, getPosition(triangle[2]) - p0);
+        float area = glm::length(normal);
+        if (area <= 0.0f) {
+            continue;
+        }
+        normal /= area;
+        for (int j = 0; j < 3; j++) {
+            quadrics[triangle[j]].addPlane(normal, -glm::dot(normal, p0), area * 0.5);
+            directedEdges.push_back(std::make_pair(
+                    (uint64_t(triangle[j]) << 32) | uint64_t(triangle[(j + 1) % 3]), normal));
+        }
+    }
+
+    // Boundary edges (i.e., edges without an opposite half-edge) get a constraint plane perpendicular to the triangle
+    std::vector<uint64_t> sortedEdgeKeys(directedEdges.size());
+    for (size_t i = 0; i < directedEdges.size(); i++) {
+        sortedEdgeKeys[i] = directedEdges[i].first;
+    }
+    std::sort(sortedEdgeKeys.begin(), sortedEdgeKeys.end());
+    for (const std::pair<uint64_t, glm::vec3> &edge : directedEdges) {
+        uint32_t v0 = uint32_t(edge.first >> 32), v1 = uint32_t(edge.first & 0xFFFFFFFFu);
+        uint64_t oppositeKey = (uint64_t(v1) << 32) | uint64_t(v0);
+        if (std::binary_search(sortedEdgeKeys.begin(), sortedEdgeKeys.end(), oppositeKey)) {
+            continue;
+        }
+        const glm::vec3 &p0 = getPosition(v0);
+        glm::vec3 edgeDirection = getPosition(v1) - p0;
+        float edgeLength = glm::length(edgeDirection);
+        glm::vec3 boundaryNormal = glm::cross(edgeDirection, edge.second);
+        float boundaryNormalLength = glm::length(boundaryNormal);
+        if (edgeLength <= 0.0f || boundaryNormalLength <= 0.0f) {
+            continue;
+        }
+        boundaryNormal /= boundaryNormalLength;
+        double planeWeight = BOUNDARY_QUADRIC_WEIGHT * edgeLength * edgeLength;
+        quadrics[v0].addPlane(boundaryNormal, -glm::dot(boundaryNormal, p0), planeWeight);
+        quadrics[v1].addPlane(boundaryNormal, -glm::dot(boundaryNormal, p0), planeWeight);
+    }
+    directedEdges = std::vector<std::pair<uint64_t, glm::vec3>>();
+    sortedEdgeKeys = std::vector<uint64_t>();
+
+    const float maxErrorSquared = maxError < 0.0f ? FLT_MAX : maxError * maxError;
+    float currentErrorSquared = 0.0f;
+    size_t targetIdx = 0;
+    std::vector<uint32_t> adjacencyOffsets, adjacencyTriangles;
+    std::vector<CollapseCandidate> candidates;
+    std::vector<bool> isTouched;
+    std::vector<uint32_t> remapTable(numVertices);
+
+    // Every pass collapses a set of independent edges in the order of increasing cost.
+    while (targetIdx < targetNumIndicesList.size()) {
+        while (targetIdx < targetNumIndicesList.size() && currentIndices.size() <= targetNumIndicesList[targetIdx]) {
+            MeshLod lod;
+            lod.indices = currentIndices;
+            lod.error = std::sqrt(currentErrorSquared);
+            lods.push_back(lod);
+            targetIdx++;
+        }
+        if (targetIdx >= targetNumIndicesList.size()) {
+            break;
+        }
+        const size_t numTriangles = currentIndices.size() / 3;
+        const size_t targetNumTriangles = targetNumIndicesList[targetIdx] / 3;
+
+        // Vertex-triangle adjacency (compressed row storage)
+        adjacencyOffsets.assign(numVertices + 1, 0);
+        for (uint32_t vertexIdx : currentIndices) {
+            adjacencyOffsets[vertexIdx + 1]++;
+        }
+        for (size_t i = 0; i < numVertices; i++) {
+            adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+        }
+        adjacencyTriangles.resize(currentIndices.size());
+        std::vector<uint32_t> fillCounts(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (size_t i = 0; i < currentIndices.size(); i++) {
+            adjacencyTriangles[fillCounts[currentIndices[i]]++] = uint32_t(i / 3);
+        }
+
+        // Collect the cheaper direction of every edge. Interior edges are visited twice, but the second collapse of
+        // the same edge is always rejected below, as both vertices are already marked as touched.
+        candidates.clear();
+        for (size_t i = 0; i < currentIndices.size(); i += 3) {
+            for (int j = 0; j < 3; j++) {
+                uint32_t v0 = currentIndices[i + j], v1 = currentIndices[i + (j + 1) % 3];
+                if (isLocked[v0] && isLocked[v1]) {
+                    continue;
+                }
+                Quadric combinedQuadric = quadrics[v0];
+                combinedQuadric += quadrics[v1];
+                CollapseCandidate candidate;
+                candidate.cost = FLT_MAX;
+                if (!isLocked[v0]) {
+                    candidate.from = v0;
+                    candidate.to = v1;
+                    candidate.cost = float(combinedQuadric.evaluate(getPosition(v1)));
+                }
+                if (!isLocked[v1]) {
+                    float cost = float(combinedQuadric.evaluate(getPosition(v0)));
+                    if (cost < candidate.cost) {
+                        candidate.from = v1;
+                        candidate.to = v0;
+                        candidate.cost = cost;
+                    }
+                }
+                candidates.push_back(candidate);
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        // Every collapse of an interior edge removes two triangles
+        const size_t maxNumCollapses = (numTriangles - targetNumTriangles) / 2 + 1;
+        size_t numCollapses = 0;
+        isTouched.assign(numVertices, false);
+        for (size_t i = 0; i < numVertices; i++) {
+            remapTable[i] = uint32_t(i);
+        }
+
+        for (const CollapseCandidate &candidate : candidates) {
+            if (numCollapses >= maxNumCollapses || candidate.cost > maxErrorSquared) {
+                break;
+            }
+            if (isTouched[candidate.from] || isTouched[candidate.to]) {
+                continue;
+            }
+
+            // Reject collapses that flip the orientation of a remaining triangle
+            const glm::vec3 &targetPosition = getPosition(candidate.to);
+            bool flipsTriangle = false;
+            for (uint32_t k = adjacencyOffsets[candidate.from]; k < adjacencyOffsets[candidate.from + 1]; k++) {
+                const uint32_t *triangle = &currentIndices[adjacencyTriangles[k] * 3];
+                if (triangle[0] == candidate.to || triangle[1] == candidate.to || triangle[2] == candidate.to) {
+                    continue;
+                }
+                glm::vec3 p[3], pNew[3];
+                for (int j = 0; j < 3; j++) {
+                    p[j] = getPosition(triangle[j]);
+                    pNew[j] = triangle[j] == candidate.from ? targetPosition : p[j];
+                }
+                glm::vec3 normalOld = glm::cross(p[1] - p[0], p[2] - p[0]);
+                glm::vec3 normalNew = glm::cross(pNew[1] - pNew[0], pNew[2] - pNew[0]);
+                if (glm::dot(normalOld, normalNew) <= 0.0f) {
+                    flipsTriangle = true;
+                    break;
+                }
+            }
+            if (flipsTriangle) {
+                continue;
+            }
+
+            // Keep the collapses of one pass independent of each other
+            for (uint32_t k = adjacencyOffsets[candidate.from]; k < adjacencyOffsets[candidate.from + 1]; k++) {
+                const uint32_t *triangle = &currentIndices[adjacencyTriangles[k] * 3];
+                isTouched[triangle[0]] = isTouched[triangle[1]] = isTouched[triangle[2]] = true;
+            }
+            isTouched[candidate.to] = true;
+
+            remapTable[candidate.from] = candidate.to;
+            quadrics[candidate.to] += quadrics[candidate.from];
+            currentErrorSquared = std::max(currentErrorSquared, candidate.cost);
+            numCollapses++;
+        }
+
+        if (numCollapses == 0) {
+            // No further simplification possible; all remaining targets get the current state.
+            while (targetIdx < targetNumIndicesList.size()) {
+                MeshLod lod;
+                lod.indices = currentIndices;
+                lod.error = std::sqrt(currentErrorSquared);
+                lods.push_back(lod);
+                targetIdx++;
+            }
+            break;
+        }
+
+        // Apply the collapses and remove degenerate triangles
+        size_t writeIdx = 0;
+        for (size_t i = 0; i < currentIndices.size(); i += 3) {
+            uint32_t v0 = remapTable[currentIndices[i]];
+            uint32_t v1 = remapTable[currentIndices[i + 1]];
+            uint32_t v2 = remapTable[currentIndices[i + 2]];
+            if (v0 == v1 || v1 == v2 || v0 == v2) {
+                continue;
+            }
+            currentIndices[writeIdx++] = v0;
+            currentIndices[writeIdx++] = v1;
+            currentIndices[writeIdx++] = v2;
+        }
+        currentIndices.resize(writeIdx);
+    }
+}
+
+std::vector<uint32_t> simplifyMesh(
+        const uint32_t *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+        size_t targetNumIndices, float maxError, float &resultError, size_t positionStride)
+{
+    std::vector<MeshLod> lods;
+    std::vector<size_t> targetNumIndicesList;
+    targetNumIndicesList.push_back(targetNumIndices);
+    simplifyMeshInternal(lods, indices, numIndices, positions, numVertices, positionStride,
+            targetNumIndicesList, maxError);
+    resultError = lods.front().error;
+    return lods.front().indices;
+}
+
+void generateLodChain(
+        std::vector<MeshLod> &lods, const uint32_t *indices, size_t numIndices,
+        const glm::vec3 *positions, size_t numVertices, size_t numLods, float reductionFactor,
+        size_t positionStride)
+{
+    lods.clear();
+    if (numLods == 0) {
+        return;
+    }
+
+    MeshLod originalLod;
+    originalLod.indices.assign(indices, indices + numIndices);
+    originalLod.error = 0.0f;
+    lods.push_back(originalLod);
+
+    std::vector<size_t> targetNumIndicesList;
+    size_t targetNumTriangles = numIndices / 3;
+    for (size_t i = 1; i < numLods; i++) {
+        targetNumTriangles = size_t(float(targetNumTriangles) * reductionFactor);
+        targetNumIndicesList.push_back(targetNumTriangles * 3);
+    }
+    if (!targetNumIndicesList.empty()) {
+        simplifyMeshInternal(lods, indices, numIndices, positions, numVertices, positionStride,
+                targetNumIndicesList, -1.0f);
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+/*!
+ * MeshSimplifier.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_MESHSIMPLIFIER_HPP_
+#define GRAPHICS_MESH_MESHSIMPLIFIER_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+
+namespace sgl {
+
+//! One level of detail of an indexed triangle list. All levels share the same vertex buffer.
+struct DLL_OBJECT MeshLod {
+    std::vector<uint32_t> indices;
+    /*! Approximate geometric error of this level in object space units (root mean square distance to the planes of
+     * the original triangles around the collapsed vertices, maximum over all collapses). */
+    float error = 0.0f;
+};
+
+/*! Simplifies an indexed triangle list using quadric error metric edge collapses
+ * (Garland and Heckbert 1997, "Surface Simplification Using Quadric Error Metrics").
+ * Only half-edge collapses are performed, i.e., vertices are merged into existing vertices and never moved.
+ * This way, the vertex buffer can be shared by all levels of detail. Mesh borders are preserved using additional
+ * boundary quadrics, and vertices on attribute seams (different vertices at the same position) are locked.
+ * \param targetNumIndices is the number of indices the simplifier tries to reach.
+ * \param maxError is the maximum allowed error (see MeshLod::error). A negative value means no limit.
+ * \param resultError is set to the error of the simplified mesh. */
+DLL_OBJECT std::vector<uint32_t> simplifyMesh(
+        const uint32_t *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+        size_t targetNumIndices, float maxError, float &resultError, size_t positionStride = sizeof(glm::vec3));
+
+/*! Generates a chain of numLods levels of detail. Level 0 is the original index buffer, every other level has roughly
+ * reductionFactor times the number of triangles of the previous level. The collapses of all levels are computed in
+ * one run, so the errors are accumulated correctly across the levels. */
+DLL_OBJECT void generateLodChain(
+        std::vector<MeshLod> &lods, const uint32_t *indices, size_t numIndices,
+        const glm::vec3 *positions, size_t numVertices, size_t numLods, float reductionFactor = 0.5f,
+        size_t positionStride = sizeof(glm::vec3));
+
+}
+
+/*! GRAPHICS_MESH_MESHSIMPLIFIER_HPP_ */
+#endif
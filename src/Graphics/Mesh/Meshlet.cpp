@@ -0,0 +1,191 @@
+/*
+ * Meshlet.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "Meshlet.hpp"
+#include <algorithm>
+#include <cmath>
+#include <Math/Geometry/MatrixUtil.hpp>
+#include <Graphics/Scene/Camera.hpp>
+
+namespace sgl {
+
+static void computeMeshletBounds(
+        Meshlet &meshlet, const uint32_t *indices, const uint8_t *positionBytes, size_t positionStride)
+{
+    auto getPosition = [positionBytes, positionStride](uint32_t vertexIdx) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(positionBytes + positionStride * vertexIdx);
+    };
+    const uint32_t *meshletIndices = indices + meshlet.firstIndex;
+    const size_t numTriangles = meshlet.numIndices / 3;
+
+    // Bounding box and bounding sphere around the center of the box
+    meshlet.aabb = AABB3();
+    for (size_t i = 0; i < meshlet.numIndices; ++i) {
+        meshlet.aabb.combine(getPosition(meshletIndices[i]));
+    }
+    glm::vec3 center = meshlet.aabb.getCenter();
+    float radiusSquared = 0.0f;
+    for (size_t i = 0; i < meshlet.numIndices; ++i) {
+        glm::vec3 diff = getPosition(meshletIndices[i]) - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(diff, diff));
+    }
+    meshlet.boundingSphere = Sphere(center, std::sqrt(radiusSquared));
+
+    // Normal cone
+    std::vector<glm::vec3> triangleNormals;
+    triangleNormals.reserve(numTriangles);
+    glm::vec3 normalSum(0.0f);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        const glm::vec3 &p0 = getPosition(meshletIndices[i * 3]);
+        const glm::vec3 &p1 = getPosition(meshletIndices[i * 3 + 1]);
+        const glm::vec3 &p2 = getPosition(meshletIndices[i * 3 + 2]);
+        glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+        float normalLength = glm::length(normal);
+        if (normalLength <= 0.0f) {
+            // Degenerate triangles don't contribute to the cone
+            continue;
+        }
+        normal /= normalLength;
+        triangleNormals.push_back(normal);
+        normalSum += normal;
+    }
+
+    meshlet.coneApex = center;
+    meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+    float normalSumLength = glm::length(normalSum);
+    if (triangleNormals.empty() || normalSumLength <= 0.0f) {
+        return;
+    }
+    glm::vec3 axis = normalSum / normalSumLength;
+    float minDot = 1.0f;
+    for (const glm::vec3 &normal : triangleNormals) {
+        minDot = std::min(minDot, glm::dot(normal, axis));
+    }
+    if (minDot <= 0.1f) {
+        // The cone is too wide (more than ~84 degrees) to ever cull anything.
+        return;
+    }
+
+    // Move the apex backwards along the axis so that all triangle planes lie in front of it.
+    float maxT = 0.0f;
+    size_t normalIdx = 0;
+    for (size_t i = 0; i < numTriangles; ++i) {
+        const glm::vec3 &p0 = getPosition(meshletIndices[i * 3]);
+        const glm::vec3 &p1 = getPosition(meshletIndices[i * 3 + 1]);
+        const glm::vec3 &p2 = getPosition(meshletIndices[i * 3 + 2]);
+        if (glm::length(glm::cross(p1 - p0, p2 - p0)) <= 0.0f) {
+            continue;
+        }
+        const glm::vec3 &normal = triangleNormals.at(normalIdx++);
+        float t = glm::dot(center - p0, normal) / glm::dot(axis, normal);
+        maxT = std::max(maxT, t);
+    }
+    meshlet.coneApex = center - axis * maxT;
+    meshlet.coneAxis = axis;
+    meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+
+void buildMeshlets(
+        std::vector<Meshlet> &meshlets, const uint32_t *indices, size_t numIndices,
+        const glm::vec3 *positions, size_t numVertices, size_t positionStride,
+        size_t maxVertices, size_t maxTriangles)
+{
+    meshlets.clear();
+    const size_t numTriangles = numIndices / 3;
+    if (numTriangles == 0) {
+        return;
+    }
+    MY_ASSERT(maxVertices >= 3 && maxTriangles >= 1);
+
+    // Stores for every vertex the index of the last meshlet that references it
+    std::vector<uint32_t> vertexMeshletMarker(numVertices, UINT32_MAX);
+    uint32_t meshletIdx = 0;
+    Meshlet currentMeshlet;
+    currentMeshlet.firstIndex = 0;
+    currentMeshlet.numIndices = 0;
+    currentMeshlet.numVertices = 0;
+
+    for (size_t triangleIdx = 0; triangleIdx < numTriangles; ++triangleIdx) {
+        const uint32_t *triangle = indices + triangleIdx * 3;
+        uint32_t numNewVertices = 0;
+        for (int j = 0; j < 3; ++j) {
+            if (vertexMeshletMarker[triangle[j]] != meshletIdx
+                    && (j < 1 || triangle[j] != triangle[0]) && (j < 2 || triangle[j] != triangle[1])) {
+                numNewVertices++;
+            }
+        }
+
+        if (currentMeshlet.numVertices + numNewVertices > maxVertices
+                || currentMeshlet.numIndices / 3 + 1 > maxTriangles) {
+            meshlets.push_back(currentMeshlet);
+            meshletIdx++;
+            currentMeshlet.firstIndex = uint32_t(triangleIdx * 3);
+            currentMeshlet.numIndices = 0;
+            currentMeshlet.numVertices = 0;
+        }
+
+        for (int j = 0; j < 3; ++j) {
+            if (vertexMeshletMarker[triangle[j]] != meshletIdx) {
+                vertexMeshletMarker[triangle[j]] = meshletIdx;
+                currentMeshlet.numVertices++;
+            }
+        }
+        currentMeshlet.numIndices += 3;
+    }
+    meshlets.push_back(currentMeshlet);
+
+    const uint8_t *positionBytes = reinterpret_cast<const uint8_t*>(positions);
+    const size_t numMeshlets = meshlets.size();
+    #pragma omp parallel for shared(meshlets, indices, positionBytes, positionStride, numMeshlets) default(none)
+    for (size_t i = 0; i < numMeshlets; ++i) {
+        computeMeshletBounds(meshlets[i], indices, positionBytes, positionStride);
+    }
+}
+
+bool isMeshletBackfacing(const Meshlet &meshlet, const glm::vec3 &cameraPosition)
+{
+    glm::vec3 viewDirection = meshlet.coneApex - cameraPosition;
+    float viewDistance = glm::length(viewDirection);
+    if (viewDistance <= 0.0f) {
+        return false;
+    }
+    return glm::dot(viewDirection, meshlet.coneAxis) >= meshlet.coneCutoff * viewDistance;
+}
+
+void cullMeshlets(
+        const std::vector<Meshlet> &meshlets, Camera &camera, const glm::mat4 &modelMatrix,
+        std::vector<IndexRange> &drawRanges)
+{
+    drawRanges.clear();
+
+    // The backface test is done in object space, the frustum test in world space.
+    glm::vec3 cameraPositionObjectSpace = transformPoint(glm::inverse(modelMatrix), camera.getPosition());
+    float maxScale = std::max(std::max(
+            glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1]))),
+            glm::length(glm::vec3(modelMatrix[2])));
+
+    for (const Meshlet &meshlet : meshlets) {
+        if (meshlet.coneCutoff < 1.0f && isMeshletBackfacing(meshlet, cameraPositionObjectSpace)) {
+            continue;
+        }
+        Sphere boundingSphereWorld(
+                transformPoint(modelMatrix, meshlet.boundingSphere.center), meshlet.boundingSphere.radius * maxScale);
+        if (!camera.isVisible(boundingSphereWorld) || !camera.isVisible(meshlet.aabb.transformed(modelMatrix))) {
+            continue;
+        }
+
+        if (!drawRanges.empty()
+                && drawRanges.back().firstIndex + drawRanges.back().numIndices == meshlet.firstIndex) {
+            drawRanges.back().numIndices += meshlet.numIndices;
+        } else {
+            drawRanges.push_back(IndexRange(meshlet.firstIndex, meshlet.numIndices));
+        }
+    }
+}
+
+}
@@ -0,0 +1,65 @@
+/*!
+ * Meshlet.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_MESHLET_HPP_
+#define GRAPHICS_MESH_MESHLET_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include <Math/Geometry/AABB3.hpp>
+#include <Math/Geometry/Sphere.hpp>
+#include <Graphics/Renderer.hpp>
+
+namespace sgl {
+
+class Camera;
+
+/*! A meshlet is a cluster of consecutive triangles in an index buffer with a bounded number of vertices and triangles.
+ * Meshlets can be culled on the CPU using their bounding volumes and normal cone before the draw calls are issued. */
+struct DLL_OBJECT Meshlet {
+    //! Range of the meshlet in the index buffer
+    uint32_t firstIndex;
+    uint32_t numIndices;
+    //! Number of unique vertices referenced by the meshlet
+    uint32_t numVertices;
+
+    //! Bounding volumes (in object space)
+    AABB3 aabb;
+    Sphere boundingSphere;
+
+    /*! Normal cone for backface culling. All triangles of the meshlet are back-facing if
+     * dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff. A cutoff of 1 disables the test. */
+    glm::vec3 coneApex;
+    glm::vec3 coneAxis;
+    float coneCutoff;
+};
+
+/*! Splits an indexed triangle list into meshlets with at most maxVertices vertices and maxTriangles triangles.
+ * The triangle order is not changed, i.e., the meshlets refer to ranges in the passed index buffer. For best results,
+ * optimize the triangle order for vertex cache locality first (see optimizeVertexCache in MeshOptimizer.hpp).
+ * \param positionStride is the offset in byte between two vertex positions. */
+DLL_OBJECT void buildMeshlets(
+        std::vector<Meshlet> &meshlets, const uint32_t *indices, size_t numIndices,
+        const glm::vec3 *positions, size_t numVertices, size_t positionStride = sizeof(glm::vec3),
+        size_t maxVertices = 64, size_t maxTriangles = 124);
+
+//! Returns true if all triangles of the meshlet face away from the camera (both in object space).
+DLL_OBJECT bool isMeshletBackfacing(const Meshlet &meshlet, const glm::vec3 &cameraPosition);
+
+/*! Culls the meshlets against the view frustum of the camera (using Camera::isVisible) and with the normal cone test.
+ * The index ranges of the remaining meshlets are written to drawRanges. Adjacent ranges are merged.
+ * \param modelMatrix is the transformation from the object space of the meshlets to world space. */
+DLL_OBJECT void cullMeshlets(
+        const std::vector<Meshlet> &meshlets, Camera &camera, const glm::mat4 &modelMatrix,
+        std::vector<IndexRange> &drawRanges);
+
+}
+
+/*! GRAPHICS_MESH_MESHLET_HPP_ */
+#endif
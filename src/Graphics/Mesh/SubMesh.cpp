@@ -8,6 +8,11 @@
 #include "SubMesh.hpp"
 #include <Graphics/Renderer.hpp>
 #include <Graphics/Shader/ShaderManager.hpp>
+#include <Graphics/Scene/Camera.hpp>
+#include <Utils/File/Logfile.hpp>
+#include <Math/Geometry/MatrixUtil.hpp>
+#include <algorithm>
+#include <cmath>
 
 namespace sgl {
 
@@ -35,7 +40,113 @@ void SubMesh::render()
     if (material->texture) {
         renderData->getShaderProgram()->setUniform("texture", material->texture);
     }
-    Renderer->render(renderData);
+    if (packedPositions) {
+        renderData->getShaderProgram()->setUniform("dequantizationOffset", aabb.min);
+        renderData->getShaderProgram()->setUniform("dequantizationScale", aabb.getDimensions());
+    }
+
+    CameraPtr camera = Renderer->getCamera();
+    lastRenderedLod = 0;
+    if (lodSelection && lods.size() > 1 && camera) {
+        lastRenderedLod = selectLod(*camera, Renderer->getModelMatrix(), maxPixelError);
+    }
+
+    // Meshlets refer to the original index buffer (i.e., level of detail 0)
+    if (lastRenderedLod == 0 && meshletCulling && !meshlets.empty() && camera) {
+        cullMeshlets(meshlets, *camera, Renderer->getModelMatrix(), meshletDrawRanges);
+        Renderer->renderIndexRanges(renderData, meshletDrawRanges);
+    } else if (!lods.empty()) {
+        // The index buffer contains all levels of detail, so only the range of the selected level may be drawn
+        const SubMeshLod &lod = lods.at(lastRenderedLod);
+        lodDrawRange.resize(1);
+        lodDrawRange.front() = IndexRange(lod.firstIndex, lod.numIndices);
+        Renderer->renderIndexRanges(renderData, lodDrawRange);
+    } else {
+        Renderer->render(renderData);
+    }
+}
+
+void SubMesh::setLods(const std::vector<MeshLod> &newLods)
+{
+    if (newLods.empty() || renderData->getVertexMode() != VERTEX_MODE_TRIANGLES) {
+        Logfile::get()->writeError("SubMesh::setLods: Levels of detail need indexed triangle data!");
+        return;
+    }
+
+    lods.clear();
+    size_t numIndicesTotal = 0;
+    uint32_t maxIndex = 0;
+    for (const MeshLod &lod : newLods) {
+        for (uint32_t index : lod.indices) {
+            maxIndex = std::max(maxIndex, index);
+        }
+        SubMeshLod subMeshLod;
+        subMeshLod.firstIndex = uint32_t(numIndicesTotal);
+        subMeshLod.numIndices = uint32_t(lod.indices.size());
+        subMeshLod.error = lod.error;
+        lods.push_back(subMeshLod);
+        numIndicesTotal += lod.indices.size();
+    }
+
+    // Upload the levels of detail as one combined index buffer
+    if (maxIndex <= UINT16_MAX) {
+        std::vector<uint16_t> combinedIndices;
+        combinedIndices.reserve(numIndicesTotal);
+        for (const MeshLod &lod : newLods) {
+            combinedIndices.insert(combinedIndices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        createIndices(&combinedIndices.front(), combinedIndices.size());
+    } else {
+        std::vector<uint32_t> combinedIndices;
+        combinedIndices.reserve(numIndicesTotal);
+        for (const MeshLod &lod : newLods) {
+            combinedIndices.insert(combinedIndices.end(), lod.indices.begin(), lod.indices.end());
+        }
+        createIndices(&combinedIndices.front(), combinedIndices.size());
+    }
+}
+
+size_t SubMesh::selectLod(Camera &camera, const glm::mat4 &modelMatrix, float maxPixelError)
+{
+    if (lods.size() <= 1) {
+        return 0;
+    }
+
+    float maxScale = std::max(std::max(
+            glm::length(glm::vec3(modelMatrix[0])), glm::length(glm::vec3(modelMatrix[1]))),
+            glm::length(glm::vec3(modelMatrix[2])));
+    glm::vec3 centerWorld = transformPoint(modelMatrix, aabb.getCenter());
+    float radiusWorld = glm::length(aabb.getExtent()) * maxScale;
+    float distance = glm::length(camera.getPosition() - centerWorld) - radiusWorld;
+    distance = std::max(distance, camera.getNearClipDistance());
+
+    // Size of one world space unit in pixels at the passed distance
+    float viewportHeight = float(camera.getViewportLTWH().w);
+    float pixelsPerUnit = viewportHeight / (2.0f * std::tan(camera.getFOVy() * 0.5f) * distance);
+
+    for (size_t i = lods.size() - 1; i > 0; i--) {
+        if (lods.at(i).error * maxScale * pixelsPerUnit <= maxPixelError) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+void SubMesh::setCpuGeometry(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices)
+{
+    cpuPositions = positions;
+    cpuIndices = indices;
+    meshlets.clear();
+}
+
+void SubMesh::buildMeshlets(size_t maxVertices, size_t maxTriangles)
+{
+    if (cpuPositions.empty() || cpuIndices.empty() || renderData->getVertexMode() != VERTEX_MODE_TRIANGLES) {
+        Logfile::get()->writeError("SubMesh::buildMeshlets: Meshlets need CPU-side indexed triangle data!");
+        return;
+    }
+    sgl::buildMeshlets(meshlets, &cpuIndices.front(), cpuIndices.size(), &cpuPositions.front(), cpuPositions.size(),
+            sizeof(glm::vec3), maxVertices, maxTriangles);
 }
 
 void SubMesh::createVertices(VertexPlain *vertices, size_t numVertices)
@@ -43,22 +154,8 @@ void SubMesh::createVertices(VertexPlain *vertices, size_t numVertices)
     GeometryBufferPtr geometryBuffer = Renderer->createGeometryBuffer(sizeof(VertexPlain)*numVertices, vertices);
     renderData->addGeometryBuffer(geometryBuffer, "position", ATTRIB_FLOAT, 3);
 
-    glm::vec2 minValues, maxValues;
-    minValues.x = minValues.y = 1000000000.0f;
-    maxValues.x = maxValues.y = -1000000000.0f;
-    for (size_t i = 0; i < numVertices; ++i) {
-        if (vertices[i].position.x < minValues.x)
-            minValues.x = vertices[i].position.x;
-        if (vertices[i].position.y < minValues.y)
-            minValues.y = vertices[i].position.y;
-        if (vertices[i].position.x > maxValues.x)
-            maxValues.x = vertices[i].position.x;
-        if (vertices[i].position.y > maxValues.y)
-            maxValues.y = vertices[i].position.y;
-    }
-
-    aabb.min = glm::vec3(minValues.x, minValues.y, 0.0f);
-    aabb.max = glm::vec3(maxValues.x, maxValues.y, 0.0f);
+    aabb = AABB3();
+    aabb.combine(&vertices->position, numVertices, sizeof(VertexPlain));
 }
 
 void SubMesh::createVertices(VertexTextured *vertices, size_t numVertices)
@@ -68,24 +165,26 @@ void SubMesh::createVertices(VertexTextured *vertices, size_t numVertices)
     renderData->addGeometryBuffer(geometryBuffer, "position", ATTRIB_FLOAT, 3, 0, stride);
     renderData->addGeometryBuffer(geometryBuffer, "texcoord", ATTRIB_FLOAT, 2, sizeof(glm::vec3), stride);
 
-    glm::vec2 minValues, maxValues;
-    minValues.x = minValues.y = 1000000000.0f;
-    maxValues.x = maxValues.y = -1000000000.0f;
-    for (size_t i = 0; i < numVertices; ++i) {
-        if (vertices[i].position.x < minValues.x)
-            minValues.x = vertices[i].position.x;
-        if (vertices[i].position.y < minValues.y)
-            minValues.y = vertices[i].position.y;
-        if (vertices[i].position.x > maxValues.x)
-            maxValues.x = vertices[i].position.x;
-        if (vertices[i].position.y > maxValues.y)
-            maxValues.y = vertices[i].position.y;
-    }
-
-    aabb.min = glm::vec3(minValues.x, minValues.y, 0.0f);
-    aabb.max = glm::vec3(maxValues.x, maxValues.y, 0.0f);
+    aabb = AABB3();
+    aabb.combine(&vertices->position, numVertices, sizeof(VertexTextured));
 }
 
+void SubMesh::createVertices(VertexPacked *vertices, size_t numVertices, const AABB3 &quantizationAABB)
+{
+    int stride = sizeof(VertexPacked);
+    GeometryBufferPtr geometryBuffer = Renderer->createGeometryBuffer(sizeof(VertexPacked)*numVertices, vertices);
+    renderData->addGeometryBuffer(geometryBuffer, "position", ATTRIB_UNSIGNED_SHORT, 3,
+            offsetof(VertexPacked, position), stride, 0, ATTRIB_CONVERSION_FLOAT_NORMALIZED);
+    renderData->addGeometryBufferOptional(geometryBuffer, "normal", ATTRIB_SHORT, 2,
+            offsetof(VertexPacked, normal), stride, 0, ATTRIB_CONVERSION_FLOAT_NORMALIZED);
+    renderData->addGeometryBufferOptional(geometryBuffer, "texcoord", ATTRIB_HALF_FLOAT, 2,
+            offsetof(VertexPacked, texcoord), stride, 0, ATTRIB_CONVERSION_FLOAT);
+    renderData->addGeometryBufferOptional(geometryBuffer, "vertexColor", ATTRIB_UNSIGNED_BYTE, 4,
+            offsetof(VertexPacked, color), stride, 0, ATTRIB_CONVERSION_FLOAT_NORMALIZED);
+
+    aabb = quantizationAABB;
+    packedPositions = true;
+}
 
 void SubMesh::createIndices(uint8_t *indices, size_t numIndices)
 {
@@ -13,9 +13,18 @@
 #include <Graphics/Shader/ShaderAttributes.hpp>
 #include <Graphics/Shader/Shader.hpp>
 #include <Math/Geometry/AABB3.hpp>
+#include "Meshlet.hpp"
+#include "MeshSimplifier.hpp"
 
 namespace sgl {
 
+//! Range of a level of detail in the combined index buffer of a submesh and its error in object space
+struct DLL_OBJECT SubMeshLod {
+    uint32_t firstIndex;
+    uint32_t numIndices;
+    float error;
+};
+
 class DLL_OBJECT SubMesh
 {
     friend class Mesh;
@@ -32,16 +41,59 @@ public:
     //! Call these functions to create a mesh manually
     void createVertices(VertexPlain *vertices, size_t numVertices);
     void createVertices(VertexTextured *vertices, size_t numVertices);
+    /*! Packed vertices (see VertexPacking.hpp). The positions are relative to quantizationAABB. The shader receives
+     * them normalized to [0,1] and needs to apply the uniforms "dequantizationOffset" and "dequantizationScale"
+     * (i.e., position = dequantizationOffset + position * dequantizationScale). The octahedral normal is passed to
+     * the attribute "normal" (vec2 in [-1,1]), the color to the attribute "vertexColor". */
+    void createVertices(VertexPacked *vertices, size_t numVertices, const AABB3 &quantizationAABB);
     void createIndices(uint8_t *indices, size_t numIndices);
     void createIndices(uint16_t *indices, size_t numIndices);
     void createIndices(uint32_t *indices, size_t numIndices);
     inline void setVertexMode(VertexMode vertexMode) { renderData->setVertexMode(vertexMode); }
 
+    /*! CPU-side copy of the vertex positions and triangle indices (in the same order as uploaded to the GPU).
+     * It is needed for meshlet culling, LOD generation and picking. */
+    void setCpuGeometry(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices);
+    inline const std::vector<glm::vec3> &getCpuPositions() const { return cpuPositions; }
+    inline const std::vector<uint32_t> &getCpuIndices() const { return cpuIndices; }
+
+    //! Splits the CPU-side triangle data into meshlets (see Meshlet.hpp). Needs setCpuGeometry to be called first.
+    void buildMeshlets(size_t maxVertices = 64, size_t maxTriangles = 124);
+    inline const std::vector<Meshlet> &getMeshlets() const { return meshlets; }
+    //! If enabled, render() only draws the meshlets visible for the camera of the renderer.
+    inline void setMeshletCulling(bool enabled) { meshletCulling = enabled; }
+
+    /*! Uploads the passed levels of detail (see MeshSimplifier.hpp) as one combined index buffer, which replaces the
+     * current index buffer. Level 0 needs to be the original index buffer (i.e., the CPU-side indices). */
+    void setLods(const std::vector<MeshLod> &lods);
+    inline const std::vector<SubMeshLod> &getLods() const { return lods; }
+    /*! Returns the coarsest level of detail whose error projected to the viewport of the camera is at most
+     * maxPixelError pixels. The distance is measured between the camera and the bounding sphere of the submesh. */
+    size_t selectLod(Camera &camera, const glm::mat4 &modelMatrix, float maxPixelError);
+    //! If enabled, render() selects the level of detail using selectLod. Otherwise, level 0 is rendered.
+    inline void setLodSelection(bool enabled, float _maxPixelError = 1.0f) {
+        lodSelection = enabled; maxPixelError = _maxPixelError;
+    }
+    inline size_t getLastRenderedLod() const { return lastRenderedLod; }
+
 private:
     void computeAABB();
     ShaderAttributesPtr renderData;
     MaterialPtr material;
     AABB3 aabb;
+    bool packedPositions = false;
+
+    // CPU-side data
+    std::vector<glm::vec3> cpuPositions;
+    std::vector<uint32_t> cpuIndices;
+    std::vector<Meshlet> meshlets;
+    std::vector<IndexRange> meshletDrawRanges;
+    bool meshletCulling = false;
+    std::vector<SubMeshLod> lods;
+    std::vector<IndexRange> lodDrawRange;
+    bool lodSelection = false;
+    float maxPixelError = 1.0f;
+    size_t lastRenderedLod = 0;
 };
 
 typedef boost::shared_ptr<SubMesh> SubMeshPtr;
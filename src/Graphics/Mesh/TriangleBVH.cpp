@@ -0,0 +1,191 @@
+/*
+ * TriangleBVH.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "TriangleBVH.hpp"
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sgl {
+
+//! Determinants below this value are treated as rays parallel to the triangle plane
+#define TRIANGLE_BVH_DET_EPSILON 1e-12f
+
+void TriangleBVH::build(const glm::vec3 *positions, size_t numVertices, const uint32_t *triangleIndices,
+        size_t numIndices)
+{
+    numTriangles = numIndices / 3;
+    indices.assign(triangleIndices, triangleIndices + numTriangles * 3);
+
+    std::vector<AABB3> triangleAABBs(numTriangles);
+    for (size_t i = 0; i < numTriangles; i++) {
+        AABB3 &aabb = triangleAABBs[i];
+        for (int j = 0; j < 3; j++) {
+            uint32_t vertexIdx = indices[i * 3 + j];
+            MY_ASSERT(vertexIdx < numVertices);
+            aabb.combine(positions[vertexIdx]);
+        }
+    }
+    bvh.build(triangleAABBs);
+    computeTriangleData(positions);
+}
+
+void TriangleBVH::refit(const glm::vec3 *positions)
+{
+    std::vector<AABB3> triangleAABBs(numTriangles);
+    for (size_t i = 0; i < numTriangles; i++) {
+        for (int j = 0; j < 3; j++) {
+            triangleAABBs[i].combine(positions[indices[i * 3 + j]]);
+        }
+    }
+    if (numTriangles > 0) {
+        bvh.refit(&triangleAABBs.front());
+    }
+    computeTriangleData(positions);
+}
+
+void TriangleBVH::computeTriangleData(const glm::vec3 *positions)
+{
+    // Leaves can start at any triangle, so three degenerate triangles are appended for the last four-wide load
+    const size_t numTrianglesPadded = numTriangles + 3;
+    for (int i = 0; i < 3; i++) {
+        v0[i].assign(numTrianglesPadded, 0.0f);
+        edge1[i].assign(numTrianglesPadded, 0.0f);
+        edge2[i].assign(numTrianglesPadded, 0.0f);
+    }
+
+    const std::vector<uint32_t> &primitiveIndices = bvh.getPrimitiveIndices();
+    for (size_t i = 0; i < numTriangles; i++) {
+        const uint32_t *triangle = &indices[primitiveIndices[i] * 3];
+        const glm::vec3 &p0 = positions[triangle[0]];
+        glm::vec3 e1 = positions[triangle[1]] - p0;
+        glm::vec3 e2 = positions[triangle[2]] - p0;
+        for (int j = 0; j < 3; j++) {
+            v0[j][i] = p0[j];
+            edge1[j][i] = e1[j];
+            edge2[j][i] = e2[j];
+        }
+    }
+}
+
+bool TriangleBVH::intersectRay(const Ray3 &ray, TriangleHit &hit, float tMax) const
+{
+    hit = TriangleHit();
+    if (numTriangles == 0) {
+        return false;
+    }
+
+    const glm::vec3 origin = ray.getOrigin();
+    const glm::vec3 direction = ray.getDirection();
+    glm::vec2 closestBarycentrics(0.0f);
+
+    auto intersectLeaf = [this, &origin, &direction, &closestBarycentrics](
+            uint32_t firstPrimitive, uint32_t numPrimitives, float tClosest, BVHRayHit &leafHit) {
+        bool isHit = false;
+        const uint32_t lastPrimitive = firstPrimitive + numPrimitives;
+#ifdef __SSE2__
+        const __m128 dirX = _mm_set1_ps(direction.x), dirY = _mm_set1_ps(direction.y);
+        const __m128 dirZ = _mm_set1_ps(direction.z);
+        const __m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+        const __m128 laneIndices = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+        for (uint32_t i = firstPrimitive; i < lastPrimitive; i += 4) {
+            __m128 e1x = _mm_loadu_ps(&edge1[0][i]), e1y = _mm_loadu_ps(&edge1[1][i]);
+            __m128 e1z = _mm_loadu_ps(&edge1[2][i]);
+            __m128 e2x = _mm_loadu_ps(&edge2[0][i]), e2y = _mm_loadu_ps(&edge2[1][i]);
+            __m128 e2z = _mm_loadu_ps(&edge2[2][i]);
+
+            // pvec = cross(direction, edge2), det = dot(edge1, pvec)
+            __m128 px = _mm_sub_ps(_mm_mul_ps(dirY, e2z), _mm_mul_ps(dirZ, e2y));
+            __m128 py = _mm_sub_ps(_mm_mul_ps(dirZ, e2x), _mm_mul_ps(dirX, e2z));
+            __m128 pz = _mm_sub_ps(_mm_mul_ps(dirX, e2y), _mm_mul_ps(dirY, e2x));
+            __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+            __m128 absDet = _mm_andnot_ps(_mm_set1_ps(-0.0f), det);
+            __m128 valid = _mm_cmpgt_ps(absDet, _mm_set1_ps(TRIANGLE_BVH_DET_EPSILON));
+            valid = _mm_and_ps(valid, _mm_cmplt_ps(laneIndices, _mm_set1_ps(float(lastPrimitive - i))));
+            __m128 inverseDet = _mm_div_ps(one, det);
+
+            // tvec = origin - v0, u = dot(tvec, pvec) / det
+            __m128 tx = _mm_sub_ps(_mm_set1_ps(origin.x), _mm_loadu_ps(&v0[0][i]));
+            __m128 ty = _mm_sub_ps(_mm_set1_ps(origin.y), _mm_loadu_ps(&v0[1][i]));
+            __m128 tz = _mm_sub_ps(_mm_set1_ps(origin.z), _mm_loadu_ps(&v0[2][i]));
+            __m128 u = _mm_mul_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), inverseDet);
+
+            // qvec = cross(tvec, edge1), v = dot(direction, qvec) / det, t = dot(edge2, qvec) / det
+            __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+            __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+            __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+            __m128 v = _mm_mul_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(dirX, qx), _mm_mul_ps(dirY, qy)), _mm_mul_ps(dirZ, qz)),
+                    inverseDet);
+            __m128 t = _mm_mul_ps(
+                    _mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)),
+                    inverseDet);
+
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(u, zero));
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(v, zero));
+            valid = _mm_and_ps(valid, _mm_cmple_ps(_mm_add_ps(u, v), one));
+            valid = _mm_and_ps(valid, _mm_cmpge_ps(t, zero));
+            valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(tClosest)));
+            int hitMask = _mm_movemask_ps(valid);
+            if (hitMask == 0) {
+                continue;
+            }
+
+            float tValues[4], uValues[4], vValues[4];
+            _mm_storeu_ps(tValues, t);
+            _mm_storeu_ps(uValues, u);
+            _mm_storeu_ps(vValues, v);
+            for (int lane = 0; lane < 4; lane++) {
+                if ((hitMask & (1 << lane)) != 0 && tValues[lane] < tClosest) {
+                    tClosest = tValues[lane];
+                    leafHit = BVHRayHit(i + lane, tClosest);
+                    closestBarycentrics = glm::vec2(uValues[lane], vValues[lane]);
+                    isHit = true;
+                }
+            }
+        }
+#else
+        for (uint32_t i = firstPrimitive; i < lastPrimitive; i++) {
+            glm::vec3 e1(edge1[0][i], edge1[1][i], edge1[2][i]);
+            glm::vec3 e2(edge2[0][i], edge2[1][i], edge2[2][i]);
+            glm::vec3 pvec = glm::cross(direction, e2);
+            float det = glm::dot(e1, pvec);
+            if (std::abs(det) <= TRIANGLE_BVH_DET_EPSILON) {
+                continue;
+            }
+            float inverseDet = 1.0f / det;
+            glm::vec3 tvec = origin - glm::vec3(v0[0][i], v0[1][i], v0[2][i]);
+            float u = glm::dot(tvec, pvec) * inverseDet;
+            glm::vec3 qvec = glm::cross(tvec, e1);
+            float v = glm::dot(direction, qvec) * inverseDet;
+            float t = glm::dot(e2, qvec) * inverseDet;
+            if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f && t >= 0.0f && t < tClosest) {
+                tClosest = t;
+                leafHit = BVHRayHit(i, t);
+                closestBarycentrics = glm::vec2(u, v);
+                isHit = true;
+            }
+        }
+#endif
+        return isHit;
+    };
+
+    BVHRayHit bvhHit;
+    if (!bvh.intersectRayFirstLeaves(ray, bvhHit, intersectLeaf, tMax)) {
+        return false;
+    }
+    // The leaf functor stores the position in the BVH order, which needs to be mapped to the triangle index
+    hit.triangleIndex = bvh.getPrimitiveIndices().at(bvhHit.primitiveIndex);
+    hit.t = bvhHit.t;
+    hit.barycentrics = closestBarycentrics;
+    return true;
+}
+
+}
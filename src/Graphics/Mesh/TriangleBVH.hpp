@@ -0,0 +1,67 @@
+/*!
+ * TriangleBVH.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_TRIANGLEBVH_HPP_
+#define GRAPHICS_MESH_TRIANGLEBVH_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include <Math/Geometry/BVH.hpp>
+
+namespace sgl {
+
+struct DLL_OBJECT TriangleHit {
+    TriangleHit() : triangleIndex(UINT32_MAX), t(FLT_MAX), barycentrics(0.0f) {}
+    //! Index of the triangle in the index buffer (i.e., the indices 3 * triangleIndex + 0...2)
+    uint32_t triangleIndex;
+    //! Ray parameter of the hit
+    float t;
+    /*! Barycentric coordinates (u, v) of the hit with respect to the second and third vertex of the triangle.
+     * The hit point is (1 - u - v) * p0 + u * p1 + v * p2. */
+    glm::vec2 barycentrics;
+};
+
+/*! BVH over indexed triangles for ray casting on the CPU (e.g. mouse picking).
+ * The triangles are stored in the order of the BVH leaves in structure of arrays layout, and the leaves are tested
+ * with a Möller-Trumbore ray-triangle test on four triangles at once (SSE2). Both triangle sides are hit. */
+class DLL_OBJECT TriangleBVH {
+public:
+    void build(const glm::vec3 *positions, size_t numVertices, const uint32_t *indices, size_t numIndices);
+    inline void build(const std::vector<glm::vec3> &positions, const std::vector<uint32_t> &indices) {
+        build(positions.empty() ? nullptr : &positions.front(), positions.size(),
+                indices.empty() ? nullptr : &indices.front(), indices.size());
+    }
+    /*! Updates the triangle data and BVH bounds after the vertex positions have changed (the indices need to stay
+     * the same). Faster than build, but the quality of the tree degrades for large deformations. */
+    void refit(const glm::vec3 *positions);
+
+    //! Returns the closest triangle hit by the ray with t in [0, tMax).
+    bool intersectRay(const Ray3 &ray, TriangleHit &hit, float tMax = FLT_MAX) const;
+
+    inline const BVH &getBVH() const { return bvh; }
+    inline AABB3 getAABB() const { return bvh.getAABB(); }
+    inline size_t getNumTriangles() const { return numTriangles; }
+    inline bool isEmpty() const { return numTriangles == 0; }
+
+private:
+    void computeTriangleData(const glm::vec3 *positions);
+
+    BVH bvh;
+    size_t numTriangles = 0;
+    std::vector<uint32_t> indices;
+    /*! First vertex and the two edges of every triangle in the order of bvh.getPrimitiveIndices(). The arrays are
+     * padded with three degenerate triangles, so the SIMD test can always load four triangles. */
+    std::vector<float> v0[3], edge1[3], edge2[3];
+};
+
+}
+
+/*! GRAPHICS_MESH_TRIANGLEBVH_HPP_ */
+#endif
@@ -8,6 +8,7 @@
 #ifndef GRAPHICS_MESH_VERTEX_HPP_
 #define GRAPHICS_MESH_VERTEX_HPP_
 
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <Graphics/Color.hpp>
 
@@ -42,6 +43,20 @@ struct VertexColorTextured
     Color color;
 };
 
+/*! Quantized vertex format with 20 bytes per vertex (compared to 36 bytes for full-float position, normal,
+ * texture coordinates and color). Use the functions in VertexPacking.hpp to create the packed data.
+ * - position: 16-bit unsigned normalized, relative to the AABB of the submesh (w is padding).
+ * - normal: Octahedral encoding, 16-bit signed normalized.
+ * - texcoord: Half-precision floats.
+ * - color: RGBA8, unsigned normalized. */
+struct VertexPacked
+{
+    uint16_t position[4];
+    int16_t normal[2];
+    uint16_t texcoord[2];
+    Color color;
+};
+
 }
 
 /*! GRAPHICS_MESH_VERTEX_HPP_ */
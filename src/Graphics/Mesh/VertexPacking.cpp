@@ -0,0 +1,317 @@
+/*
+ * VertexPacking.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "VertexPacking.hpp"
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sgl {
+
+union FloatBits {
+    float f;
+    uint32_t u;
+};
+
+// The conversion functions are based on the public domain code by Fabian Giesen:
+// https://gist.github.com/rygorous/2156668
+uint16_t floatToHalf(float value)
+{
+    const uint32_t f32Infinity = 255u << 23;
+    const uint32_t f16Max = (127u + 16u) << 23;
+    FloatBits denormMagic;
+    denormMagic.u = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    FloatBits f;
+    f.f = value;
+    uint32_t sign = f.u & 0x80000000u;
+    f.u ^= sign;
+
+    uint16_t result;
+    if (f.u >= f16Max) {
+        // Overflow: Inf or NaN
+        result = f.u > f32Infinity ? 0x7E00 : 0x7C00;
+    } else if (f.u < (113u << 23)) {
+        // Subnormal or zero: Let the FPU do the rounding by adding a magic value
+        f.f += denormMagic.f;
+        result = uint16_t(f.u - denormMagic.u);
+    } else {
+        uint32_t mantissaOdd = (f.u >> 13) & 1u;
+        f.u += (uint32_t(15 - 127) << 23) + 0xFFFu;
+        f.u += mantissaOdd;
+        result = uint16_t(f.u >> 13);
+    }
+    return result | uint16_t(sign >> 16);
+}
+
+float halfToFloat(uint16_t value)
+{
+    const uint32_t shiftedExponent = 0x7C00u << 13;
+    FloatBits magic;
+    magic.u = 113u << 23;
+
+    FloatBits result;
+    result.u = uint32_t(value & 0x7FFFu) << 13;
+    uint32_t exponent = shiftedExponent & result.u;
+    result.u += (127u - 15u) << 23;
+    if (exponent == shiftedExponent) {
+        // Inf or NaN
+        result.u += (128u - 16u) << 23;
+    } else if (exponent == 0) {
+        // Subnormal or zero
+        result.u += 1u << 23;
+        result.f -= magic.f;
+    }
+    result.u |= uint32_t(value & 0x8000u) << 16;
+    return result.f;
+}
+
+glm::vec2 octahedralEncode(const glm::vec3 &normal)
+{
+    float invL1Norm = 1.0f / (std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z));
+    glm::vec2 encoded(normal.x * invL1Norm, normal.y * invL1Norm);
+    if (normal.z < 0.0f) {
+        // Fold the lower hemisphere over the diagonals
+        glm::vec2 folded(
+                (1.0f - std::fabs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f),
+                (1.0f - std::fabs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f));
+        encoded = folded;
+    }
+    return encoded;
+}
+
+glm::vec3 octahedralDecode(const glm::vec2 &encoded)
+{
+    glm::vec3 normal(encoded.x, encoded.y, 1.0f - std::fabs(encoded.x) - std::fabs(encoded.y));
+    if (normal.z < 0.0f) {
+        float x = normal.x;
+        normal.x = (1.0f - std::fabs(normal.y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        normal.y = (1.0f - std::fabs(x)) * (normal.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return glm::normalize(normal);
+}
+
+
+/*! Same as _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(value, minValue), maxValue)) in the default rounding mode, i.e.,
+ * NaN is mapped to minValue and the result is rounded to nearest even. The scalar fallbacks below use this, so they
+ * produce exactly the same values as the SSE2 paths. */
+static inline int32_t quantizeClamped(float value, float minValue, float maxValue)
+{
+    value = value > minValue ? value : minValue;
+    value = value < maxValue ? value : maxValue;
+    return int32_t(std::nearbyint(value));
+}
+
+#ifdef __SSE2__
+/*! Loads four consecutive glm::vec3 values and transposes them to structure of arrays layout.
+ * Input registers: a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3). */
+static inline void loadVec3x4(const glm::vec3 *data, __m128 &x, __m128 &y, __m128 &z)
+{
+    const float *floatData = &data->x;
+    __m128 a = _mm_loadu_ps(floatData);
+    __m128 b = _mm_loadu_ps(floatData + 4);
+    __m128 c = _mm_loadu_ps(floatData + 8);
+    x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+            _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+            _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//! Converts four floats to half-precision floats (stored in the lower 16 bits of each 32-bit lane).
+static inline __m128i floatToHalfSSE2(__m128 f)
+{
+    const __m128i maskSign = _mm_set1_epi32(int(0x80000000u));
+    const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+    const __m128i nanBit = _mm_set1_epi32(0x200);
+    const __m128i infinityAsFp16 = _mm_set1_epi32(0x7C00);
+    const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+    const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const __m128i normalBias = _mm_set1_epi32(0xFFF - ((127 - 15) << 23));
+
+    __m128i sign = _mm_and_si128(_mm_castps_si128(f), maskSign);
+    __m128 absF = _mm_castsi128_ps(_mm_xor_si128(_mm_castps_si128(f), sign));
+    __m128i absFInt = _mm_castps_si128(absF);
+
+    __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+    __m128i isRegular = _mm_cmpgt_epi32(f16Max, absFInt);
+    __m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, nanBit), infinityAsFp16);
+    __m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absFInt);
+
+    // Subnormal path: Let the FPU do the rounding.
+    __m128 subnormal1 = _mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic));
+    __m128i subnormal2 = _mm_sub_epi32(_mm_castps_si128(subnormal1), subnormalMagic);
+
+    // Normal path: Round to nearest even.
+    __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absFInt, 31 - 13), 31);
+    __m128i rounded = _mm_sub_epi32(_mm_add_epi32(absFInt, normalBias), mantissaOdd);
+    __m128i normal = _mm_srli_epi32(rounded, 13);
+
+    __m128i notNan = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal2), _mm_andnot_si128(isSubnormal, normal));
+    __m128i joined = _mm_or_si128(_mm_and_si128(isRegular, notNan), _mm_andnot_si128(isRegular, infOrNan));
+    return _mm_or_si128(joined, _mm_srli_epi32(sign, 16));
+}
+#endif
+
+void packPositions(const glm::vec3 *positions, size_t numVertices, const AABB3 &aabb, VertexPacked *packedVertices)
+{
+    glm::vec3 dimensions = aabb.getDimensions();
+    glm::vec3 scale(
+            dimensions.x > 0.0f ? 65535.0f / dimensions.x : 0.0f,
+            dimensions.y > 0.0f ? 65535.0f / dimensions.y : 0.0f,
+            dimensions.z > 0.0f ? 65535.0f / dimensions.z : 0.0f);
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128 minX = _mm_set1_ps(aabb.min.x), minY = _mm_set1_ps(aabb.min.y), minZ = _mm_set1_ps(aabb.min.z);
+    const __m128 scaleX = _mm_set1_ps(scale.x), scaleY = _mm_set1_ps(scale.y), scaleZ = _mm_set1_ps(scale.z);
+    const __m128 zero = _mm_setzero_ps(), maxValue = _mm_set1_ps(65535.0f);
+    int32_t quantizedX[4], quantizedY[4], quantizedZ[4];
+    for (; i + 4 <= numVertices; i += 4) {
+        __m128 x, y, z;
+        loadVec3x4(positions + i, x, y, z);
+        // Rounding uses the default MXCSR mode (round to nearest even), like quantizeClamped.
+        x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(x, minX), scaleX), zero), maxValue);
+        y = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(y, minY), scaleY), zero), maxValue);
+        z = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(z, minZ), scaleZ), zero), maxValue);
+        _mm_storeu_si128((__m128i*)quantizedX, _mm_cvtps_epi32(x));
+        _mm_storeu_si128((__m128i*)quantizedY, _mm_cvtps_epi32(y));
+        _mm_storeu_si128((__m128i*)quantizedZ, _mm_cvtps_epi32(z));
+        for (int j = 0; j < 4; ++j) {
+            VertexPacked &vertex = packedVertices[i + j];
+            vertex.position[0] = uint16_t(quantizedX[j]);
+            vertex.position[1] = uint16_t(quantizedY[j]);
+            vertex.position[2] = uint16_t(quantizedZ[j]);
+            vertex.position[3] = 0;
+        }
+    }
+#endif
+
+    for (; i < numVertices; ++i) {
+        glm::vec3 scaled = (positions[i] - aabb.min) * scale;
+        VertexPacked &vertex = packedVertices[i];
+        vertex.position[0] = uint16_t(quantizeClamped(scaled.x, 0.0f, 65535.0f));
+        vertex.position[1] = uint16_t(quantizeClamped(scaled.y, 0.0f, 65535.0f));
+        vertex.position[2] = uint16_t(quantizeClamped(scaled.z, 0.0f, 65535.0f));
+        vertex.position[3] = 0;
+    }
+}
+
+void packNormals(const glm::vec3 *normals, size_t numVertices, VertexPacked *packedVertices)
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 snormScale = _mm_set1_ps(32767.0f), snormMin = _mm_set1_ps(-32767.0f);
+    int32_t encodedX[4], encodedY[4];
+    for (; i + 4 <= numVertices; i += 4) {
+        __m128 x, y, z;
+        loadVec3x4(normals + i, x, y, z);
+        __m128 absX = _mm_andnot_ps(signMask, x), absY = _mm_andnot_ps(signMask, y), absZ = _mm_andnot_ps(signMask, z);
+        __m128 invL1Norm = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(absX, absY), absZ));
+        __m128 u = _mm_mul_ps(x, invL1Norm), v = _mm_mul_ps(y, invL1Norm);
+
+        // Fold the lower hemisphere. sign(u) is 1 for u >= 0 and -1 otherwise.
+        __m128 signU = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(u, zero), signMask), one);
+        __m128 signV = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(v, zero), signMask), one);
+        __m128 foldedU = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, v)), signU);
+        __m128 foldedV = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, u)), signV);
+        __m128 lowerHemisphere = _mm_cmplt_ps(z, zero);
+        u = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedU), _mm_andnot_ps(lowerHemisphere, u));
+        v = _mm_or_ps(_mm_and_ps(lowerHemisphere, foldedV), _mm_andnot_ps(lowerHemisphere, v));
+
+        // Zero-length normals give NaN, which is clamped to -32767 like in the scalar path.
+        u = _mm_min_ps(_mm_max_ps(_mm_mul_ps(u, snormScale), snormMin), snormScale);
+        v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, snormScale), snormMin), snormScale);
+        _mm_storeu_si128((__m128i*)encodedX, _mm_cvtps_epi32(u));
+        _mm_storeu_si128((__m128i*)encodedY, _mm_cvtps_epi32(v));
+        for (int j = 0; j < 4; ++j) {
+            packedVertices[i + j].normal[0] = int16_t(encodedX[j]);
+            packedVertices[i + j].normal[1] = int16_t(encodedY[j]);
+        }
+    }
+#endif
+
+    for (; i < numVertices; ++i) {
+        glm::vec2 encoded = octahedralEncode(normals[i]);
+        packedVertices[i].normal[0] = int16_t(quantizeClamped(encoded.x * 32767.0f, -32767.0f, 32767.0f));
+        packedVertices[i].normal[1] = int16_t(quantizeClamped(encoded.y * 32767.0f, -32767.0f, 32767.0f));
+    }
+}
+
+void packTexcoords(const glm::vec2 *texcoords, size_t numVertices, VertexPacked *packedVertices)
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    int32_t halves[4];
+    for (; i + 2 <= numVertices; i += 2) {
+        _mm_storeu_si128((__m128i*)halves, floatToHalfSSE2(_mm_loadu_ps(&texcoords[i].x)));
+        packedVertices[i].texcoord[0] = uint16_t(halves[0]);
+        packedVertices[i].texcoord[1] = uint16_t(halves[1]);
+        packedVertices[i + 1].texcoord[0] = uint16_t(halves[2]);
+        packedVertices[i + 1].texcoord[1] = uint16_t(halves[3]);
+    }
+#endif
+
+    for (; i < numVertices; ++i) {
+        packedVertices[i].texcoord[0] = floatToHalf(texcoords[i].x);
+        packedVertices[i].texcoord[1] = floatToHalf(texcoords[i].y);
+    }
+}
+
+void packColors(const glm::vec4 *colors, size_t numVertices, VertexPacked *packedVertices)
+{
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128 zero = _mm_setzero_ps(), unormScale = _mm_set1_ps(255.0f);
+    for (; i < numVertices; ++i) {
+        // The values are clamped before the conversion, so the saturating packs below can't overflow.
+        __m128 scaled = _mm_mul_ps(_mm_loadu_ps(&colors[i].x), unormScale);
+        __m128i color32 = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scaled, zero), unormScale));
+        __m128i color16 = _mm_packs_epi32(color32, color32);
+        uint32_t color8 = uint32_t(_mm_cvtsi128_si32(_mm_packus_epi16(color16, color16)));
+        packedVertices[i].color.setColor(
+                uint8_t(color8), uint8_t(color8 >> 8), uint8_t(color8 >> 16), uint8_t(color8 >> 24));
+    }
+#endif
+
+    for (; i < numVertices; ++i) {
+        glm::vec4 scaled = colors[i] * 255.0f;
+        packedVertices[i].color.setColor(
+                uint8_t(quantizeClamped(scaled.r, 0.0f, 255.0f)), uint8_t(quantizeClamped(scaled.g, 0.0f, 255.0f)),
+                uint8_t(quantizeClamped(scaled.b, 0.0f, 255.0f)), uint8_t(quantizeClamped(scaled.a, 0.0f, 255.0f)));
+    }
+}
+
+glm::vec3 unpackPosition(const VertexPacked &packedVertex, const AABB3 &aabb)
+{
+    glm::vec3 normalized(packedVertex.position[0], packedVertex.position[1], packedVertex.position[2]);
+    return aabb.min + normalized / 65535.0f * aabb.getDimensions();
+}
+
+glm::vec3 unpackNormal(const VertexPacked &packedVertex)
+{
+    // OpenGL maps signed normalized values using max(c/32767, -1)
+    glm::vec2 encoded(
+            std::max(packedVertex.normal[0] / 32767.0f, -1.0f),
+            std::max(packedVertex.normal[1] / 32767.0f, -1.0f));
+    return octahedralDecode(encoded);
+}
+
+glm::vec2 unpackTexcoord(const VertexPacked &packedVertex)
+{
+    return glm::vec2(halfToFloat(packedVertex.texcoord[0]), halfToFloat(packedVertex.texcoord[1]));
+}
+
+}
@@ -0,0 +1,48 @@
+/*!
+ * VertexPacking.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_MESH_VERTEXPACKING_HPP_
+#define GRAPHICS_MESH_VERTEXPACKING_HPP_
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include <Math/Geometry/AABB3.hpp>
+#include "Vertex.hpp"
+
+namespace sgl {
+
+//! Conversion between single-precision and half-precision floats (round to nearest even).
+DLL_OBJECT uint16_t floatToHalf(float value);
+DLL_OBJECT float halfToFloat(uint16_t value);
+
+//! Octahedral normal encoding. Maps a unit vector to [-1,1]^2 and back.
+DLL_OBJECT glm::vec2 octahedralEncode(const glm::vec3 &normal);
+DLL_OBJECT glm::vec3 octahedralDecode(const glm::vec2 &encoded);
+
+/*! Bulk encoders for VertexPacked. Each function only writes the member of the packed vertices it is responsible for.
+ * They use SSE2 if available and fall back to scalar code otherwise. Both paths clamp and round to nearest even the
+ * same way, so the results don't depend on the number of vertices or the instruction set. */
+//! Quantizes the positions to 16-bit unsigned normalized values relative to the passed AABB.
+DLL_OBJECT void packPositions(const glm::vec3 *positions, size_t numVertices, const AABB3 &aabb,
+        VertexPacked *packedVertices);
+//! Encodes the (normalized) normals using the octahedral mapping and 16-bit signed normalized values.
+DLL_OBJECT void packNormals(const glm::vec3 *normals, size_t numVertices, VertexPacked *packedVertices);
+//! Converts the texture coordinates to half-precision floats.
+DLL_OBJECT void packTexcoords(const glm::vec2 *texcoords, size_t numVertices, VertexPacked *packedVertices);
+//! Converts colors in the range [0,1] to RGBA8.
+DLL_OBJECT void packColors(const glm::vec4 *colors, size_t numVertices, VertexPacked *packedVertices);
+
+//! Decoding on the CPU (e.g. for picking or debugging). The GPU does this with normalized attribute conversion.
+DLL_OBJECT glm::vec3 unpackPosition(const VertexPacked &packedVertex, const AABB3 &aabb);
+DLL_OBJECT glm::vec3 unpackNormal(const VertexPacked &packedVertex);
+DLL_OBJECT glm::vec2 unpackTexcoord(const VertexPacked &packedVertex);
+
+}
+
+/*! GRAPHICS_MESH_VERTEXPACKING_HPP_ */
+#endif
@@ -8,9 +8,16 @@
 #include <GL/glew.h>
 #include "GeometryBuffer.hpp"
 #include <Utils/File/Logfile.hpp>
+#include <Utils/Metrics.hpp>
+#include "GpuMemoryBudget.hpp"
 
 namespace sgl {
 
+static MetricGauge &geometryBuffersGauge = MetricsRegistry::get()->getGauge(
+        "geometry_buffers.count", "OpenGL buffer objects in memory");
+static MetricCounter &geometryBufferUploadedBytesCounter = MetricsRegistry::get()->getCounter(
+        "geometry_buffers.bytes_uploaded", "Bytes passed to GeometryBufferGL::subData");
+
 GeometryBufferGL::GeometryBufferGL(size_t size, BufferType type /* = VERTEX_BUFFER */, BufferUse bufferUse /* = BUFFER_STATIC */)
     : GeometryBuffer(size, type, bufferUse)
 {
@@ -19,6 +26,8 @@ GeometryBufferGL::GeometryBufferGL(size_t size, BufferType type /* = VERTEX_BUFF
     glGenBuffers(1, &buffer);
     glBindBuffer(oglBufferType, buffer);
     glBufferData(oglBufferType, size, NULL, oglBufferUsage);
+    geometryBuffersGauge.add(1);
+    GpuMemoryBudget::get()->onAllocate(getGpuMemoryCategory(), size);
 }
 
 GeometryBufferGL::GeometryBufferGL(size_t size, void *data, BufferType type /* = VERTEX_BUFFER*/, BufferUse bufferUse /* = BUFFER_STATIC */)
@@ -29,6 +38,8 @@ GeometryBufferGL::GeometryBufferGL(size_t size, void *data, BufferType type /* =
     glGenBuffers(1, &buffer);
     glBindBuffer(oglBufferType, buffer);
     glBufferData(oglBufferType, size, data, oglBufferUsage);
+    geometryBuffersGauge.add(1);
+    GpuMemoryBudget::get()->onAllocate(getGpuMemoryCategory(), size);
 }
 
 void GeometryBufferGL::initialize(BufferType type, BufferUse bufferUse)
@@ -53,6 +64,16 @@ void GeometryBufferGL::initialize(BufferType type, BufferUse bufferUse)
 GeometryBufferGL::~GeometryBufferGL()
 {
     glDeleteBuffers(1, &buffer);
+    geometryBuffersGauge.subtract(1);
+    GpuMemoryBudget::get()->onFree(getGpuMemoryCategory(), bufferSize);
+}
+
+GpuMemoryCategory GeometryBufferGL::getGpuMemoryCategory() const
+{
+    if (bufferType == SHADER_STORAGE_BUFFER || bufferType == UNIFORM_BUFFER) {
+        return GPU_MEMORY_SHADER_BUFFERS;
+    }
+    return GPU_MEMORY_GEOMETRY_BUFFERS;
 }
 
 void GeometryBufferGL::subData(int offset, size_t size, void *data)
@@ -63,6 +84,7 @@ void GeometryBufferGL::subData(int offset, size_t size, void *data)
 
     glBindBuffer(oglBufferType, buffer);
     glBufferSubData(oglBufferType, offset, size, data);
+    geometryBufferUploadedBytesCounter.add(size);
 }
 
 void *GeometryBufferGL::mapBuffer(BufferMapping accessType)
@@ -9,6 +9,7 @@
 #define GRAPHICS_OPENGL_GEOMETRYBUFFER_HPP_
 
 #include <Graphics/Buffers/GeometryBuffer.hpp>
+#include "GpuMemoryBudget.hpp"
 
 namespace sgl {
 
@@ -29,6 +30,7 @@ public:
 
 private:
     void initialize(BufferType type, BufferUse bufferUse);
+    GpuMemoryCategory getGpuMemoryCategory() const;
     unsigned int buffer;
     unsigned int oglBufferType;
     unsigned int oglBufferUsage;
@@ -0,0 +1,243 @@
+/*
+ * GpuMemoryBudget.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <GL/glew.h>
+#include <cstdio>
+#include <algorithm>
+#include "GpuMemoryBudget.hpp"
+#include "SystemGL.hpp"
+#include <Utils/Metrics.hpp>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+const char *getGpuMemoryCategoryName(GpuMemoryCategory category)
+{
+    switch (category) {
+    case GPU_MEMORY_TEXTURES:
+        return "textures";
+    case GPU_MEMORY_GEOMETRY_BUFFERS:
+        return "geometry_buffers";
+    case GPU_MEMORY_SHADER_BUFFERS:
+        return "shader_buffers";
+    default:
+        return "total";
+    }
+}
+
+//! Bytes per texel of the internal format (4 for unknown formats).
+static size_t getInternalFormatSize(int internalFormat)
+{
+    switch (internalFormat) {
+    case GL_R8: case GL_R8I: case GL_R8UI: case GL_R8_SNORM: case GL_RED: case GL_STENCIL_INDEX8:
+        return 1;
+    case GL_RG8: case GL_RG8I: case GL_RG8UI: case GL_RG8_SNORM: case GL_RG:
+    case GL_R16: case GL_R16F: case GL_R16I: case GL_R16UI: case GL_R16_SNORM: case GL_DEPTH_COMPONENT16:
+        return 2;
+    // Like GL_RGB8 (see below), three channels of 16 bits are usually padded to four channels.
+    case GL_RGB16: case GL_RGB16F: case GL_RGB16I: case GL_RGB16UI: case GL_RGB16_SNORM:
+    case GL_RGBA16: case GL_RGBA16F: case GL_RGBA16I: case GL_RGBA16UI: case GL_RGBA16_SNORM:
+    case GL_RG32F: case GL_RG32I: case GL_RG32UI: case GL_DEPTH32F_STENCIL8:
+        return 8;
+    case GL_RGB32F: case GL_RGB32I: case GL_RGB32UI:
+        return 12;
+    case GL_RGBA32F: case GL_RGBA32I: case GL_RGBA32UI:
+        return 16;
+    default:
+        // E.g. GL_RGBA8, GL_SRGB8_ALPHA8, GL_R32F, GL_RG16F, GL_R11F_G11F_B10F, GL_DEPTH24_STENCIL8 and GL_RGB8, which
+        // drivers usually pad to four bytes. Compressed formats (0.5 or 1 byte per texel) are overestimated.
+        return 4;
+    }
+}
+
+size_t estimateTextureMemorySize(int width, int height, int depth, const TextureSettings &settings, int numSamples)
+{
+    size_t w = size_t(std::max(width, 1));
+    size_t h = size_t(std::max(height, 1));
+    size_t d = size_t(std::max(depth, 1));
+    // Array layers are not reduced in size by the mipmap chain.
+    size_t numLayers = 1;
+    if (settings.type == TEXTURE_1D_ARRAY) {
+        numLayers = h;
+        h = 1;
+    } else if (settings.type == TEXTURE_2D_ARRAY) {
+        numLayers = d;
+        d = 1;
+    }
+
+    bool hasMipmaps = numSamples <= 0 && (settings.textureMinFilter == GL_NEAREST_MIPMAP_NEAREST
+            || settings.textureMinFilter == GL_LINEAR_MIPMAP_NEAREST
+            || settings.textureMinFilter == GL_NEAREST_MIPMAP_LINEAR
+            || settings.textureMinFilter == GL_LINEAR_MIPMAP_LINEAR);
+    size_t numTexels = 0;
+    while (true) {
+        numTexels += w * h * d;
+        if (!hasMipmaps || (w == 1 && h == 1 && d == 1)) {
+            break;
+        }
+        w = std::max(w / 2, size_t(1));
+        h = std::max(h / 2, size_t(1));
+        d = std::max(d / 2, size_t(1));
+    }
+
+    return numTexels * numLayers * getInternalFormatSize(settings.internalFormat) * size_t(std::max(numSamples, 1));
+}
+
+
+GpuMemoryBudget *GpuMemoryBudget::get()
+{
+    static GpuMemoryBudget *budget = new GpuMemoryBudget;
+    return budget;
+}
+
+GpuMemoryBudget::GpuMemoryBudget()
+{
+    for (int i = 0; i <= NUM_GPU_MEMORY_CATEGORIES; i++) {
+        CategoryData &categoryData = categories[i];
+        categoryData.usedBytes = 0;
+        categoryData.peakBytes = 0;
+        categoryData.budgetBytes = 0;
+        categoryData.warnedAboutBudget = false;
+        categoryData.usedBytesGauge = &MetricsRegistry::get()->getGauge(
+                std::string() + "gpu_memory." + getGpuMemoryCategoryName(GpuMemoryCategory(i)) + ".bytes",
+                "Estimated GPU memory allocated by sgl");
+    }
+}
+
+void GpuMemoryBudget::onAllocate(GpuMemoryCategory category, size_t numBytes)
+{
+    for (int i : { int(category), int(GPU_MEMORY_TOTAL) }) {
+        CategoryData &categoryData = categories[i];
+        int64_t usedBytes = categoryData.usedBytes.fetch_add(int64_t(numBytes)) + int64_t(numBytes);
+        int64_t peakBytes = categoryData.peakBytes.load(std::memory_order_relaxed);
+        while (usedBytes > peakBytes && !categoryData.peakBytes.compare_exchange_weak(peakBytes, usedBytes)) {}
+        categoryData.usedBytesGauge->set(usedBytes);
+    }
+
+    checkBudget(category);
+    checkBudget(GPU_MEMORY_TOTAL);
+}
+
+void GpuMemoryBudget::onFree(GpuMemoryCategory category, size_t numBytes)
+{
+    for (int i : { int(category), int(GPU_MEMORY_TOTAL) }) {
+        CategoryData &categoryData = categories[i];
+        int64_t usedBytes = categoryData.usedBytes.fetch_sub(int64_t(numBytes)) - int64_t(numBytes);
+        categoryData.usedBytesGauge->set(usedBytes);
+        int64_t budgetBytes = categoryData.budgetBytes.load(std::memory_order_relaxed);
+        if (budgetBytes == 0 || usedBytes <= budgetBytes) {
+            categoryData.warnedAboutBudget = false;
+        }
+    }
+}
+
+size_t GpuMemoryBudget::getUsedBytes(GpuMemoryCategory category)
+{
+    return size_t(std::max(categories[category].usedBytes.load(), int64_t(0)));
+}
+
+size_t GpuMemoryBudget::getPeakBytes(GpuMemoryCategory category)
+{
+    return size_t(categories[category].peakBytes.load());
+}
+
+void GpuMemoryBudget::setBudget(GpuMemoryCategory category, size_t numBytes)
+{
+    categories[category].budgetBytes = int64_t(numBytes);
+    categories[category].warnedAboutBudget = false;
+    checkBudget(category);
+}
+
+size_t GpuMemoryBudget::getBudget(GpuMemoryCategory category)
+{
+    return size_t(categories[category].budgetBytes.load());
+}
+
+int GpuMemoryBudget::addEvictionCallback(GpuMemoryCategory category, EvictionCallback callback)
+{
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    CallbackEntry entry;
+    entry.token = nextCallbackToken++;
+    entry.category = category;
+    entry.callback = callback;
+    evictionCallbacks.push_back(entry);
+    return entry.token;
+}
+
+void GpuMemoryBudget::removeEvictionCallback(int token)
+{
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    evictionCallbacks.erase(
+            std::remove_if(evictionCallbacks.begin(), evictionCallbacks.end(), [token](const CallbackEntry &entry) {
+                return entry.token == token;
+            }), evictionCallbacks.end());
+}
+
+static std::string formatMebibytes(int64_t numBytes)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.1f", double(numBytes) / (1024.0 * 1024.0));
+    return buffer;
+}
+
+void GpuMemoryBudget::checkBudget(GpuMemoryCategory category)
+{
+    // Resources freed or created by the callbacks call onFree/onAllocate again.
+    static thread_local bool isEvicting = false;
+    CategoryData &categoryData = categories[category];
+    int64_t budgetBytes = categoryData.budgetBytes.load(std::memory_order_relaxed);
+    if (budgetBytes == 0 || categoryData.usedBytes.load() <= budgetBytes || isEvicting) {
+        return;
+    }
+
+    // Copy the callbacks, as they may add or remove callbacks themselves.
+    std::vector<CallbackEntry> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        for (const CallbackEntry &entry : evictionCallbacks) {
+            if (entry.category == category || entry.category == GPU_MEMORY_TOTAL) {
+                callbacks.push_back(entry);
+            }
+        }
+    }
+
+    isEvicting = true;
+    for (const CallbackEntry &entry : callbacks) {
+        int64_t usedBytes = categoryData.usedBytes.load();
+        if (usedBytes <= budgetBytes) {
+            break;
+        }
+        entry.callback(category, size_t(usedBytes - budgetBytes));
+    }
+    isEvicting = false;
+
+    int64_t usedBytes = categoryData.usedBytes.load();
+    if (usedBytes > budgetBytes && !categoryData.warnedAboutBudget.exchange(true)) {
+        Logfile::get()->writeError(std::string() + "WARNING: GpuMemoryBudget::checkBudget: The budget for "
+                + getGpuMemoryCategoryName(category) + " is exceeded (" + formatMebibytes(usedBytes)
+                + " MiB used, " + formatMebibytes(budgetBytes) + " MiB budget).");
+    }
+}
+
+int64_t GpuMemoryBudget::queryAvailableDeviceMemoryKilobytes()
+{
+    // https://www.khronos.org/registry/OpenGL/extensions/NVX/NVX_gpu_memory_info.txt
+    if (SystemGL::get()->isGLExtensionAvailable("GL_NVX_gpu_memory_info")) {
+        GLint availableMemoryKilobytes = 0;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &availableMemoryKilobytes);
+        return availableMemoryKilobytes;
+    }
+    // https://www.khronos.org/registry/OpenGL/extensions/ATI/ATI_meminfo.txt (first value: total free memory)
+    if (SystemGL::get()->isGLExtensionAvailable("GL_ATI_meminfo")) {
+        GLint textureFreeMemory[4] = { 0, 0, 0, 0 };
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, textureFreeMemory);
+        return textureFreeMemory[0];
+    }
+    return -1;
+}
+
+}
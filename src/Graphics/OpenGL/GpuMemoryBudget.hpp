@@ -0,0 +1,114 @@
+/*!
+ * GpuMemoryBudget.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef GRAPHICS_OPENGL_GPUMEMORYBUDGET_HPP_
+#define GRAPHICS_OPENGL_GPUMEMORYBUDGET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include <Defs.hpp>
+#include <Graphics/Texture/Texture.hpp>
+
+namespace sgl {
+
+class MetricGauge;
+
+enum GpuMemoryCategory {
+    GPU_MEMORY_TEXTURES,         //!< TextureGL
+    GPU_MEMORY_GEOMETRY_BUFFERS, //!< Vertex and index buffers
+    GPU_MEMORY_SHADER_BUFFERS,   //!< Shader storage and uniform buffers
+    GPU_MEMORY_TOTAL             //!< Sum of all categories (only for budgets and queries)
+};
+#define NUM_GPU_MEMORY_CATEGORIES 3
+DLL_OBJECT const char *getGpuMemoryCategoryName(GpuMemoryCategory category);
+
+/**
+ * Estimated size of the texture storage in bytes (format × dimensions × samples, including the mipmap chain if a
+ * mipmap minification filter is used). Drivers may add padding and alignment, so the actual usage can be higher.
+ * Unknown formats count as four bytes per texel, so compressed formats (e.g. S3TC/BPTC) are overestimated.
+ */
+DLL_OBJECT size_t estimateTextureMemorySize(int width, int height, int depth, const TextureSettings &settings,
+        int numSamples);
+
+/**
+ * Bookkeeping of the GPU memory allocated by sgl (TextureGL and GeometryBufferGL report their estimated sizes in their
+ * constructors and destructors). A budget can be set per category and for the total. If an allocation exceeds a
+ * budget, the registered eviction callbacks are called so that the application can free cached data (e.g. datasets
+ * that aren't visible). If the budget is still exceeded afterwards, a warning is written to the log file.
+ * The used memory is also published as gauges in MetricsRegistry ("gpu_memory.textures.bytes", ...).
+ */
+class DLL_OBJECT GpuMemoryBudget
+{
+public:
+    /**
+     * Called with the category whose budget was exceeded (GPU_MEMORY_TOTAL for the total budget) and the number of
+     * bytes that need to be freed to get below the budget again.
+     */
+    typedef std::function<void(GpuMemoryCategory category, size_t bytesToFree)> EvictionCallback;
+
+    //! Thread-safe; the object is created on first use and never destroyed.
+    static GpuMemoryBudget *get();
+
+    void onAllocate(GpuMemoryCategory category, size_t numBytes);
+    void onFree(GpuMemoryCategory category, size_t numBytes);
+
+    size_t getUsedBytes(GpuMemoryCategory category);
+    //! High-water mark of getUsedBytes.
+    size_t getPeakBytes(GpuMemoryCategory category);
+
+    //! Sets the budget in bytes (0, i.e., no budget, is the default).
+    void setBudget(GpuMemoryCategory category, size_t numBytes);
+    size_t getBudget(GpuMemoryCategory category);
+
+    /**
+     * Callbacks registered for a category are called if the budget of this category is exceeded. Callbacks registered
+     * for GPU_MEMORY_TOTAL are called if any budget is exceeded. The callbacks are called on the thread allocating
+     * the memory (usually the thread owning the OpenGL context), and allocations within a callback don't trigger
+     * further callbacks.
+     * @return A token for removeEvictionCallback.
+     */
+    int addEvictionCallback(GpuMemoryCategory category, EvictionCallback callback);
+    void removeEvictionCallback(int token);
+
+    /**
+     * Free memory reported by the driver (GL_NVX_gpu_memory_info or GL_ATI_meminfo) in kilobytes, or -1 if neither
+     * extension is supported. Needs to be called on the thread owning the OpenGL context.
+     */
+    static int64_t queryAvailableDeviceMemoryKilobytes();
+
+private:
+    GpuMemoryBudget();
+    void checkBudget(GpuMemoryCategory category);
+
+    struct CategoryData {
+        std::atomic<int64_t> usedBytes;
+        std::atomic<int64_t> peakBytes;
+        std::atomic<int64_t> budgetBytes;
+        //! Avoids writing a warning for every allocation while the budget stays exceeded.
+        std::atomic<bool> warnedAboutBudget;
+        MetricGauge *usedBytesGauge;
+    };
+    CategoryData categories[NUM_GPU_MEMORY_CATEGORIES + 1];
+
+    struct CallbackEntry {
+        int token;
+        GpuMemoryCategory category;
+        EvictionCallback callback;
+    };
+    std::mutex callbackMutex;
+    std::vector<CallbackEntry> evictionCallbacks;
+    int nextCallbackToken = 0;
+};
+
+}
+
+/*! GRAPHICS_OPENGL_GPUMEMORYBUDGET_HPP_ */
+#endif
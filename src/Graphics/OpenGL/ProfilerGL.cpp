@@ -0,0 +1,262 @@
+/**
+ * @file ProfilerGL.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <algorithm>
+#include <iomanip>
+
+#include <GL/glew.h>
+
+#include "ProfilerGL.hpp"
+
+namespace sgl
+{
+
+void ProfilerSampleWindow::addSample(double timeMS)
+{
+    if (samples.size() < windowSize) {
+        samples.push_back(float(timeMS));
+    } else {
+        samples.at(nextSample) = float(timeMS);
+        nextSample = (nextSample + 1) % windowSize;
+    }
+}
+
+ProfilerStatistics ProfilerSampleWindow::computeStatistics() const
+{
+    ProfilerStatistics statistics;
+    statistics.numSamples = samples.size();
+    if (samples.empty()) {
+        return statistics;
+    }
+
+    double sum = 0.0;
+    float minValue = samples.front(), maxValue = samples.front();
+    for (float sample : samples) {
+        sum += sample;
+        minValue = std::min(minValue, sample);
+        maxValue = std::max(maxValue, sample);
+    }
+    statistics.minMS = minValue;
+    statistics.maxMS = maxValue;
+    statistics.avgMS = sum / double(samples.size());
+
+    // Nearest-rank 95th percentile
+    std::vector<float> sortedSamples = samples;
+    size_t p95Index = (samples.size() * 95 + 99) / 100 - 1;
+    std::nth_element(sortedSamples.begin(), sortedSamples.begin() + p95Index, sortedSamples.end());
+    statistics.p95MS = sortedSamples.at(p95Index);
+    return statistics;
+}
+
+
+
+ProfilerGL::ProfilerGL(size_t maxQueriesInFlight, size_t windowSize)
+    : maxQueriesInFlight(std::max(maxQueriesInFlight, size_t(1))), windowSize(std::max(windowSize, size_t(1)))
+{
+}
+
+ProfilerGL::~ProfilerGL()
+{
+    deleteAll();
+}
+
+void ProfilerGL::deleteAll()
+{
+    for (ProfilerNodeGL &node : nodes) {
+        if (!node.startQueries.empty()) {
+            glDeleteQueries(GLsizei(node.startQueries.size()), &node.startQueries.front());
+            glDeleteQueries(GLsizei(node.endQueries.size()), &node.endQueries.front());
+        }
+    }
+    nodes.clear();
+    nodeMap.clear();
+    regionStack.clear();
+}
+
+
+void ProfilerGL::beginFrame()
+{
+    for (ProfilerNodeGL &node : nodes) {
+        pollQueries(node);
+    }
+}
+
+void ProfilerGL::endFrame()
+{
+    if (!regionStack.empty()) {
+        std::cerr << "Error in ProfilerGL::endFrame: Region \"" << nodes.at(regionStack.back()).name
+                  << "\" was not ended." << std::endl;
+        while (!regionStack.empty()) {
+            endRegion();
+        }
+    }
+}
+
+void ProfilerGL::pollQueries(ProfilerNodeGL &node)
+{
+    // Only read the results that are already available, i.e., never wait for the GPU
+    auto it = node.pendingQueryPairs.begin();
+    while (it != node.pendingQueryPairs.end()) {
+        size_t pairIndex = *it;
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(node.endQueries.at(pairIndex), GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            // The queries of one region finish in the order they were issued
+            break;
+        }
+
+        GLuint64 startTimeNS = 0, endTimeNS = 0;
+        glGetQueryObjectui64v(node.startQueries.at(pairIndex), GL_QUERY_RESULT, &startTimeNS);
+        glGetQueryObjectui64v(node.endQueries.at(pairIndex), GL_QUERY_RESULT, &endTimeNS);
+        if (endTimeNS >= startTimeNS) {
+            node.gpuTimes.addSample(double(endTimeNS - startTimeNS) * 1e-6);
+        }
+        node.freeQueryPairs.push_back(pairIndex);
+        ++it;
+    }
+    node.pendingQueryPairs.erase(node.pendingQueryPairs.begin(), it);
+}
+
+
+void ProfilerGL::beginRegion(const std::string &name, bool measureGPU)
+{
+    int parent = regionStack.empty() ? -1 : int(regionStack.back());
+    size_t nodeIndex;
+    auto it = nodeMap.find(std::make_pair(parent, name));
+    if (it == nodeMap.end()) {
+        nodeIndex = nodes.size();
+        ProfilerNodeGL node;
+        node.name = name;
+        node.parent = parent;
+        node.depth = regionStack.size();
+        node.cpuTimes = ProfilerSampleWindow(windowSize);
+        node.gpuTimes = ProfilerSampleWindow(windowSize);
+        nodes.push_back(node);
+        if (parent >= 0) {
+            nodes.at(parent).children.push_back(nodeIndex);
+        }
+        nodeMap.insert(std::make_pair(std::make_pair(parent, name), nodeIndex));
+    } else {
+        nodeIndex = it->second;
+    }
+    regionStack.push_back(nodeIndex);
+
+    ProfilerNodeGL &node = nodes.at(nodeIndex);
+    node.activeQueryPair = -1;
+    if (measureGPU) {
+        if (node.freeQueryPairs.empty() && node.startQueries.size() < maxQueriesInFlight) {
+            // Grow the pool of the region lazily
+            GLuint queries[2] = { 0, 0 };
+            glGenQueries(2, queries);
+            node.freeQueryPairs.push_back(node.startQueries.size());
+            node.startQueries.push_back(queries[0]);
+            node.endQueries.push_back(queries[1]);
+        }
+        if (node.freeQueryPairs.empty()) {
+            // All queries are still in flight. Dropping the sample is better than stalling the pipeline.
+            node.numDroppedGpuSamples++;
+        } else {
+            node.activeQueryPair = int(node.freeQueryPairs.back());
+            node.freeQueryPairs.pop_back();
+            glQueryCounter(node.startQueries.at(node.activeQueryPair), GL_TIMESTAMP);
+        }
+    }
+    node.cpuStartTime = std::chrono::high_resolution_clock::now();
+}
+
+void ProfilerGL::endRegion()
+{
+    auto endTime = std::chrono::high_resolution_clock::now();
+    if (regionStack.empty()) {
+        std::cerr << "Error in ProfilerGL::endRegion: No region was begun." << std::endl;
+        return;
+    }
+
+    ProfilerNodeGL &node = nodes.at(regionStack.back());
+    regionStack.pop_back();
+    double cpuTimeMS = std::chrono::duration<double, std::milli>(endTime - node.cpuStartTime).count();
+    node.cpuTimes.addSample(cpuTimeMS);
+    if (node.activeQueryPair >= 0) {
+        glQueryCounter(node.endQueries.at(node.activeQueryPair), GL_TIMESTAMP);
+        node.pendingQueryPairs.push_back(size_t(node.activeQueryPair));
+        node.activeQueryPair = -1;
+    }
+}
+
+
+int ProfilerGL::getNodeIndex(const std::string &path) const
+{
+    int nodeIndex = -1;
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        auto it = nodeMap.find(std::make_pair(nodeIndex, path.substr(start, end - start)));
+        if (it == nodeMap.end()) {
+            return -1;
+        }
+        nodeIndex = int(it->second);
+        start = end + 1;
+    }
+    return nodeIndex;
+}
+
+ProfilerStatistics ProfilerGL::getCpuStatistics(const std::string &path) const
+{
+    int nodeIndex = getNodeIndex(path);
+    if (nodeIndex < 0) {
+        std::cerr << "Invalid name in ProfilerGL::getCpuStatistics" << std::endl;
+        return ProfilerStatistics();
+    }
+    return nodes.at(nodeIndex).cpuTimes.computeStatistics();
+}
+
+ProfilerStatistics ProfilerGL::getGpuStatistics(const std::string &path) const
+{
+    int nodeIndex = getNodeIndex(path);
+    if (nodeIndex < 0) {
+        std::cerr << "Invalid name in ProfilerGL::getGpuStatistics" << std::endl;
+        return ProfilerStatistics();
+    }
+    return nodes.at(nodeIndex).gpuTimes.computeStatistics();
+}
+
+
+void ProfilerGL::printStatistics(std::ostream &stream) const
+{
+    for (size_t i = 0; i < nodes.size(); i++) {
+        if (nodes.at(i).parent < 0) {
+            printNodeStatistics(stream, i);
+        }
+    }
+}
+
+void ProfilerGL::printNodeStatistics(std::ostream &stream, size_t nodeIndex) const
+{
+    const ProfilerNodeGL &node = nodes.at(nodeIndex);
+    ProfilerStatistics cpuStatistics = node.cpuTimes.computeStatistics();
+    ProfilerStatistics gpuStatistics = node.gpuTimes.computeStatistics();
+    stream << std::string(node.depth * 2, ' ') << "PROFILER - " << node.name << std::fixed << std::setprecision(3)
+           << ": CPU " << cpuStatistics.avgMS << "ms (min " << cpuStatistics.minMS << ", p95 " << cpuStatistics.p95MS
+           << ", max " << cpuStatistics.maxMS << ")";
+    if (gpuStatistics.numSamples > 0) {
+        stream << ", GPU " << gpuStatistics.avgMS << "ms (min " << gpuStatistics.minMS
+               << ", p95 " << gpuStatistics.p95MS << ", max " << gpuStatistics.maxMS << ")";
+    }
+    if (node.numDroppedGpuSamples > 0) {
+        stream << ", " << node.numDroppedGpuSamples << " dropped GPU samples";
+    }
+    stream << std::defaultfloat << std::endl;
+
+    for (size_t childIndex : node.children) {
+        printNodeStatistics(stream, childIndex);
+    }
+}
+
+}
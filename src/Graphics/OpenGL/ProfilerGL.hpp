@@ -0,0 +1,151 @@
+/**
+ * @file ProfilerGL.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef PROFILERGL_HPP_
+#define PROFILERGL_HPP_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+namespace sgl
+{
+
+/// Statistics of the last samples of a profiler region (in milliseconds).
+struct ProfilerStatistics
+{
+    double minMS = 0.0;
+    double avgMS = 0.0;
+    double p95MS = 0.0;
+    double maxMS = 0.0;
+    /// Number of samples the statistics were computed from (at most the window size)
+    size_t numSamples = 0;
+};
+
+/// Ring buffer of the last samples of a region.
+class ProfilerSampleWindow
+{
+public:
+    explicit ProfilerSampleWindow(size_t windowSize = 256) : windowSize(windowSize) {}
+    void addSample(double timeMS);
+    ProfilerStatistics computeStatistics() const;
+    void clear() { samples.clear(); nextSample = 0; }
+
+private:
+    size_t windowSize;
+    size_t nextSample = 0;
+    std::vector<float> samples;
+};
+
+/// A region of the profiler tree. Regions with the same name, but different parents are different nodes.
+struct ProfilerNodeGL
+{
+    std::string name;
+    /// -1 for the top level regions
+    int parent = -1;
+    size_t depth = 0;
+    std::vector<size_t> children;
+    ProfilerSampleWindow cpuTimes;
+    ProfilerSampleWindow gpuTimes;
+    /// Number of instances without GPU time, as all queries were still in flight.
+    size_t numDroppedGpuSamples = 0;
+
+private:
+    friend class ProfilerGL;
+    /// Pairs of GL_TIMESTAMP queries (start, end). A pair is either free, active or pending (i.e., in flight).
+    std::vector<unsigned int> startQueries, endQueries;
+    std::vector<size_t> freeQueryPairs;
+    std::vector<size_t> pendingQueryPairs;
+    /// The query pair of the current instance of the region, or -1 if the GPU time is not measured.
+    int activeQueryPair = -1;
+    std::chrono::time_point<std::chrono::high_resolution_clock> cpuStartTime;
+};
+
+/**
+ * Profiler for CPU and GPU times of nested regions. In contrast to @ref TimerGL, measuring never stalls the CPU:
+ * The GPU times are measured with GL_TIMESTAMP queries, and the results are only read when
+ * GL_QUERY_RESULT_AVAILABLE reports that the GPU has finished (usually a few frames later). Every region has a pool
+ * of up to maxQueriesInFlight query pairs, so regions may also be entered multiple times per frame. The regions form
+ * a tree (e.g. "Render/Shadows" and "Render/Lines" are children of "Render"), and the statistics (min/avg/p95/max) are
+ * computed over the last samples of every region.
+ *
+ * Usage:
+ *   profiler.beginFrame();
+ *   {
+ *       ProfilerScopeGL scope(profiler, "Render");
+ *       ...
+ *   }
+ *   profiler.endFrame();
+ */
+class ProfilerGL
+{
+public:
+    /**
+     * @param maxQueriesInFlight The maximum number of unread query pairs per region.
+     * @param windowSize The number of samples the statistics are computed from.
+     */
+    explicit ProfilerGL(size_t maxQueriesInFlight = 8, size_t windowSize = 256);
+    /// Calls deleteAll
+    ~ProfilerGL();
+    /// Deletes all queries and regions
+    void deleteAll();
+
+    /// Reads the results of the finished queries. Call once per frame.
+    void beginFrame();
+    /// Checks that all regions were closed.
+    void endFrame();
+
+    /**
+     * Starts measuring the CPU and (optionally) GPU time of a region, which is nested into the currently open region.
+     * @param name The name of the region.
+     * @param measureGPU Whether to measure the GPU time (e.g. not necessary for regions without OpenGL calls).
+     */
+    void beginRegion(const std::string &name, bool measureGPU = true);
+    /// Ends the region opened last.
+    void endRegion();
+
+    /// The regions as tree (the nodes with parent -1 are the roots).
+    inline const std::vector<ProfilerNodeGL> &getNodes() const { return nodes; }
+    /// Returns the node of a region by its path (e.g. "Render/Lines"), or -1 if it does not exist.
+    int getNodeIndex(const std::string &path) const;
+    ProfilerStatistics getCpuStatistics(const std::string &path) const;
+    ProfilerStatistics getGpuStatistics(const std::string &path) const;
+    /// Prints the statistics of all regions as tree.
+    void printStatistics(std::ostream &stream = std::cout) const;
+
+private:
+    void pollQueries(ProfilerNodeGL &node);
+    void printNodeStatistics(std::ostream &stream, size_t nodeIndex) const;
+
+    size_t maxQueriesInFlight;
+    size_t windowSize;
+    std::vector<ProfilerNodeGL> nodes;
+    /// (Parent index, name) -> node index
+    std::map<std::pair<int, std::string>, size_t> nodeMap;
+    /// The currently open regions
+    std::vector<size_t> regionStack;
+};
+
+/// Opens a region of the profiler in the constructor and closes it in the destructor.
+class ProfilerScopeGL
+{
+public:
+    ProfilerScopeGL(ProfilerGL &profiler, const std::string &name, bool measureGPU = true) : profiler(profiler) {
+        profiler.beginRegion(name, measureGPU);
+    }
+    ~ProfilerScopeGL() { profiler.endRegion(); }
+
+private:
+    ProfilerGL &profiler;
+};
+
+}
+
+#endif /* PROFILERGL_HPP_ */
@@ -546,6 +546,41 @@ void RendererGL::render(ShaderAttributesPtr &shaderAttributes, ShaderProgramPtr
     }
 }
 
+void RendererGL::renderIndexRanges(ShaderAttributesPtr &shaderAttributes, const std::vector<IndexRange> &ranges)
+{
+    if (ranges.empty()) {
+        return;
+    }
+
+    ShaderAttributesPtr attr = shaderAttributes;
+    if (wireframeMode) {
+        attr = shaderAttributes->copy(solidShader);
+    }
+
+    attr->bind();
+    updateMatrixBlock();
+
+    std::vector<GLsizei> counts(ranges.size());
+    if (attr->getNumIndices() > 0) {
+        size_t indexSize = attr->getIndexFormat() == ATTRIB_UNSIGNED_BYTE ? 1
+                : (attr->getIndexFormat() == ATTRIB_UNSIGNED_SHORT ? 2 : 4);
+        std::vector<const GLvoid*> offsets(ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            counts.at(i) = GLsizei(ranges.at(i).numIndices);
+            offsets.at(i) = (const GLvoid*)(ranges.at(i).firstIndex * indexSize);
+        }
+        glMultiDrawElements((GLuint)attr->getVertexMode(), &counts.front(), attr->getIndexFormat(),
+                &offsets.front(), GLsizei(ranges.size()));
+    } else {
+        std::vector<GLint> firsts(ranges.size());
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            counts.at(i) = GLsizei(ranges.at(i).numIndices);
+            firsts.at(i) = GLint(ranges.at(i).firstIndex);
+        }
+        glMultiDrawArrays((GLuint)attr->getVertexMode(), &firsts.front(), &counts.front(), GLsizei(ranges.size()));
+    }
+}
+
 void RendererGL::createMatrixBlock()
 {
     matrixBlockBuffer = this->createGeometryBuffer(sizeof(MatrixBlock), &matrixBlock, UNIFORM_BUFFER, BUFFER_STREAM);
@@ -62,6 +62,7 @@ public:
     virtual void bindTexture(TexturePtr &tex, unsigned int textureUnit = 0);
     virtual void setBlendMode(BlendMode mode);
     virtual void setModelMatrix(const glm::mat4 &matrix);
+    virtual const glm::mat4 &getModelMatrix() { return modelMatrix; }
     virtual void setViewMatrix(const glm::mat4 &matrix);
     virtual void setProjectionMatrix(const glm::mat4 &matrix);
     virtual void setLineWidth(float width);
@@ -79,6 +80,8 @@ public:
     virtual void render(ShaderAttributesPtr &shaderAttributes);
     //! Rendering with overwritten shader (e.g. for multi-pass rendering without calling copy()).
     virtual void render(ShaderAttributesPtr &shaderAttributes, ShaderProgramPtr &passShader);
+    //! Renders only the passed ranges of the index buffer with one draw call (no instancing).
+    virtual void renderIndexRanges(ShaderAttributesPtr &shaderAttributes, const std::vector<IndexRange> &ranges);
 
     //! For debugging purposes
     virtual void setPolygonMode(unsigned int polygonMode);
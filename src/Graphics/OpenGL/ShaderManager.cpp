@@ -22,6 +22,7 @@
 
 #include "ShaderManager.hpp"
 #include <Utils/File/Logfile.hpp>
+#include <Utils/File/Logger.hpp>
 #include <Utils/Convert.hpp>
 #include <Utils/File/FileUtils.hpp>
 #include "Shader.hpp"
@@ -30,6 +31,8 @@
 
 namespace sgl {
 
+static LogCategory shaderManagerLog("ShaderManagerGL");
+
 ShaderManagerGL::ShaderManagerGL()
 {
     pathPrefix = "./Data/Shaders/";
@@ -93,6 +96,7 @@ void ShaderManagerGL::bindUniformBuffer(int binding, GeometryBufferPtr &geometry
         return;
     }
 
+    SGL_LOG_TRACE(shaderManagerLog, "bindUniformBuffer: binding %d, buffer %u", binding, unsigned(bufferID));
     glBindBufferBase(GL_UNIFORM_BUFFER, binding, bufferID);
     uniformBuffers[binding] = geometryBuffer;
 }
@@ -109,6 +113,7 @@ void ShaderManagerGL::bindAtomicCounterBuffer(int binding, GeometryBufferPtr &ge
         return;
     }
 
+    SGL_LOG_TRACE(shaderManagerLog, "bindAtomicCounterBuffer: binding %d, buffer %u", binding, unsigned(bufferID));
     glBindBufferBase(GL_ATOMIC_COUNTER_BUFFER, binding, bufferID);
     atomicCounterBuffers[binding] = geometryBuffer;
 }
@@ -125,6 +130,7 @@ void ShaderManagerGL::bindShaderStorageBuffer(int binding, GeometryBufferPtr &ge
         return;
     }
 
+    SGL_LOG_TRACE(shaderManagerLog, "bindShaderStorageBuffer: binding %d, buffer %u", binding, unsigned(bufferID));
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, bufferID);
     shaderStorageBuffers[binding] = geometryBuffer;
 }
@@ -180,6 +186,7 @@ ShaderProgramPtr ShaderManagerGL::createShaderProgram(const std::list<std::strin
     }
     dumpTextDebugStatic = false;
     shaderProgram->linkProgram();
+    SGL_LOG_DEBUG(shaderManagerLog, "Created shader program from %u shaders", unsigned(shaderIDs.size()));
     return shaderProgram;
 }
 
@@ -199,6 +206,8 @@ ShaderPtr ShaderManagerGL::loadAsset(ShaderInfo &shaderInfo)
     shaderGL->setShaderText(shaderString);
     shaderGL->setFileID(shaderInfo.filename.c_str());
     shaderGL->compile();
+    SGL_LOG_DEBUG(shaderManagerLog, "Compiled shader \"%s\" (%u characters)",
+            id.c_str(), unsigned(shaderString.size()));
     return shader;
 }
 
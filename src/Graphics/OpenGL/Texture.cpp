@@ -8,30 +8,56 @@
 #include <GL/glew.h>
 #include "Texture.hpp"
 #include <Graphics/Renderer.hpp>
+#include <Utils/Metrics.hpp>
+#include "GpuMemoryBudget.hpp"
 
 namespace sgl {
 
+static MetricGauge &texturesGauge = MetricsRegistry::get()->getGauge(
+        "textures.count", "OpenGL textures (including texture views) in memory");
+
 TextureGL::TextureGL(unsigned int _texture, int _w, TextureSettings settings, int _samples /* = 0 */)
         : Texture(_w, settings, _samples)
 {
     texture = _texture;
+    texturesGauge.add(1);
+    registerGpuMemory();
 }
 
 TextureGL::TextureGL(unsigned int _texture, int _w, int _h, TextureSettings settings, int _samples /* = 0 */)
         : Texture(_w, _h, settings, _samples)
 {
     texture = _texture;
+    texturesGauge.add(1);
+    registerGpuMemory();
 }
 
 TextureGL::TextureGL(unsigned int _texture, int _w, int _h, int _d, TextureSettings settings, int _samples /* = 0 */)
         : Texture(_w, _h, _d, settings, _samples)
 {
     texture = _texture;
+    texturesGauge.add(1);
+    registerGpuMemory();
+}
+
+TextureGL::TextureGL(unsigned int _textureView, const TextureGL &baseTexture)
+        : Texture(baseTexture.w, baseTexture.h, baseTexture.d, baseTexture.settings, baseTexture.samples)
+{
+    texture = _textureView;
+    texturesGauge.add(1);
 }
 
 TextureGL::~TextureGL()
 {
     glDeleteTextures(1, &texture);
+    texturesGauge.subtract(1);
+    GpuMemoryBudget::get()->onFree(GPU_MEMORY_TEXTURES, gpuMemorySize);
+}
+
+void TextureGL::registerGpuMemory()
+{
+    gpuMemorySize = estimateTextureMemorySize(w, h, d, settings, samples);
+    GpuMemoryBudget::get()->onAllocate(GPU_MEMORY_TEXTURES, gpuMemorySize);
 }
 
 void TextureGL::uploadPixelData(int width, void *pixelData, PixelFormat pixelFormat)
@@ -60,7 +86,7 @@ TexturePtr TextureGL::createTextureView() {
     GLuint textureViewGL;
     glGenTextures(1, &textureViewGL);
     glTextureView(textureViewGL, GL_TEXTURE_2D, this->texture, settings.internalFormat, 0, 1, 0, 1);
-    return TexturePtr(new TextureGL(textureViewGL, w, h, d, settings, samples));
+    return TexturePtr(new TextureGL(textureViewGL, *this));
 }
 
 }
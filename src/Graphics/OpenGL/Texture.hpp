@@ -25,9 +25,15 @@ public:
     /// Do NOT access a texture view anymore after the reference count of the base texture has reached zero!
     virtual TexturePtr createTextureView();
     inline unsigned int getTexture() const { return texture; }
+    /// Estimated size of the texture in GPU memory (see GpuMemoryBudget).
+    inline size_t getGpuMemorySize() const { return gpuMemorySize; }
 
 protected:
+    /// Texture view sharing the storage of baseTexture (not counted by GpuMemoryBudget).
+    TextureGL(unsigned int _textureView, const TextureGL &baseTexture);
+    void registerGpuMemory();
     unsigned int texture;
+    size_t gpuMemorySize = 0;
 };
 
 }
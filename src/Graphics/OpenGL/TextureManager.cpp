@@ -12,6 +12,8 @@
 #include "Texture.hpp"
 #include <Utils/File/ResourceManager.hpp>
 #include <Utils/File/Logfile.hpp>
+#include <Utils/File/Logger.hpp>
+#include <Utils/Metrics.hpp>
 #include <Utils/Convert.hpp>
 #include <Math/Math.hpp>
 #include <Graphics/Texture/TextureManager.hpp>
@@ -20,6 +22,10 @@
 
 namespace sgl {
 
+static LogCategory textureManagerLog("TextureManagerGL");
+static MetricCounter &texturesLoadedCounter = MetricsRegistry::get()->getCounter(
+        "textures.files_loaded", "Texture files loaded by TextureManagerGL");
+
 TexturePtr TextureManagerGL::createEmptyTexture(int width, const TextureSettings &settings)
 {
     GLuint TEXTURE_TYPE = GL_TEXTURE_1D;
@@ -101,6 +107,8 @@ TexturePtr TextureManagerGL::createTexture(void *data, int width, const TextureS
 
 TexturePtr TextureManagerGL::loadAsset(TextureInfo &textureInfo)
 {
+    SGL_LOG_DEBUG(textureManagerLog, "Loading texture \"%s\"", textureInfo.filename.c_str());
+    texturesLoadedCounter.add();
     ResourceBufferPtr resource = ResourceManager::get()->getFileSync(textureInfo.filename.c_str());
     if (!resource) {
         Logfile::get()->writeError(std::string() + "TextureManagerGL::loadFromFile: Unable to load image file "
@@ -250,6 +258,8 @@ TexturePtr TextureManagerGL::createTexture(void *data, int width, int height, co
 
 TexturePtr TextureManagerGL::createEmptyTexture(int width, int height, int depth, const TextureSettings &settings)
 {
+    SGL_LOG_DEBUG(textureManagerLog, "createEmptyTexture: %dx%dx%d, internal format 0x%X",
+            width, height, depth, unsigned(settings.internalFormat));
     GLuint TEXTURE_TYPE = (GLuint)settings.type;
 
     GLuint oglTexture;
@@ -11,6 +11,7 @@
 #include <GL/glew.h>
 
 #include "TimerGL.hpp"
+#include <Utils/TraceRecorder.hpp>
 
 namespace sgl
 {
@@ -36,6 +37,10 @@ void TimerGL::startGPU(const std::string &name, float timeStamp)
         numSamples.push_back(0);
         queryHasFinished.push_back(false);
         frameTimeList.clear();
+#ifdef SGL_TRACING
+        traceNames.push_back(TraceRecorder::get()->internString(name));
+        traceStartTimesNS.push_back(0);
+#endif
     } else {
         // Add time to already stored event of last frame
         index = it->second;
@@ -44,6 +49,10 @@ void TimerGL::startGPU(const std::string &name, float timeStamp)
 
     lastIndex = index;
     lastTimeStamp = timeStamp;
+#ifdef SGL_TRACING
+    // GPU regions are shown at the CPU time they were issued at
+    traceStartTimesNS.at(index) = TraceRecorder::get()->getTimeNS();
+#endif
     glBeginQuery(GL_TIME_ELAPSED, queryIDs.at(index));
 }
 
@@ -60,12 +69,19 @@ void TimerGL::startCPU(const std::string &name, float timeStamp)
         numSamples.push_back(0);
         queryHasFinished.push_back(false);
         frameTimeList.clear();
+#ifdef SGL_TRACING
+        traceNames.push_back(TraceRecorder::get()->internString(name));
+        traceStartTimesNS.push_back(0);
+#endif
     } else {
         index = it->second;
     }
 
     lastIndex = index;
     lastTimeStamp = timeStamp;
+#ifdef SGL_TRACING
+    traceStartTimesNS.at(index) = TraceRecorder::get()->getTimeNS();
+#endif
     startTime = std::chrono::system_clock::now();
 }
 
@@ -98,6 +114,10 @@ void TimerGL::addQueryTime(size_t index, float timeStamp)
         numSamples.at(index) += 1;
         queryHasFinished.at(index) = false;
         frameTimeList.push_back(std::make_pair(timeStamp, timer));
+#ifdef SGL_TRACING
+        TraceRecorder::get()->recordCompleteEvent(
+                traceNames.at(index), "TimerGL", traceStartTimesNS.at(index), timer, true);
+#endif
     } else {
         auto endTime = std::chrono::system_clock::now();
         auto elapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
@@ -105,6 +125,10 @@ void TimerGL::addQueryTime(size_t index, float timeStamp)
         elapsedTimeNS.at(index) += timer;
         numSamples.at(index) += 1;
         frameTimeList.push_back(std::make_pair(timeStamp, timer));
+#ifdef SGL_TRACING
+        TraceRecorder::get()->recordCompleteEvent(
+                traceNames.at(index), "TimerGL", traceStartTimesNS.at(index), timer);
+#endif
     };
 }
 
@@ -122,6 +146,10 @@ void TimerGL::deleteAll()
     queryIDs.clear();
     elapsedTimeNS.clear();
     numSamples.clear();
+#ifdef SGL_TRACING
+    traceNames.clear();
+    traceStartTimesNS.clear();
+#endif
 }
 
 
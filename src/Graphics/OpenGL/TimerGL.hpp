@@ -19,7 +19,8 @@ namespace sgl
 // http://www.lighthouse3d.com/tutorials/opengl-timer-query/
 // https://www.khronos.org/opengl/wiki/Query_Object
 
-// NOTE: Does not support nested start-end calls!
+// NOTE: Does not support nested start-end calls! Reading the query results stalls until the GPU has finished.
+// ProfilerGL supports nested regions and never waits for the query results.
 
 /*!
  * TimerGL has functions for profiling OpenGL API calls.
@@ -88,6 +89,12 @@ private:
 
     // CPU timer
     std::chrono::time_point<std::chrono::system_clock> startTime;
+
+    /// Interned region names and the (CPU) start time of the last measurement for the trace recorder.
+    /// Only filled if sgl was built with SGL_TRACING, but always declared so that the class layout doesn't depend on
+    /// the defines of the translation unit including this header.
+    std::vector<const char*> traceNames;
+    std::vector<uint64_t> traceStartTimesNS;
 };
 
 }
@@ -9,6 +9,7 @@
 #define GRAPHICS_RENDERER_HPP_
 
 #include <functional>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <glm/fwd.hpp>
@@ -46,6 +47,14 @@ enum DebugVerbosity {
     DEBUG_OUTPUT_NOTIFICATION_AND_ABOVE = 3
 };
 
+//! Range of indices (or vertices for non-indexed geometry) to render, e.g. the visible meshlets of a submesh.
+struct IndexRange {
+    IndexRange() : firstIndex(0), numIndices(0) {}
+    IndexRange(size_t firstIndex, size_t numIndices) : firstIndex(firstIndex), numIndices(numIndices) {}
+    size_t firstIndex;
+    size_t numIndices;
+};
+
 #ifndef GL_COLOR_BUFFER_BIT
 #define GL_COLOR_BUFFER_BIT 0x00004000
 #define GL_DEPTH_BUFFER_BIT 0x00000100
@@ -96,6 +105,7 @@ public:
     virtual void bindTexture(TexturePtr &tex, unsigned int textureUnit = 0)=0;
     virtual void setBlendMode(BlendMode mode)=0;
     virtual void setModelMatrix(const glm::mat4 &matrix)=0;
+    virtual const glm::mat4 &getModelMatrix()=0;
     virtual void setViewMatrix(const glm::mat4 &matrix)=0;
     virtual void setProjectionMatrix(const glm::mat4 &matrix)=0;
     virtual void setLineWidth(float width)=0;
@@ -113,6 +123,8 @@ public:
     virtual void render(ShaderAttributesPtr &shaderAttributes)=0;
     //! Rendering with overwritten shader (e.g. for multi-pass rendering without calling copy()).
     virtual void render(ShaderAttributesPtr &shaderAttributes, ShaderProgramPtr &passShader)=0;
+    //! Renders only the passed ranges of the index buffer with one draw call (no instancing).
+    virtual void renderIndexRanges(ShaderAttributesPtr &shaderAttributes, const std::vector<IndexRange> &ranges)=0;
 
     //! For debugging purposes
     virtual void setPolygonMode(unsigned int polygonMode)=0;
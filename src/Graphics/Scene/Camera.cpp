@@ -7,14 +7,21 @@
 
 #include "Camera.hpp"
 #include "RenderTarget.hpp"
+#include "CameraCullingKernels.hpp"
 #include <Math/Math.hpp>
 #include <Math/Geometry/MatrixUtil.hpp>
 #include <Math/Geometry/Ray3.hpp>
 #include <Math/Geometry/Plane.hpp>
 #include <Input/Mouse.hpp>
 #include <Utils/AppSettings.hpp>
+#include <Utils/CpuFeatures.hpp>
 #include <Graphics/Window.hpp>
 #include <Graphics/Renderer.hpp>
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace sgl {
 
@@ -206,6 +213,8 @@ void Camera::updateFrustumPlanes() {
 
 Ray3 Camera::getCameraToViewportRay(const glm::vec2 &screenPos)
 {
+    updateCamera();
+
     // Normalized coordinates
     glm::vec2 nc(2.0f * screenPos.x - 1.0f, 1.0f - 2.0f * screenPos.y);
     glm::vec3 nearPoint(nc.x, nc.y, -1.0f), midPoint (nc.x, nc.y, 0.0f);
@@ -253,4 +262,138 @@ bool Camera::isVisible(const glm::vec3 &vert) const {
     return true;
 }
 
+
+//! Batches with at least this many mask words (i.e., 32 objects each) are culled in parallel.
+#define BATCH_CULLING_PARALLEL_MIN_WORDS 512
+
+//! Baseline kernel (SSE2 if enabled for the build), see CameraCullingKernels.hpp.
+static uint32_t cullAABBsWord(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + 4 <= numObjects; i += 4) {
+        const size_t idx = firstObject + i;
+        __m128 boxMin[3] = { _mm_loadu_ps(minX + idx), _mm_loadu_ps(minY + idx), _mm_loadu_ps(minZ + idx) };
+        __m128 boxMax[3] = { _mm_loadu_ps(maxX + idx), _mm_loadu_ps(maxY + idx), _mm_loadu_ps(maxZ + idx) };
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m128 px = planes.a[p] >= 0.0f ? boxMax[0] : boxMin[0];
+            __m128 py = planes.b[p] >= 0.0f ? boxMax[1] : boxMin[1];
+            __m128 pz = planes.c[p] >= 0.0f ? boxMax[2] : boxMin[2];
+            __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), px), _mm_mul_ps(_mm_set1_ps(planes.b[p]), py)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), pz), _mm_set1_ps(planes.d[p])));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        visibilityBits |= uint32_t(_mm_movemask_ps(visible)) << i;
+    }
+#endif
+
+    for (; i < numObjects; i++) {
+        const size_t idx = firstObject + i;
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; p++) {
+            float distance =
+                    planes.a[p] * (planes.a[p] >= 0.0f ? maxX[idx] : minX[idx])
+                    + planes.b[p] * (planes.b[p] >= 0.0f ? maxY[idx] : minY[idx])
+                    + planes.c[p] * (planes.c[p] >= 0.0f ? maxZ[idx] : minZ[idx])
+                    + planes.d[p];
+            visible = distance >= 0.0f;
+        }
+        visibilityBits |= uint32_t(visible) << i;
+    }
+
+    return visibilityBits;
+}
+
+//! Baseline kernel (SSE2 if enabled for the build), see CameraCullingKernels.hpp.
+static uint32_t cullSpheresWord(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + 4 <= numObjects; i += 4) {
+        const size_t idx = firstObject + i;
+        __m128 cx = _mm_loadu_ps(centerX + idx), cy = _mm_loadu_ps(centerY + idx), cz = _mm_loadu_ps(centerZ + idx);
+        __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + idx));
+        __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), cx), _mm_mul_ps(_mm_set1_ps(planes.b[p]), cy)),
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), cz), _mm_set1_ps(planes.d[p])));
+            visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeRadius));
+        }
+        visibilityBits |= uint32_t(_mm_movemask_ps(visible)) << i;
+    }
+#endif
+
+    for (; i < numObjects; i++) {
+        const size_t idx = firstObject + i;
+        bool visible = true;
+        for (int p = 0; p < 6 && visible; p++) {
+            float distance = planes.a[p] * centerX[idx] + planes.b[p] * centerY[idx] + planes.c[p] * centerZ[idx]
+                    + planes.d[p];
+            visible = distance >= -radius[idx];
+        }
+        visibilityBits |= uint32_t(visible) << i;
+    }
+
+    return visibilityBits;
+}
+
+//! The AVX2/AVX-512 kernels are compiled in separate files and selected at runtime depending on the CPU.
+static const KernelTable<CullAABBsWordKernel> cullAABBsWordKernels(
+        cullAABBsWord, nullptr, SGL_AVX2_KERNEL(cullAABBsWordAVX2), SGL_AVX512_KERNEL(cullAABBsWordAVX512));
+static const KernelTable<CullSpheresWordKernel> cullSpheresWordKernels(
+        cullSpheresWord, nullptr, SGL_AVX2_KERNEL(cullSpheresWordAVX2), SGL_AVX512_KERNEL(cullSpheresWordAVX512));
+
+static FrustumPlanesSoA getFrustumPlanesSoA(const Plane *frustumPlanes)
+{
+    FrustumPlanesSoA planes;
+    for (int i = 0; i < 6; i++) {
+        planes.a[i] = frustumPlanes[i].a;
+        planes.b[i] = frustumPlanes[i].b;
+        planes.c[i] = frustumPlanes[i].c;
+        planes.d[i] = frustumPlanes[i].d;
+    }
+    return planes;
+}
+
+void Camera::isVisibleBatch(const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t numObjects, uint32_t *visibilityMask) const
+{
+    const FrustumPlanesSoA planes = getFrustumPlanesSoA(frustumPlanes);
+    const CullAABBsWordKernel cullWord = cullAABBsWordKernels.get();
+    const size_t numWords = (numObjects + 31) / 32;
+    #pragma omp parallel for if(numWords >= BATCH_CULLING_PARALLEL_MIN_WORDS) default(none) \
+            shared(planes, cullWord, minX, minY, minZ, maxX, maxY, maxZ, numObjects, numWords, visibilityMask)
+    for (size_t wordIdx = 0; wordIdx < numWords; wordIdx++) {
+        size_t firstObject = wordIdx * 32;
+        visibilityMask[wordIdx] = cullWord(
+                planes, minX, minY, minZ, maxX, maxY, maxZ, firstObject, std::min(numObjects - firstObject, size_t(32)));
+    }
+}
+
+void Camera::isVisibleBatch(const float *centerX, const float *centerY, const float *centerZ, const float *radius,
+        size_t numObjects, uint32_t *visibilityMask) const
+{
+    const FrustumPlanesSoA planes = getFrustumPlanesSoA(frustumPlanes);
+    const CullSpheresWordKernel cullWord = cullSpheresWordKernels.get();
+    const size_t numWords = (numObjects + 31) / 32;
+    #pragma omp parallel for if(numWords >= BATCH_CULLING_PARALLEL_MIN_WORDS) default(none) \
+            shared(planes, cullWord, centerX, centerY, centerZ, radius, numObjects, numWords, visibilityMask)
+    for (size_t wordIdx = 0; wordIdx < numWords; wordIdx++) {
+        size_t firstObject = wordIdx * 32;
+        visibilityMask[wordIdx] = cullWord(
+                planes, centerX, centerY, centerZ, radius, firstObject, std::min(numObjects - firstObject, size_t(32)));
+    }
+}
+
 }
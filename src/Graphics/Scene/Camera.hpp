@@ -14,6 +14,7 @@
 #include <Math/Geometry/Plane.hpp>
 #include <Math/Geometry/AABB2.hpp>
 #include <Math/Geometry/Sphere.hpp>
+#include <cstdint>
 
 namespace sgl {
 
@@ -82,14 +83,25 @@ public:
     virtual bool isVisible(const glm::vec2 &vert) const;
     virtual bool isVisible(const glm::vec3 &vert) const;
 
+    /*! Batch frustum culling of many bounding volumes passed as structure of arrays. Bit i % 32 of
+     * visibilityMask[i / 32] is set if object i is (potentially) visible, i.e., visibilityMask needs to hold
+     * (numObjects + 31) / 32 words. The tests use SSE2/AVX2/AVX-512 depending on the CPU, and large batches are split
+     * across threads. The results are the same as the ones of calling isVisible for every single object. */
+    void isVisibleBatch(const float *minX, const float *minY, const float *minZ,
+            const float *maxX, const float *maxY, const float *maxZ, size_t numObjects, uint32_t *visibilityMask) const;
+    void isVisibleBatch(const float *centerX, const float *centerY, const float *centerZ, const float *radius,
+            size_t numObjects, uint32_t *visibilityMask) const;
+
     //! AABB of a slice of the view frustum in distance planeDistance
     AABB2 getAABB2(float planeDistance = -1.0f);
     //! Position of the Mouse in the plane with the given distance
     glm::vec2 mousePositionInPlane(float planeDistance = -1.0f);
 
-protected:
-    //! screenPos has to be in relative window coordinates [0,1]x[0,1]
+    /*! World space ray from the camera through the passed point of the viewport (e.g. for picking, see
+     * MeshPicker.hpp). screenPos has to be in relative window coordinates [0,1]x[0,1]. */
     Ray3 getCameraToViewportRay(const glm::vec2 &screenPos);
+
+protected:
     //! Calls updateFrustumPlanes
     void updateCamera();
     void updateFrustumPlanes();
@@ -0,0 +1,56 @@
+/*!
+ * CameraCullingKernels.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_GRAPHICS_SCENE_CAMERACULLINGKERNELS_HPP_
+#define SRC_GRAPHICS_SCENE_CAMERACULLINGKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Internal interface between Camera.cpp and the batch culling kernels compiled with ISA flags
+ * (CameraCulling_AVX2.cpp, CameraCulling_AVX512.cpp). This header must not include glm (see CpuFeatures.hpp).
+ */
+
+namespace sgl {
+
+//! Frustum planes in structure of arrays layout for the batch culling kernels
+struct FrustumPlanesSoA {
+    float a[6], b[6], c[6], d[6];
+};
+
+/*! The kernels cull up to 32 objects starting at firstObject and return their visibility bits.
+ * A box is outside of a plane if the corner farthest along the plane normal (the "p-vertex") is outside. */
+typedef uint32_t (*CullAABBsWordKernel)(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects);
+typedef uint32_t (*CullSpheresWordKernel)(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects);
+
+#ifdef SGL_AVX2_KERNELS
+uint32_t cullAABBsWordAVX2(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects);
+uint32_t cullSpheresWordAVX2(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects);
+#endif
+
+#ifdef SGL_AVX512_KERNELS
+uint32_t cullAABBsWordAVX512(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects);
+uint32_t cullSpheresWordAVX512(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects);
+#endif
+
+}
+
+/*! SRC_GRAPHICS_SCENE_CAMERACULLINGKERNELS_HPP_ */
+#endif
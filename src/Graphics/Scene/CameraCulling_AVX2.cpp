@@ -0,0 +1,85 @@
+/*
+ * CameraCulling_AVX2.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "CameraCullingKernels.hpp"
+
+#if defined(SGL_AVX2_KERNELS) && defined(__AVX2__)
+#include <immintrin.h>
+
+namespace sgl {
+
+/*
+ * The last (partial) group of eight objects is loaded with a masked load, and the bits of the objects past the end
+ * are cleared afterwards. The distances are computed without FMA so that the results match Camera::isVisible.
+ */
+
+//! Mask of the lanes [0, numValid) for _mm256_maskload_ps.
+static inline __m256i getLoadMask(size_t numValid)
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(int(numValid)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+static inline uint32_t getValidBits(size_t numObjects)
+{
+    return numObjects >= 32 ? ~uint32_t(0) : (uint32_t(1) << numObjects) - 1u;
+}
+
+uint32_t cullAABBsWordAVX2(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    for (size_t i = 0; i < numObjects; i += 8) {
+        const size_t idx = firstObject + i;
+        const __m256i mask = getLoadMask(numObjects - i);
+        __m256 boxMin[3] = { _mm256_maskload_ps(minX + idx, mask), _mm256_maskload_ps(minY + idx, mask),
+                _mm256_maskload_ps(minZ + idx, mask) };
+        __m256 boxMax[3] = { _mm256_maskload_ps(maxX + idx, mask), _mm256_maskload_ps(maxY + idx, mask),
+                _mm256_maskload_ps(maxZ + idx, mask) };
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m256 px = planes.a[p] >= 0.0f ? boxMax[0] : boxMin[0];
+            __m256 py = planes.b[p] >= 0.0f ? boxMax[1] : boxMin[1];
+            __m256 pz = planes.c[p] >= 0.0f ? boxMax[2] : boxMin[2];
+            __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.a[p]), px),
+                            _mm256_mul_ps(_mm256_set1_ps(planes.b[p]), py)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.c[p]), pz), _mm256_set1_ps(planes.d[p])));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        visibilityBits |= uint32_t(_mm256_movemask_ps(visible)) << i;
+    }
+    return visibilityBits & getValidBits(numObjects);
+}
+
+uint32_t cullSpheresWordAVX2(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    for (size_t i = 0; i < numObjects; i += 8) {
+        const size_t idx = firstObject + i;
+        const __m256i mask = getLoadMask(numObjects - i);
+        __m256 cx = _mm256_maskload_ps(centerX + idx, mask), cy = _mm256_maskload_ps(centerY + idx, mask);
+        __m256 cz = _mm256_maskload_ps(centerZ + idx, mask);
+        __m256 negativeRadius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_maskload_ps(radius + idx, mask));
+        __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.a[p]), cx),
+                            _mm256_mul_ps(_mm256_set1_ps(planes.b[p]), cy)),
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.c[p]), cz), _mm256_set1_ps(planes.d[p])));
+            visible = _mm256_and_ps(visible, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+        }
+        visibilityBits |= uint32_t(_mm256_movemask_ps(visible)) << i;
+    }
+    return visibilityBits & getValidBits(numObjects);
+}
+
+}
+
+#endif
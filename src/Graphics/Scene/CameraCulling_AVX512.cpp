@@ -0,0 +1,79 @@
+/*
+ * CameraCulling_AVX512.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "CameraCullingKernels.hpp"
+
+#if defined(SGL_AVX512_KERNELS) && defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace sgl {
+
+/*
+ * Two groups of 16 objects per word. The compare masks are the visibility bits, and masked loads handle the last
+ * (partial) group. The distances are computed without FMA so that the results match Camera::isVisible.
+ */
+
+static inline __mmask16 getLoadMask(size_t numValid)
+{
+    return numValid >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << numValid) - 1u);
+}
+
+uint32_t cullAABBsWordAVX512(
+        const FrustumPlanesSoA &planes, const float *minX, const float *minY, const float *minZ,
+        const float *maxX, const float *maxY, const float *maxZ, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    for (size_t i = 0; i < numObjects; i += 16) {
+        const size_t idx = firstObject + i;
+        const __mmask16 mask = getLoadMask(numObjects - i);
+        __m512 boxMin[3] = { _mm512_maskz_loadu_ps(mask, minX + idx), _mm512_maskz_loadu_ps(mask, minY + idx),
+                _mm512_maskz_loadu_ps(mask, minZ + idx) };
+        __m512 boxMax[3] = { _mm512_maskz_loadu_ps(mask, maxX + idx), _mm512_maskz_loadu_ps(mask, maxY + idx),
+                _mm512_maskz_loadu_ps(mask, maxZ + idx) };
+        __mmask16 visible = mask;
+        for (int p = 0; p < 6; p++) {
+            __m512 px = planes.a[p] >= 0.0f ? boxMax[0] : boxMin[0];
+            __m512 py = planes.b[p] >= 0.0f ? boxMax[1] : boxMin[1];
+            __m512 pz = planes.c[p] >= 0.0f ? boxMax[2] : boxMin[2];
+            __m512 distance = _mm512_add_ps(
+                    _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.a[p]), px),
+                            _mm512_mul_ps(_mm512_set1_ps(planes.b[p]), py)),
+                    _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.c[p]), pz), _mm512_set1_ps(planes.d[p])));
+            visible = _mm512_mask_cmp_ps_mask(visible, distance, _mm512_setzero_ps(), _CMP_GE_OQ);
+        }
+        visibilityBits |= uint32_t(visible) << i;
+    }
+    return visibilityBits;
+}
+
+uint32_t cullSpheresWordAVX512(
+        const FrustumPlanesSoA &planes, const float *centerX, const float *centerY, const float *centerZ,
+        const float *radius, size_t firstObject, size_t numObjects)
+{
+    uint32_t visibilityBits = 0;
+    for (size_t i = 0; i < numObjects; i += 16) {
+        const size_t idx = firstObject + i;
+        const __mmask16 mask = getLoadMask(numObjects - i);
+        __m512 cx = _mm512_maskz_loadu_ps(mask, centerX + idx), cy = _mm512_maskz_loadu_ps(mask, centerY + idx);
+        __m512 cz = _mm512_maskz_loadu_ps(mask, centerZ + idx);
+        __m512 negativeRadius = _mm512_sub_ps(_mm512_setzero_ps(), _mm512_maskz_loadu_ps(mask, radius + idx));
+        __mmask16 visible = mask;
+        for (int p = 0; p < 6; p++) {
+            __m512 distance = _mm512_add_ps(
+                    _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.a[p]), cx),
+                            _mm512_mul_ps(_mm512_set1_ps(planes.b[p]), cy)),
+                    _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.c[p]), cz), _mm512_set1_ps(planes.d[p])));
+            visible = _mm512_mask_cmp_ps_mask(visible, distance, negativeRadius, _CMP_GE_OQ);
+        }
+        visibilityBits |= uint32_t(visible) << i;
+    }
+    return visibilityBits;
+}
+
+}
+
+#endif
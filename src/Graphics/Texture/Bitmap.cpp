@@ -7,6 +7,7 @@
 
 #include "Bitmap.hpp"
 #include <Math/Math.hpp>
+#include <Utils/MemoryTracker.hpp>
 #include <Math/Geometry/Rectangle.hpp>
 #include <Math/Geometry/Point2.hpp>
 #include <cstring>
@@ -23,7 +24,7 @@ void Bitmap::allocate(int width, int height, int _bpp /* = 32 */) {
     w = width;
     h = height;
     bpp = _bpp;
-    bitmap = new uint8_t[width * height * bpp / 8];
+    bitmap = newTrackedArray<uint8_t>(width * height * bpp / 8, MEMORY_TAG_BITMAP);
 }
 
 void Bitmap::fill(const Color &color) {
@@ -49,7 +50,7 @@ void Bitmap::fromMemory(void *data, int width, int height, int _bpp /* = 32 */)
     w = width;
     h = height;
     bpp = _bpp;
-    bitmap = new uint8_t[w * h * bpp / 8];
+    bitmap = newTrackedArray<uint8_t>(w * h * bpp / 8, MEMORY_TAG_BITMAP);
     std::memcpy(bitmap, data, w * h * bpp / 8);
 
 }
@@ -291,7 +292,7 @@ void Bitmap::fromFile(const char *filename) {
     int rowbytes = png_get_rowbytes(png_ptr, info_ptr);
 
     // Allocate the imageData as a big block
-    uint8_t *dataPointer = new uint8_t[rowbytes * tempHeight];
+    uint8_t *dataPointer = newTrackedArray<uint8_t>(rowbytes * tempHeight, MEMORY_TAG_BITMAP);
     png_byte *imageData = (png_byte*) dataPointer;
     if (imageData == NULL) {
         std::cerr << "ERROR: Bitmap::fromFile: Could not allocate memory for PNG image data." << std::endl;
@@ -305,7 +306,7 @@ void Bitmap::fromFile(const char *filename) {
     if (rowPointers == NULL) {
         std::cerr << "ERROR: Bitmap::fromFile: Could not allocate memory for PNG row pointers." << std::endl;
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
-        free(imageData);
+        deleteTrackedArray(dataPointer);
         fclose(fp);
         return;
     }
@@ -327,14 +328,14 @@ void Bitmap::fromFile(const char *filename) {
         bitmap = dataPointer;
     } else {
         // Convert to RGBA
-        bitmap = new uint8_t[w*h*4];
+        bitmap = newTrackedArray<uint8_t>(w*h*4, MEMORY_TAG_BITMAP);
         for (int i = 0; i < w*h; i++) {
             bitmap[i*4+0] = dataPointer[i*3+0];
             bitmap[i*4+1] = dataPointer[i*3+1];
             bitmap[i*4+2] = dataPointer[i*3+2];
             bitmap[i*4+3] = 255;
         }
-        delete[] dataPointer;
+        deleteTrackedArray(dataPointer);
     }
 }
 
@@ -393,7 +394,7 @@ bool Bitmap::savePNG(const char *filename, bool mirror /* = false */) {
 
 void Bitmap::freeData() {
     if (bitmap != NULL) {
-        delete[] bitmap;
+        deleteTrackedArray(bitmap);
         bitmap = NULL;
     }
 }
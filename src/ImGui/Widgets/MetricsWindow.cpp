@@ -0,0 +1,92 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <ImGui/ImGuiWrapper.hpp>
+#include <ImGui/imgui_stdlib.h>
+
+#include "MetricsWindow.hpp"
+
+namespace sgl {
+
+void MetricsWindow::renderGui() {
+    if (!showWindow) {
+        return;
+    }
+
+    double currentTime = ImGui::GetTime();
+    if (lastUpdateTime < 0.0 || currentTime - lastUpdateTime >= UPDATE_INTERVAL_SECONDS) {
+        snapshots = MetricsRegistry::get()->getSnapshot();
+        lastUpdateTime = currentTime;
+    }
+
+    if (ImGui::Begin("Metrics", &showWindow)) {
+        ImGui::InputText("Filter", &filter);
+        ImGui::SameLine();
+        if (ImGui::Button("Copy as Text")) {
+            ImGui::SetClipboardText(MetricsRegistry::get()->getText().c_str());
+        }
+
+        ImGui::Columns(3, "MetricsColumns");
+        ImGui::Separator();
+        ImGui::Text("Name"); ImGui::NextColumn();
+        ImGui::Text("Type"); ImGui::NextColumn();
+        ImGui::Text("Value"); ImGui::NextColumn();
+        ImGui::Separator();
+        for (const MetricSnapshot& snapshot : snapshots) {
+            if (!filter.empty() && snapshot.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            ImGui::Text("%s", snapshot.name.c_str());
+            if (!snapshot.description.empty() && ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("%s", snapshot.description.c_str());
+            }
+            ImGui::NextColumn();
+            if (snapshot.type == METRIC_COUNTER) {
+                ImGui::Text("counter"); ImGui::NextColumn();
+                ImGui::Text("%llu", (unsigned long long)snapshot.value); ImGui::NextColumn();
+            } else if (snapshot.type == METRIC_GAUGE) {
+                ImGui::Text("gauge"); ImGui::NextColumn();
+                ImGui::Text("%lld", (long long)snapshot.value); ImGui::NextColumn();
+            } else {
+                const MetricHistogramSnapshot& histogram = snapshot.histogram;
+                ImGui::Text("histogram"); ImGui::NextColumn();
+                ImGui::Text(
+                        "n=%llu mean=%.1f p50=%.1f p95=%.1f p99=%.1f max=%llu",
+                        (unsigned long long)histogram.count, histogram.getMean(), histogram.getPercentile(50.0),
+                        histogram.getPercentile(95.0), histogram.getPercentile(99.0),
+                        (unsigned long long)histogram.max);
+                ImGui::NextColumn();
+            }
+        }
+        ImGui::Columns(1);
+        ImGui::Separator();
+    }
+    ImGui::End();
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * BSD 2-Clause License
+ *
+ * Copyright (c) 2026, Christoph Neuhauser
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SGL_METRICSWINDOW_HPP
+#define SGL_METRICSWINDOW_HPP
+
+#include <string>
+#include <vector>
+
+#include <Utils/Metrics.hpp>
+
+namespace sgl {
+
+/**
+ * Shows the counters, gauges and histograms of sgl::MetricsRegistry in a table.
+ */
+class MetricsWindow {
+public:
+    void renderGui();
+
+    inline bool getShowWindow() const { return showWindow; }
+    inline void setShowWindow(bool show) { showWindow = show; }
+
+private:
+    bool showWindow = false;
+    std::string filter;
+    /// The snapshot is only updated every UPDATE_INTERVAL_SECONDS to keep the values readable.
+    const double UPDATE_INTERVAL_SECONDS = 0.5;
+    double lastUpdateTime = -1.0;
+    std::vector<MetricSnapshot> snapshots;
+};
+
+}
+
+#endif //SGL_METRICSWINDOW_HPP
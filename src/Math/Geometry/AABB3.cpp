@@ -7,10 +7,92 @@
 
 
 #include "AABB3.hpp"
+#include <vector>
+#include <algorithm>
+#include <cmath>
 #include <Math/Geometry/MatrixUtil.hpp>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace sgl {
 
+//! Arrays smaller than this are reduced on one thread, larger arrays are split into chunks of this size.
+#define AABB3_PARALLEL_CHUNK_SIZE (size_t(1) << 16)
+
+static AABB3 computePointsAABB(const glm::vec3 *points, size_t numPoints, size_t pointStride)
+{
+    AABB3 aabb;
+    const uint8_t *pointBytes = reinterpret_cast<const uint8_t*>(points);
+    size_t i = 0;
+
+#ifdef __SSE2__
+    if (pointStride == sizeof(glm::vec3) && numPoints >= 4) {
+        /*
+         * Four consecutive points are loaded as a = (x0 y0 z0 x1), b = (y1 z1 x2 y2), c = (z2 x3 y3 z3).
+         * The lanes of the running minima/maxima follow the same pattern and are merged at the end.
+         */
+        const float *floatData = &points->x;
+        __m128 minA = _mm_set1_ps(FLT_MAX), minB = minA, minC = minA;
+        __m128 maxA = _mm_set1_ps(-FLT_MAX), maxB = maxA, maxC = maxA;
+        for (; i + 4 <= numPoints; i += 4) {
+            __m128 a = _mm_loadu_ps(floatData + i * 3);
+            __m128 b = _mm_loadu_ps(floatData + i * 3 + 4);
+            __m128 c = _mm_loadu_ps(floatData + i * 3 + 8);
+            minA = _mm_min_ps(minA, a); minB = _mm_min_ps(minB, b); minC = _mm_min_ps(minC, c);
+            maxA = _mm_max_ps(maxA, a); maxB = _mm_max_ps(maxB, b); maxC = _mm_max_ps(maxC, c);
+        }
+        float minValues[12], maxValues[12];
+        _mm_storeu_ps(minValues, minA); _mm_storeu_ps(minValues + 4, minB); _mm_storeu_ps(minValues + 8, minC);
+        _mm_storeu_ps(maxValues, maxA); _mm_storeu_ps(maxValues + 4, maxB); _mm_storeu_ps(maxValues + 8, maxC);
+        for (int j = 0; j < 4; ++j) {
+            aabb.combine(glm::vec3(minValues[j * 3], minValues[j * 3 + 1], minValues[j * 3 + 2]));
+            aabb.combine(glm::vec3(maxValues[j * 3], maxValues[j * 3 + 1], maxValues[j * 3 + 2]));
+        }
+    }
+#endif
+
+    glm::vec3 minPoint = aabb.min, maxPoint = aabb.max;
+    for (; i < numPoints; ++i) {
+        const glm::vec3 &pt = *reinterpret_cast<const glm::vec3*>(pointBytes + i * pointStride);
+        minPoint = glm::min(minPoint, pt);
+        maxPoint = glm::max(maxPoint, pt);
+    }
+    return AABB3(minPoint, maxPoint);
+}
+
+static AABB3 computePointsAABB(const float *x, const float *y, const float *z, size_t numPoints)
+{
+    glm::vec3 minPoint(FLT_MAX), maxPoint(-FLT_MAX);
+    size_t i = 0;
+
+#ifdef __SSE2__
+    if (numPoints >= 4) {
+        __m128 minX = _mm_set1_ps(FLT_MAX), minY = minX, minZ = minX;
+        __m128 maxX = _mm_set1_ps(-FLT_MAX), maxY = maxX, maxZ = maxX;
+        for (; i + 4 <= numPoints; i += 4) {
+            __m128 vx = _mm_loadu_ps(x + i), vy = _mm_loadu_ps(y + i), vz = _mm_loadu_ps(z + i);
+            minX = _mm_min_ps(minX, vx); minY = _mm_min_ps(minY, vy); minZ = _mm_min_ps(minZ, vz);
+            maxX = _mm_max_ps(maxX, vx); maxY = _mm_max_ps(maxY, vy); maxZ = _mm_max_ps(maxZ, vz);
+        }
+        float lanes[6][4];
+        _mm_storeu_ps(lanes[0], minX); _mm_storeu_ps(lanes[1], minY); _mm_storeu_ps(lanes[2], minZ);
+        _mm_storeu_ps(lanes[3], maxX); _mm_storeu_ps(lanes[4], maxY); _mm_storeu_ps(lanes[5], maxZ);
+        for (int j = 0; j < 4; ++j) {
+            minPoint = glm::min(minPoint, glm::vec3(lanes[0][j], lanes[1][j], lanes[2][j]));
+            maxPoint = glm::max(maxPoint, glm::vec3(lanes[3][j], lanes[4][j], lanes[5][j]));
+        }
+    }
+#endif
+
+    for (; i < numPoints; ++i) {
+        minPoint = glm::min(minPoint, glm::vec3(x[i], y[i], z[i]));
+        maxPoint = glm::max(maxPoint, glm::vec3(x[i], y[i], z[i]));
+    }
+    return AABB3(minPoint, maxPoint);
+}
+
 void AABB3::combine(const AABB3 &otherAABB)
 {
     if (otherAABB.min.x < min.x)
@@ -45,8 +127,71 @@ void AABB3::combine(const glm::vec3 &pt)
         max.z = pt.z;
 }
 
+void AABB3::combine(const glm::vec3 *points, size_t numPoints, size_t pointStride)
+{
+    if (numPoints <= AABB3_PARALLEL_CHUNK_SIZE) {
+        combine(computePointsAABB(points, numPoints, pointStride));
+        return;
+    }
+
+    const uint8_t *pointBytes = reinterpret_cast<const uint8_t*>(points);
+    const size_t numChunks = (numPoints - 1) / AABB3_PARALLEL_CHUNK_SIZE + 1;
+    std::vector<AABB3> chunkAABBs(numChunks);
+    #pragma omp parallel for shared(chunkAABBs, pointBytes, numPoints, pointStride, numChunks) default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t firstPoint = chunkIdx * AABB3_PARALLEL_CHUNK_SIZE;
+        size_t numChunkPoints = std::min(AABB3_PARALLEL_CHUNK_SIZE, numPoints - firstPoint);
+        chunkAABBs.at(chunkIdx) = computePointsAABB(
+                reinterpret_cast<const glm::vec3*>(pointBytes + firstPoint * pointStride),
+                numChunkPoints, pointStride);
+    }
+    for (const AABB3 &chunkAABB : chunkAABBs) {
+        combine(chunkAABB);
+    }
+}
+
+void AABB3::combine(const float *x, const float *y, const float *z, size_t numPoints)
+{
+    if (numPoints <= AABB3_PARALLEL_CHUNK_SIZE) {
+        combine(computePointsAABB(x, y, z, numPoints));
+        return;
+    }
+
+    const size_t numChunks = (numPoints - 1) / AABB3_PARALLEL_CHUNK_SIZE + 1;
+    std::vector<AABB3> chunkAABBs(numChunks);
+    #pragma omp parallel for shared(chunkAABBs, x, y, z, numPoints, numChunks) default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t firstPoint = chunkIdx * AABB3_PARALLEL_CHUNK_SIZE;
+        size_t numChunkPoints = std::min(AABB3_PARALLEL_CHUNK_SIZE, numPoints - firstPoint);
+        chunkAABBs.at(chunkIdx) = computePointsAABB(
+                x + firstPoint, y + firstPoint, z + firstPoint, numChunkPoints);
+    }
+    for (const AABB3 &chunkAABB : chunkAABBs) {
+        combine(chunkAABB);
+    }
+}
+
 AABB3 AABB3::transformed(const glm::mat4 &matrix) const
 {
+    if (min.x > max.x || min.y > max.y || min.z > max.z) {
+        return AABB3();
+    }
+
+    if (matrix[0][3] == 0.0f && matrix[1][3] == 0.0f && matrix[2][3] == 0.0f && matrix[3][3] == 1.0f) {
+        // Affine transformation: The extent of the transformed box along every axis is the sum of the absolute
+        // values of the rotated and scaled extent vectors, so no corners need to be transformed.
+        glm::vec3 center = getCenter(), extent = getExtent();
+        glm::vec3 transformedCenter, transformedExtent;
+        for (int i = 0; i < 3; i++) {
+            transformedCenter[i] = matrix[0][i] * center.x + matrix[1][i] * center.y + matrix[2][i] * center.z
+                    + matrix[3][i];
+            transformedExtent[i] = std::abs(matrix[0][i]) * extent.x + std::abs(matrix[1][i]) * extent.y
+                    + std::abs(matrix[2][i]) * extent.z;
+        }
+        return AABB3(transformedCenter - transformedExtent, transformedCenter + transformedExtent);
+    }
+
+    // Projective transformation: Transform the eight corners
     glm::vec3 transformedCorners[8];
     transformedCorners[0] = transformPoint(matrix, glm::vec3(min.x, min.y, min.z));
     transformedCorners[1] = transformPoint(matrix, glm::vec3(min.x, min.y, max.z));
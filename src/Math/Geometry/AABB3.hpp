@@ -31,6 +31,11 @@ public:
     void combine(const AABB3 &otherAABB);
     //! Merge AABB with a point
     void combine(const glm::vec3 &pt);
+    /*! Merge AABB with an array of points using a SIMD min/max reduction (parallelized with OpenMP for large arrays).
+     * \param pointStride is the offset in byte between two points (e.g. sizeof(VertexTextured) for vertex data). */
+    void combine(const glm::vec3 *points, size_t numPoints, size_t pointStride = sizeof(glm::vec3));
+    //! Merge AABB with an array of points stored in structure of arrays layout.
+    void combine(const float *x, const float *y, const float *z, size_t numPoints);
     //! Transform AABB
     AABB3 transformed(const glm::mat4 &matrix) const;
 };
@@ -0,0 +1,466 @@
+/*
+ * BVH.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "BVH.hpp"
+#include <memory>
+#include <Utils/File/Logfile.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sgl {
+
+//! Subtrees with at least this many primitives are built in a separate OpenMP task.
+#define BVH_PARALLEL_BUILD_MIN_PRIMITIVES 4096
+//! Maximum number of bins for the SAH evaluation.
+#define BVH_MAX_BINS 64
+//! Leaves may be bigger than maxLeafSize up to this size if the SAH estimates that splitting doesn't pay off.
+#define BVH_MAX_SAH_LEAF_SIZE 16
+//! Below this depth, only median splits are made, which bounds the depth of the tree by this depth + log2(n).
+#define BVH_MEDIAN_SPLIT_DEPTH 64
+
+struct BVHBuildNode {
+    AABB3 aabb;
+    uint32_t firstPrimitive = 0;
+    uint32_t numPrimitives = 0;
+    uint8_t splitAxis = 0;
+    std::unique_ptr<BVHBuildNode> children[2];
+};
+
+//! Primitive reference used during the build. The array of references is partitioned in place (32 bytes each).
+struct BVHBuildPrimitive {
+    glm::vec3 min;
+    uint32_t index;
+    glm::vec3 max;
+    float padding;
+
+    inline float getCentroid(int axis) const { return (min[axis] + max[axis]) * 0.5f; }
+};
+
+struct BVHBuildContext {
+    BVHBuildPrimitive *primitives;
+    size_t maxLeafSize;
+    size_t numBins;
+};
+
+//! Bounds used during the build. Uses SSE2 if available, as updating the bins dominates the build time.
+struct BVHBinBounds {
+#ifdef __SSE2__
+    BVHBinBounds() : min(_mm_set1_ps(FLT_MAX)), max(_mm_set1_ps(-FLT_MAX)) {}
+    /*! The fourth lane of the loads contains the index of the primitive. It is cleared, as the index bits would be
+     * interpreted as a denormal float, which makes arithmetic operations very slow on many CPUs. */
+    static inline __m128 loadVec3(const glm::vec3 &v) {
+        return _mm_and_ps(_mm_loadu_ps(&v.x), _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+    }
+    inline void combine(const BVHBuildPrimitive &primitive) {
+        min = _mm_min_ps(min, loadVec3(primitive.min));
+        max = _mm_max_ps(max, loadVec3(primitive.max));
+    }
+    inline void combineCentroid(const BVHBuildPrimitive &primitive) {
+        __m128 centroid = _mm_mul_ps(
+                _mm_add_ps(loadVec3(primitive.min), loadVec3(primitive.max)), _mm_set1_ps(0.5f));
+        min = _mm_min_ps(min, centroid);
+        max = _mm_max_ps(max, centroid);
+    }
+    inline void combine(const BVHBinBounds &other) {
+        min = _mm_min_ps(min, other.min);
+        max = _mm_max_ps(max, other.max);
+    }
+    inline glm::vec3 getMin() const { float v[4]; _mm_storeu_ps(v, min); return glm::vec3(v[0], v[1], v[2]); }
+    inline glm::vec3 getMax() const { float v[4]; _mm_storeu_ps(v, max); return glm::vec3(v[0], v[1], v[2]); }
+    __m128 min, max;
+#else
+    BVHBinBounds() : min(FLT_MAX), max(-FLT_MAX) {}
+    inline void combine(const BVHBuildPrimitive &primitive) {
+        min = glm::min(min, primitive.min);
+        max = glm::max(max, primitive.max);
+    }
+    inline void combineCentroid(const BVHBuildPrimitive &primitive) {
+        glm::vec3 centroid = (primitive.min + primitive.max) * 0.5f;
+        min = glm::min(min, centroid);
+        max = glm::max(max, centroid);
+    }
+    inline void combine(const BVHBinBounds &other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    inline glm::vec3 getMin() const { return min; }
+    inline glm::vec3 getMax() const { return max; }
+    glm::vec3 min, max;
+#endif
+
+    inline float getSurfaceArea() const {
+        glm::vec3 dimensions = getMax() - getMin();
+        return 2.0f * (dimensions.x * dimensions.y + dimensions.y * dimensions.z + dimensions.z * dimensions.x);
+    }
+};
+
+static void splitAtMedian(BVHBuildPrimitive *primitives, size_t begin, size_t mid, size_t end, int axis)
+{
+    std::nth_element(primitives + begin, primitives + mid, primitives + end,
+            [axis](const BVHBuildPrimitive &p0, const BVHBuildPrimitive &p1) {
+                return p0.getCentroid(axis) < p1.getCentroid(axis);
+            });
+}
+
+static void buildRecursive(const BVHBuildContext *context, BVHBuildNode *node, size_t begin, size_t end, int depth)
+{
+    BVHBuildPrimitive *primitives = context->primitives;
+    const size_t numPrimitives = end - begin;
+    BVHBinBounds nodeBounds, centroidBounds;
+    for (size_t i = begin; i < end; i++) {
+        nodeBounds.combine(primitives[i]);
+        centroidBounds.combineCentroid(primitives[i]);
+    }
+    node->aabb = AABB3(nodeBounds.getMin(), nodeBounds.getMax());
+    node->firstPrimitive = uint32_t(begin);
+    node->numPrimitives = uint32_t(numPrimitives);
+    if (numPrimitives <= context->maxLeafSize) {
+        return;
+    }
+
+    const glm::vec3 centroidMin = centroidBounds.getMin();
+    const glm::vec3 centroidExtent = centroidBounds.getMax() - centroidMin;
+    int largestAxis = 0;
+    if (centroidExtent[1] > centroidExtent[largestAxis]) largestAxis = 1;
+    if (centroidExtent[2] > centroidExtent[largestAxis]) largestAxis = 2;
+
+    size_t mid = begin + numPrimitives / 2;
+    int splitAxis = largestAxis;
+    if (centroidExtent[largestAxis] <= 0.0f || depth >= BVH_MEDIAN_SPLIT_DEPTH) {
+        // All centroids coincide or the tree got too deep; split in the middle (object median).
+        splitAtMedian(primitives, begin, mid, end, largestAxis);
+    } else {
+        // Binned SAH: Bin the primitives along all three axes in one pass, then evaluate the split planes
+        // Small nodes use fewer bins, as evaluating the bins would dominate their build time otherwise.
+        const int numBins = int(std::min(context->numBins, std::max(numPrimitives / 4, size_t(4))));
+        BVHBinBounds binBounds[3][BVH_MAX_BINS];
+        uint32_t binCounts[3][BVH_MAX_BINS] = {};
+        glm::vec3 binScale;
+        for (int axis = 0; axis < 3; axis++) {
+            binScale[axis] = centroidExtent[axis] > 0.0f ? float(numBins) / centroidExtent[axis] : 0.0f;
+        }
+        for (size_t i = begin; i < end; i++) {
+            const BVHBuildPrimitive &primitive = primitives[i];
+            for (int axis = 0; axis < 3; axis++) {
+                int binIdx = std::min(numBins - 1,
+                        int((primitive.getCentroid(axis) - centroidMin[axis]) * binScale[axis]));
+                binCounts[axis][binIdx]++;
+                binBounds[axis][binIdx].combine(primitive);
+            }
+        }
+
+        float bestCost = FLT_MAX;
+        int bestBin = -1;
+        for (int axis = 0; axis < 3; axis++) {
+            if (centroidExtent[axis] <= 0.0f) {
+                continue;
+            }
+            // Sweep from the right to get the costs of the right sides, then from the left
+            float rightAreas[BVH_MAX_BINS];
+            uint32_t rightCounts[BVH_MAX_BINS];
+            BVHBinBounds rightBounds;
+            uint32_t rightCount = 0;
+            for (int binIdx = numBins - 1; binIdx > 0; binIdx--) {
+                rightBounds.combine(binBounds[axis][binIdx]);
+                rightCount += binCounts[axis][binIdx];
+                rightAreas[binIdx] = rightCount > 0 ? rightBounds.getSurfaceArea() : 0.0f;
+                rightCounts[binIdx] = rightCount;
+            }
+            BVHBinBounds leftBounds;
+            uint32_t leftCount = 0;
+            for (int binIdx = 0; binIdx < numBins - 1; binIdx++) {
+                leftBounds.combine(binBounds[axis][binIdx]);
+                leftCount += binCounts[axis][binIdx];
+                if (leftCount == 0 || rightCounts[binIdx + 1] == 0) {
+                    continue;
+                }
+                float cost = leftBounds.getSurfaceArea() * leftCount + rightAreas[binIdx + 1] * rightCounts[binIdx + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBin = binIdx;
+                    splitAxis = axis;
+                }
+            }
+        }
+
+        // Compare with the cost of a leaf (traversal cost 1, intersection cost 1 per primitive)
+        float nodeArea = nodeBounds.getSurfaceArea();
+        bool isLeafCheaper = bestBin < 0 || (nodeArea > 0.0f && 1.0f + bestCost / nodeArea >= float(numPrimitives));
+        if (isLeafCheaper && numPrimitives <= BVH_MAX_SAH_LEAF_SIZE) {
+            return;
+        }
+
+        if (bestBin >= 0) {
+            const float axisScale = binScale[splitAxis];
+            const float axisMin = centroidMin[splitAxis];
+            BVHBuildPrimitive *midPtr = std::partition(primitives + begin, primitives + end,
+                    [splitAxis, axisScale, axisMin, numBins, bestBin](const BVHBuildPrimitive &primitive) {
+                        return std::min(numBins - 1, int((primitive.getCentroid(splitAxis) - axisMin) * axisScale))
+                                <= bestBin;
+                    });
+            mid = size_t(midPtr - primitives);
+        }
+        if (bestBin < 0 || mid == begin || mid == end) {
+            mid = begin + numPrimitives / 2;
+            splitAxis = largestAxis;
+            splitAtMedian(primitives, begin, mid, end, largestAxis);
+        }
+    }
+
+    node->numPrimitives = 0;
+    node->splitAxis = uint8_t(splitAxis);
+    node->children[0].reset(new BVHBuildNode);
+    node->children[1].reset(new BVHBuildNode);
+    BVHBuildNode *leftChild = node->children[0].get();
+    BVHBuildNode *rightChild = node->children[1].get();
+
+    // Creating tasks (even undeferred ones) is expensive, so only large subtrees get their own task
+    if (numPrimitives >= BVH_PARALLEL_BUILD_MIN_PRIMITIVES) {
+        #pragma omp task default(none) firstprivate(context, leftChild, begin, mid, depth)
+        buildRecursive(context, leftChild, begin, mid, depth + 1);
+        buildRecursive(context, rightChild, mid, end, depth + 1);
+        #pragma omp taskwait
+    } else {
+        buildRecursive(context, leftChild, begin, mid, depth + 1);
+        buildRecursive(context, rightChild, mid, end, depth + 1);
+    }
+}
+
+static void flattenRecursive(const BVHBuildNode *buildNode, std::vector<BVHNode> &nodes)
+{
+    size_t nodeIdx = nodes.size();
+    nodes.push_back(BVHNode());
+    BVHNode &node = nodes.back();
+    for (int i = 0; i < 3; i++) {
+        node.aabbMin[i] = buildNode->aabb.min[i];
+        node.aabbMax[i] = buildNode->aabb.max[i];
+    }
+    node.splitAxis = buildNode->splitAxis;
+    node.padding = 0;
+    if (buildNode->numPrimitives > 0) {
+        node.offset = buildNode->firstPrimitive;
+        node.numPrimitives = uint16_t(buildNode->numPrimitives);
+        return;
+    }
+    node.numPrimitives = 0;
+    flattenRecursive(buildNode->children[0].get(), nodes);
+    uint32_t rightChildIdx = uint32_t(nodes.size());
+    nodes.at(nodeIdx).offset = rightChildIdx;
+    flattenRecursive(buildNode->children[1].get(), nodes);
+}
+
+static void countNodesRecursive(const BVHBuildNode *buildNode, size_t &numNodes)
+{
+    numNodes++;
+    if (buildNode->numPrimitives == 0) {
+        countNodesRecursive(buildNode->children[0].get(), numNodes);
+        countNodesRecursive(buildNode->children[1].get(), numNodes);
+    }
+}
+
+BVH::BVH(size_t maxLeafSize, size_t numBins)
+        : maxLeafSize(std::max(std::min(maxLeafSize, size_t(BVH_MAX_SAH_LEAF_SIZE)), size_t(1))),
+          numBins(std::max(std::min(numBins, size_t(BVH_MAX_BINS)), size_t(2)))
+{
+}
+
+void BVH::build(const AABB3 *aabbs, size_t numPrimitives)
+{
+    nodes.clear();
+    primitiveIndices.clear();
+    primitiveAABBs.assign(aabbs, aabbs + numPrimitives);
+    if (numPrimitives == 0) {
+        return;
+    }
+    if (numPrimitives >= size_t(UINT32_MAX)) {
+        Logfile::get()->writeError("BVH::build: Too many primitives!");
+        primitiveAABBs.clear();
+        return;
+    }
+
+    std::vector<BVHBuildPrimitive> buildPrimitives(numPrimitives);
+    #pragma omp parallel for shared(buildPrimitives, aabbs, numPrimitives) default(none)
+    for (size_t i = 0; i < numPrimitives; i++) {
+        buildPrimitives[i].min = aabbs[i].min;
+        buildPrimitives[i].max = aabbs[i].max;
+        buildPrimitives[i].index = uint32_t(i);
+        buildPrimitives[i].padding = 0.0f;
+    }
+
+    BVHBuildContext context;
+    context.primitives = &buildPrimitives.front();
+    context.maxLeafSize = maxLeafSize;
+    context.numBins = numBins;
+    BVHBuildNode root;
+    BVHBuildNode *rootPtr = &root;
+    const BVHBuildContext *contextPtr = &context;
+    #pragma omp parallel shared(contextPtr, rootPtr, numPrimitives) default(none)
+    {
+        #pragma omp single
+        buildRecursive(contextPtr, rootPtr, 0, numPrimitives, 0);
+    }
+
+    primitiveIndices.resize(numPrimitives);
+    for (size_t i = 0; i < numPrimitives; i++) {
+        primitiveIndices[i] = buildPrimitives[i].index;
+    }
+
+    size_t numNodes = 0;
+    countNodesRecursive(&root, numNodes);
+    nodes.reserve(numNodes);
+    flattenRecursive(&root, nodes);
+}
+
+void BVH::refit(const AABB3 *aabbs)
+{
+    primitiveAABBs.assign(aabbs, aabbs + primitiveAABBs.size());
+
+    // Children are always stored after their parents, so a reverse sweep updates the tree bottom-up.
+    for (size_t nodeIdx = nodes.size(); nodeIdx-- > 0; ) {
+        BVHNode &node = nodes[nodeIdx];
+        AABB3 aabb;
+        if (node.isLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.numPrimitives; i++) {
+                aabb.combine(primitiveAABBs[primitiveIndices[i]]);
+            }
+        } else {
+            aabb = getNodeAABB(nodes[nodeIdx + 1]);
+            aabb.combine(getNodeAABB(nodes[node.offset]));
+        }
+        for (int i = 0; i < 3; i++) {
+            node.aabbMin[i] = aabb.min[i];
+            node.aabbMax[i] = aabb.max[i];
+        }
+    }
+}
+
+bool BVH::intersectRayFirst(const Ray3 &ray, BVHRayHit &hit, float tMax) const
+{
+    const std::vector<AABB3> &aabbs = primitiveAABBs;
+    return intersectRayFirst(ray, hit, [&ray, &aabbs](uint32_t primitiveIdx, float tMax, float &t) {
+        RaycastResult result = ray.intersects(aabbs[primitiveIdx]);
+        t = result.t;
+        return result.hit && result.t < tMax;
+    }, tMax);
+}
+
+void BVH::intersectRayAll(const Ray3 &ray, std::vector<BVHRayHit> &hits, float tMax) const
+{
+    const std::vector<AABB3> &aabbs = primitiveAABBs;
+    intersectRayAll(ray, hits, [&ray, &aabbs](uint32_t primitiveIdx, float tMax, float &t) {
+        RaycastResult result = ray.intersects(aabbs[primitiveIdx]);
+        t = result.t;
+        return result.hit && result.t < tMax;
+    }, tMax);
+}
+
+void BVH::queryFrustum(const Plane *planes, size_t numPlanes, std::vector<uint32_t> &primitives) const
+{
+    primitives.clear();
+    if (nodes.empty()) {
+        return;
+    }
+
+    // The highest bit of a stack entry marks subtrees lying completely inside of all planes
+    const uint32_t INSIDE_FLAG = 0x80000000u;
+    uint32_t stack[BVH_MAX_STACK_DEPTH];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        uint32_t entry = stack[--stackSize];
+        uint32_t nodeIdx = entry & ~INSIDE_FLAG;
+        bool isInside = (entry & INSIDE_FLAG) != 0;
+        const BVHNode &node = nodes[nodeIdx];
+
+        if (!isInside) {
+            // Test the corner farthest along the plane normal (outside test) and the nearest corner (inside test)
+            bool isOutside = false;
+            isInside = true;
+            for (size_t p = 0; p < numPlanes; p++) {
+                const Plane &plane = planes[p];
+                float farDistance = plane.d, nearDistance = plane.d;
+                const float normal[3] = { plane.a, plane.b, plane.c };
+                for (int i = 0; i < 3; i++) {
+                    farDistance += normal[i] * (normal[i] >= 0.0f ? node.aabbMax[i] : node.aabbMin[i]);
+                    nearDistance += normal[i] * (normal[i] >= 0.0f ? node.aabbMin[i] : node.aabbMax[i]);
+                }
+                if (farDistance < 0.0f) {
+                    isOutside = true;
+                    break;
+                }
+                if (nearDistance < 0.0f) {
+                    isInside = false;
+                }
+            }
+            if (isOutside) {
+                continue;
+            }
+        }
+
+        if (node.isLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.numPrimitives; i++) {
+                if (isInside) {
+                    primitives.push_back(primitiveIndices[i]);
+                    continue;
+                }
+                const AABB3 &aabb = primitiveAABBs[primitiveIndices[i]];
+                bool isPrimitiveOutside = false;
+                for (size_t p = 0; p < numPlanes && !isPrimitiveOutside; p++) {
+                    isPrimitiveOutside = planes[p].isOutside(aabb);
+                }
+                if (!isPrimitiveOutside) {
+                    primitives.push_back(primitiveIndices[i]);
+                }
+            }
+        } else {
+            uint32_t flag = isInside ? INSIDE_FLAG : 0u;
+            stack[stackSize++] = node.offset | flag;
+            stack[stackSize++] = (nodeIdx + 1) | flag;
+        }
+    }
+}
+
+void BVH::queryAABB(const AABB3 &aabb, std::vector<uint32_t> &primitives) const
+{
+    primitives.clear();
+    if (nodes.empty()) {
+        return;
+    }
+
+    auto overlaps = [&aabb](const glm::vec3 &min, const glm::vec3 &max) {
+        return min.x <= aabb.max.x && max.x >= aabb.min.x
+                && min.y <= aabb.max.y && max.y >= aabb.min.y
+                && min.z <= aabb.max.z && max.z >= aabb.min.z;
+    };
+
+    uint32_t stack[BVH_MAX_STACK_DEPTH];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        uint32_t nodeIdx = stack[--stackSize];
+        const BVHNode &node = nodes[nodeIdx];
+        if (!overlaps(glm::vec3(node.aabbMin[0], node.aabbMin[1], node.aabbMin[2]),
+                glm::vec3(node.aabbMax[0], node.aabbMax[1], node.aabbMax[2]))) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.numPrimitives; i++) {
+                const AABB3 &primitiveAABB = primitiveAABBs[primitiveIndices[i]];
+                if (overlaps(primitiveAABB.min, primitiveAABB.max)) {
+                    primitives.push_back(primitiveIndices[i]);
+                }
+            }
+        } else {
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = nodeIdx + 1;
+        }
+    }
+}
+
+}
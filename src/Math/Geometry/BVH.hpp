@@ -0,0 +1,225 @@
+/*!
+ * BVH.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_MATH_GEOMETRY_BVH_HPP_
+#define SRC_MATH_GEOMETRY_BVH_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cfloat>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include "AABB3.hpp"
+#include "Ray3.hpp"
+#include "Plane.hpp"
+
+namespace sgl {
+
+/*! Node of a flattened BVH (32 bytes). The nodes are stored in depth-first order, i.e., the left child of an inner
+ * node is the node directly following it, and the right child is stored at the index "offset". */
+struct DLL_OBJECT BVHNode {
+    float aabbMin[3];
+    float aabbMax[3];
+    //! Leaf: index of the first entry in the primitive index array. Inner node: index of the right child.
+    uint32_t offset;
+    //! Number of primitives of a leaf, 0 for inner nodes.
+    uint16_t numPrimitives;
+    //! Split axis of inner nodes (used for ordering the traversal).
+    uint8_t splitAxis;
+    uint8_t padding;
+
+    inline bool isLeaf() const { return numPrimitives != 0; }
+};
+
+struct DLL_OBJECT BVHRayHit {
+    BVHRayHit() : primitiveIndex(UINT32_MAX), t(FLT_MAX) {}
+    BVHRayHit(uint32_t primitiveIndex, float t) : primitiveIndex(primitiveIndex), t(t) {}
+    bool operator<(const BVHRayHit &other) const { return t < other.t; }
+    uint32_t primitiveIndex;
+    float t;
+};
+
+/*! Bounding volume hierarchy over the bounding boxes of arbitrary primitives.
+ * The hierarchy is built top-down using binned surface area heuristic splits. Large subtrees are built in parallel
+ * using OpenMP tasks. The ray queries take a functor for the exact primitive test with the signature
+ * bool intersectPrimitive(uint32_t primitiveIndex, float tMax, float &t), which returns true and sets t if the
+ * primitive is hit closer than tMax. Without functor, the primitive bounding boxes are used as the primitives. */
+class DLL_OBJECT BVH {
+public:
+    explicit BVH(size_t maxLeafSize = 4, size_t numBins = 16);
+
+    void build(const AABB3 *primitiveAABBs, size_t numPrimitives);
+    inline void build(const std::vector<AABB3> &primitiveAABBs) {
+        build(primitiveAABBs.empty() ? nullptr : &primitiveAABBs.front(), primitiveAABBs.size());
+    }
+    /*! Updates the node bounds for moved primitives without changing the topology of the tree. This is much faster
+     * than a rebuild, but the quality of the tree degrades if the primitives move a lot. */
+    void refit(const AABB3 *primitiveAABBs);
+
+    //! Closest hit along the ray. Returns false if nothing was hit.
+    template<class IntersectFunctor>
+    bool intersectRayFirst(const Ray3 &ray, BVHRayHit &hit, IntersectFunctor intersectPrimitive,
+            float tMax = FLT_MAX) const;
+    bool intersectRayFirst(const Ray3 &ray, BVHRayHit &hit, float tMax = FLT_MAX) const;
+    /*! Closest hit with a functor that tests all primitives of a leaf at once (e.g. using SIMD). Its signature is
+     * bool intersectLeaf(uint32_t firstPrimitive, uint32_t numPrimitives, float tMax, BVHRayHit &hit). The leaf
+     * covers the entries [firstPrimitive, firstPrimitive + numPrimitives) of getPrimitiveIndices(). The functor
+     * returns true and sets hit if a primitive is hit closer than tMax. The meaning of hit.primitiveIndex is up to
+     * the functor (e.g. the position in getPrimitiveIndices() or the original primitive index). */
+    template<class LeafFunctor>
+    bool intersectRayFirstLeaves(const Ray3 &ray, BVHRayHit &hit, LeafFunctor intersectLeaf,
+            float tMax = FLT_MAX) const;
+    //! All hits along the ray sorted by distance.
+    template<class IntersectFunctor>
+    void intersectRayAll(const Ray3 &ray, std::vector<BVHRayHit> &hits, IntersectFunctor intersectPrimitive,
+            float tMax = FLT_MAX) const;
+    void intersectRayAll(const Ray3 &ray, std::vector<BVHRayHit> &hits, float tMax = FLT_MAX) const;
+
+    /*! Returns all primitives whose bounding boxes are not completely outside of one of the planes (e.g. the six
+     * planes of a view frustum with the normals pointing inwards). */
+    void queryFrustum(const Plane *planes, size_t numPlanes, std::vector<uint32_t> &primitiveIndices) const;
+    //! Returns all primitives whose bounding boxes overlap with the passed box.
+    void queryAABB(const AABB3 &aabb, std::vector<uint32_t> &primitiveIndices) const;
+
+    inline const std::vector<BVHNode> &getNodes() const { return nodes; }
+    inline const std::vector<uint32_t> &getPrimitiveIndices() const { return primitiveIndices; }
+    inline size_t getNumPrimitives() const { return primitiveAABBs.size(); }
+    inline AABB3 getAABB() const { return nodes.empty() ? AABB3() : getNodeAABB(nodes.front()); }
+    inline bool isEmpty() const { return nodes.empty(); }
+
+private:
+    static inline AABB3 getNodeAABB(const BVHNode &node) {
+        return AABB3(glm::vec3(node.aabbMin[0], node.aabbMin[1], node.aabbMin[2]),
+                glm::vec3(node.aabbMax[0], node.aabbMax[1], node.aabbMax[2]));
+    }
+    //! Slab test with precomputed inverse ray direction. Returns the entry distance or FLT_MAX on a miss.
+    static inline float intersectNode(const BVHNode &node, const glm::vec3 &origin, const glm::vec3 &inverseDirection,
+            float tMax) {
+        float tEnter = 0.0f, tExit = tMax;
+        for (int i = 0; i < 3; i++) {
+            float t0 = (node.aabbMin[i] - origin[i]) * inverseDirection[i];
+            float t1 = (node.aabbMax[i] - origin[i]) * inverseDirection[i];
+            tEnter = std::max(tEnter, std::min(t0, t1));
+            tExit = std::min(tExit, std::max(t0, t1));
+        }
+        return tEnter <= tExit ? tEnter : FLT_MAX;
+    }
+
+    size_t maxLeafSize;
+    size_t numBins;
+    std::vector<BVHNode> nodes;
+    //! Maps the primitive ranges of the leaves to the indices of the primitives passed to build
+    std::vector<uint32_t> primitiveIndices;
+    std::vector<AABB3> primitiveAABBs;
+};
+
+//! Maximum depth of the traversal stack. The build guarantees that this depth is never exceeded.
+#define BVH_MAX_STACK_DEPTH 128
+
+template<class LeafFunctor>
+bool BVH::intersectRayFirstLeaves(const Ray3 &ray, BVHRayHit &hit, LeafFunctor intersectLeaf, float tMax) const
+{
+    hit = BVHRayHit();
+    if (nodes.empty()) {
+        return false;
+    }
+    const glm::vec3 origin = ray.getOrigin();
+    const glm::vec3 inverseDirection = 1.0f / ray.getDirection();
+    float tClosest = tMax;
+
+    uint32_t stack[BVH_MAX_STACK_DEPTH];
+    int stackSize = 0;
+    if (intersectNode(nodes.front(), origin, inverseDirection, tClosest) == FLT_MAX) {
+        return false;
+    }
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const BVHNode &node = nodes[stack[--stackSize]];
+        if (node.isLeaf()) {
+            if (intersectLeaf(node.offset, uint32_t(node.numPrimitives), tClosest, hit)) {
+                tClosest = hit.t;
+            }
+            continue;
+        }
+
+        // Visit the closer child first
+        uint32_t leftIdx = uint32_t(&node - &nodes.front()) + 1, rightIdx = node.offset;
+        float tLeft = intersectNode(nodes[leftIdx], origin, inverseDirection, tClosest);
+        float tRight = intersectNode(nodes[rightIdx], origin, inverseDirection, tClosest);
+        if (tLeft > tRight) {
+            std::swap(tLeft, tRight);
+            std::swap(leftIdx, rightIdx);
+        }
+        if (tRight != FLT_MAX) {
+            stack[stackSize++] = rightIdx;
+        }
+        if (tLeft != FLT_MAX) {
+            stack[stackSize++] = leftIdx;
+        }
+    }
+    return hit.primitiveIndex != UINT32_MAX;
+}
+
+template<class IntersectFunctor>
+bool BVH::intersectRayFirst(const Ray3 &ray, BVHRayHit &hit, IntersectFunctor intersectPrimitive, float tMax) const
+{
+    const std::vector<uint32_t> &indices = primitiveIndices;
+    return intersectRayFirstLeaves(ray, hit, [&indices, &intersectPrimitive](
+            uint32_t firstPrimitive, uint32_t numPrimitives, float tClosest, BVHRayHit &leafHit) {
+        bool isHit = false;
+        for (uint32_t i = firstPrimitive; i < firstPrimitive + numPrimitives; i++) {
+            float t;
+            if (intersectPrimitive(indices[i], tClosest, t) && t < tClosest) {
+                tClosest = t;
+                leafHit = BVHRayHit(indices[i], t);
+                isHit = true;
+            }
+        }
+        return isHit;
+    }, tMax);
+}
+
+template<class IntersectFunctor>
+void BVH::intersectRayAll(const Ray3 &ray, std::vector<BVHRayHit> &hits, IntersectFunctor intersectPrimitive,
+        float tMax) const
+{
+    hits.clear();
+    if (nodes.empty()) {
+        return;
+    }
+    const glm::vec3 origin = ray.getOrigin();
+    const glm::vec3 inverseDirection = 1.0f / ray.getDirection();
+
+    uint32_t stack[BVH_MAX_STACK_DEPTH];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        uint32_t nodeIdx = stack[--stackSize];
+        const BVHNode &node = nodes[nodeIdx];
+        if (intersectNode(node, origin, inverseDirection, tMax) == FLT_MAX) {
+            continue;
+        }
+        if (node.isLeaf()) {
+            for (uint32_t i = node.offset; i < node.offset + node.numPrimitives; i++) {
+                float t;
+                if (intersectPrimitive(primitiveIndices[i], tMax, t)) {
+                    hits.push_back(BVHRayHit(primitiveIndices[i], t));
+                }
+            }
+        } else {
+            stack[stackSize++] = node.offset;
+            stack[stackSize++] = nodeIdx + 1;
+        }
+    }
+    std::sort(hits.begin(), hits.end());
+}
+
+}
+
+/*! SRC_MATH_GEOMETRY_BVH_HPP_ */
+#endif
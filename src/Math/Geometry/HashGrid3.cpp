@@ -0,0 +1,289 @@
+/*
+ * HashGrid3.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "HashGrid3.hpp"
+#include <queue>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+//! Average number of points per cell if the cell size is chosen automatically
+#define HASH_GRID_POINTS_PER_CELL 4.0f
+//! Upper bound for the number of cells per axis (keeps the cell coordinates far away from integer overflows)
+#define HASH_GRID_MAX_CELLS_PER_AXIS 1048576
+//! Number of bits sorted per pass of the radix sort, and the resulting number of counters
+#define HASH_GRID_RADIX_BITS 8
+#define HASH_GRID_RADIX_SIZE 256
+//! Maximum number of chunks the radix sort passes are split into for parallelization
+#define HASH_GRID_RADIX_MAX_CHUNKS 64
+
+HashGrid3::HashGrid3(float cellSize) : requestedCellSize(cellSize)
+{
+}
+
+void HashGrid3::clear()
+{
+    aabb = AABB3();
+    gridSize = glm::ivec3(0);
+    bucketMask = 0;
+    bucketStarts.clear();
+    sortedPoints.clear();
+    sortedPointIndices.clear();
+}
+
+void HashGrid3::build(const glm::vec3 *points, size_t numPoints)
+{
+    clear();
+    if (numPoints == 0) {
+        return;
+    }
+    // The OpenMP loops use int indices.
+    if (numPoints >= size_t(INT32_MAX)) {
+        Logfile::get()->writeError("HashGrid3::build: Too many points!");
+        return;
+    }
+
+    aabb.combine(points, numPoints);
+    glm::vec3 dimensions = aabb.getDimensions();
+    float maxDimension = std::max(dimensions.x, std::max(dimensions.y, dimensions.z));
+    cellSize = requestedCellSize;
+    if (cellSize <= 0.0f) {
+        // Flat or degenerate point sets: Don't let a zero extent along one axis collapse the volume
+        glm::vec3 clampedDimensions = glm::max(dimensions, glm::vec3(std::max(maxDimension * 1e-3f, 1e-6f)));
+        float volume = clampedDimensions.x * clampedDimensions.y * clampedDimensions.z;
+        cellSize = std::cbrt(volume * HASH_GRID_POINTS_PER_CELL / float(numPoints));
+    }
+    cellSize = std::max(cellSize, std::max(maxDimension, 1e-6f) / float(HASH_GRID_MAX_CELLS_PER_AXIS - 1));
+    inverseCellSize = 1.0f / cellSize;
+    gridSize = glm::ivec3(glm::floor(dimensions * inverseCellSize)) + glm::ivec3(1);
+    gridSize = glm::min(gridSize, glm::ivec3(HASH_GRID_MAX_CELLS_PER_AXIS));
+
+    uint32_t numBuckets = 1;
+    int numBucketBits = 0;
+    while (numBuckets < numPoints) {
+        numBuckets *= 2;
+        numBucketBits++;
+    }
+    bucketMask = numBuckets - 1;
+
+    // Sort the point indices by bucket using a stable LSD radix sort (i.e., repeated counting sorts)
+    const int numPointsInt = int(numPoints);
+    std::vector<uint32_t> keys(numPoints), indices(numPoints), keysTmp(numPoints), indicesTmp(numPoints);
+    uint32_t *keysPtr = &keys.front();
+    uint32_t *indicesPtr = &indices.front();
+    #pragma omp parallel for shared(points, numPointsInt, keysPtr, indicesPtr) default(none)
+    for (int i = 0; i < numPointsInt; i++) {
+        keysPtr[i] = getBucket(getCell(points[i]));
+        indicesPtr[i] = uint32_t(i);
+    }
+    for (int shift = 0; shift < numBucketBits; shift += HASH_GRID_RADIX_BITS) {
+        radixSortPass(keys, indices, keysTmp, indicesTmp, shift);
+        keys.swap(keysTmp);
+        indices.swap(indicesTmp);
+    }
+
+    // Gather the points in bucket order and find the start of every bucket
+    sortedPoints.resize(numPoints);
+    bucketStarts.resize(size_t(numBuckets) + 1);
+    keysPtr = &keys.front();
+    indicesPtr = &indices.front();
+    glm::vec3 *sortedPointsPtr = &sortedPoints.front();
+    uint32_t *bucketStartsPtr = &bucketStarts.front();
+    #pragma omp parallel for shared(points, numPointsInt, keysPtr, indicesPtr, sortedPointsPtr, bucketStartsPtr) \
+            default(none)
+    for (int i = 0; i < numPointsInt; i++) {
+        sortedPointsPtr[i] = points[indicesPtr[i]];
+        uint32_t firstBucket = i == 0 ? 0 : keysPtr[i - 1] + 1;
+        for (uint32_t bucket = firstBucket; bucket <= keysPtr[i]; bucket++) {
+            bucketStartsPtr[bucket] = uint32_t(i);
+        }
+    }
+    for (uint32_t bucket = keys.back() + 1; bucket <= numBuckets; bucket++) {
+        bucketStarts[bucket] = uint32_t(numPoints);
+    }
+    sortedPointIndices.swap(indices);
+}
+
+void HashGrid3::radixSortPass(
+        const std::vector<uint32_t> &keys, const std::vector<uint32_t> &values,
+        std::vector<uint32_t> &sortedKeys, std::vector<uint32_t> &sortedValues, int shift)
+{
+    // The array is split into chunks that are counted and scattered in parallel. Each chunk writes its elements to a
+    // separate range of every digit, so the sort stays stable independent of the number of threads.
+    const int numElements = int(keys.size());
+    const int numChunks = std::max(1, std::min(HASH_GRID_RADIX_MAX_CHUNKS, numElements / 65536));
+    const int chunkSize = (numElements + numChunks - 1) / numChunks;
+    std::vector<uint32_t> chunkOffsets(size_t(numChunks) * HASH_GRID_RADIX_SIZE, 0);
+
+    const uint32_t *keysPtr = &keys.front();
+    const uint32_t *valuesPtr = &values.front();
+    uint32_t *sortedKeysPtr = &sortedKeys.front();
+    uint32_t *sortedValuesPtr = &sortedValues.front();
+    uint32_t *chunkOffsetsPtr = &chunkOffsets.front();
+    #pragma omp parallel for shared(numElements, numChunks, chunkSize, keysPtr, chunkOffsetsPtr, shift) default(none)
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+        uint32_t *counts = chunkOffsetsPtr + chunk * HASH_GRID_RADIX_SIZE;
+        const int end = int(std::min(int64_t(numElements), int64_t(chunk + 1) * int64_t(chunkSize)));
+        for (int i = chunk * chunkSize; i < end; i++) {
+            counts[(keysPtr[i] >> shift) & (HASH_GRID_RADIX_SIZE - 1)]++;
+        }
+    }
+
+    uint32_t offset = 0;
+    for (int digit = 0; digit < HASH_GRID_RADIX_SIZE; digit++) {
+        for (int chunk = 0; chunk < numChunks; chunk++) {
+            uint32_t &chunkOffset = chunkOffsets[chunk * HASH_GRID_RADIX_SIZE + digit];
+            uint32_t count = chunkOffset;
+            chunkOffset = offset;
+            offset += count;
+        }
+    }
+
+    #pragma omp parallel for default(none) shared(numElements, numChunks, chunkSize, keysPtr, valuesPtr, \
+            sortedKeysPtr, sortedValuesPtr, chunkOffsetsPtr, shift)
+    for (int chunk = 0; chunk < numChunks; chunk++) {
+        uint32_t *writePositions = chunkOffsetsPtr + chunk * HASH_GRID_RADIX_SIZE;
+        const int end = int(std::min(int64_t(numElements), int64_t(chunk + 1) * int64_t(chunkSize)));
+        for (int i = chunk * chunkSize; i < end; i++) {
+            uint32_t writePosition = writePositions[(keysPtr[i] >> shift) & (HASH_GRID_RADIX_SIZE - 1)]++;
+            sortedKeysPtr[writePosition] = keysPtr[i];
+            sortedValuesPtr[writePosition] = valuesPtr[i];
+        }
+    }
+}
+
+void HashGrid3::insert(const std::vector<glm::vec3> &points)
+{
+    const size_t numOldPoints = sortedPoints.size();
+    std::vector<glm::vec3> allPoints(numOldPoints + points.size());
+    for (size_t i = 0; i < numOldPoints; i++) {
+        allPoints[sortedPointIndices[i]] = sortedPoints[i];
+    }
+    std::copy(points.begin(), points.end(), allPoints.begin() + numOldPoints);
+    build(allPoints);
+}
+
+void HashGrid3::queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &pointIndices) const
+{
+    pointIndices.clear();
+    if (sortedPoints.empty() || radius < 0.0f) {
+        return;
+    }
+    const float radiusSquared = radius * radius;
+    auto visitor = [this, &center, radiusSquared, &pointIndices](uint32_t i) {
+        glm::vec3 diff = sortedPoints[i] - center;
+        if (glm::dot(diff, diff) <= radiusSquared) {
+            pointIndices.push_back(sortedPointIndices[i]);
+        }
+    };
+    visitCells(getCellUnclamped(center - glm::vec3(radius)), getCellUnclamped(center + glm::vec3(radius)), visitor);
+}
+
+size_t HashGrid3::countRadius(const glm::vec3 &center, float radius) const
+{
+    if (sortedPoints.empty() || radius < 0.0f) {
+        return 0;
+    }
+    const float radiusSquared = radius * radius;
+    size_t numPointsInRadius = 0;
+    auto visitor = [this, &center, radiusSquared, &numPointsInRadius](uint32_t i) {
+        glm::vec3 diff = sortedPoints[i] - center;
+        if (glm::dot(diff, diff) <= radiusSquared) {
+            numPointsInRadius++;
+        }
+    };
+    visitCells(getCellUnclamped(center - glm::vec3(radius)), getCellUnclamped(center + glm::vec3(radius)), visitor);
+    return numPointsInRadius;
+}
+
+void HashGrid3::queryAABB(const AABB3 &queryAABB, std::vector<uint32_t> &pointIndices) const
+{
+    pointIndices.clear();
+    if (sortedPoints.empty()) {
+        return;
+    }
+    auto visitor = [this, &queryAABB, &pointIndices](uint32_t i) {
+        const glm::vec3 &point = sortedPoints[i];
+        if (point.x >= queryAABB.min.x && point.y >= queryAABB.min.y && point.z >= queryAABB.min.z
+                && point.x <= queryAABB.max.x && point.y <= queryAABB.max.y && point.z <= queryAABB.max.z) {
+            pointIndices.push_back(sortedPointIndices[i]);
+        }
+    };
+    visitCells(getCellUnclamped(queryAABB.min), getCellUnclamped(queryAABB.max), visitor);
+}
+
+void HashGrid3::queryKNearest(const glm::vec3 &center, size_t k, std::vector<uint32_t> &pointIndices) const
+{
+    pointIndices.clear();
+    if (sortedPoints.empty() || k == 0) {
+        return;
+    }
+
+    // Max-heap of the k closest points found so far (squared distance, index)
+    std::priority_queue<std::pair<float, uint32_t>> closestPoints;
+    auto visitor = [this, &center, k, &closestPoints](uint32_t i) {
+        glm::vec3 diff = sortedPoints[i] - center;
+        float distanceSquared = glm::dot(diff, diff);
+        if (closestPoints.size() < k) {
+            closestPoints.push(std::make_pair(distanceSquared, sortedPointIndices[i]));
+        } else if (distanceSquared < closestPoints.top().first) {
+            closestPoints.pop();
+            closestPoints.push(std::make_pair(distanceSquared, sortedPointIndices[i]));
+        }
+    };
+
+    // Visit the cells in shells of growing Chebyshev distance around the cell of the query point. The search stops
+    // when the k-th closest point is closer than the boundary of the cells visited so far.
+    const glm::ivec3 centerCell = getCellUnclamped(center);
+    const glm::vec3 centerGrid = (center - aabb.min) * inverseCellSize;
+    const glm::ivec3 distanceToGridMin = centerCell, distanceToGridMax = gridSize - glm::ivec3(1) - centerCell;
+    int firstRing = std::max(0, std::max(-std::min(distanceToGridMax.x, std::min(distanceToGridMax.y,
+            distanceToGridMax.z)), -std::min(distanceToGridMin.x, std::min(distanceToGridMin.y, distanceToGridMin.z))));
+    int lastRing = std::max(std::max(std::abs(distanceToGridMin.x), std::abs(distanceToGridMax.x)),
+            std::max(std::max(std::abs(distanceToGridMin.y), std::abs(distanceToGridMax.y)),
+                    std::max(std::abs(distanceToGridMin.z), std::abs(distanceToGridMax.z))));
+    for (int ring = firstRing; ring <= lastRing; ring++) {
+        glm::ivec3 minCell = glm::max(centerCell - glm::ivec3(ring), glm::ivec3(0));
+        glm::ivec3 maxCell = glm::min(centerCell + glm::ivec3(ring), gridSize - glm::ivec3(1));
+        for (int z = minCell.z; z <= maxCell.z; z++) {
+            for (int y = minCell.y; y <= maxCell.y; y++) {
+                bool isOnShell = std::abs(z - centerCell.z) == ring || std::abs(y - centerCell.y) == ring;
+                if (isOnShell) {
+                    for (int x = minCell.x; x <= maxCell.x; x++) {
+                        visitCell(glm::ivec3(x, y, z), visitor);
+                    }
+                } else {
+                    // Only the two cells at the ends of the row lie on the shell
+                    int x0 = centerCell.x - ring, x1 = centerCell.x + ring;
+                    if (x0 >= 0 && x0 < gridSize.x) {
+                        visitCell(glm::ivec3(x0, y, z), visitor);
+                    }
+                    if (ring > 0 && x1 >= 0 && x1 < gridSize.x) {
+                        visitCell(glm::ivec3(x1, y, z), visitor);
+                    }
+                }
+            }
+        }
+
+        glm::vec3 distanceToShellMin = centerGrid - glm::vec3(centerCell - glm::ivec3(ring));
+        glm::vec3 distanceToShellMax = glm::vec3(centerCell + glm::ivec3(ring + 1)) - centerGrid;
+        glm::vec3 distanceToShell = glm::min(distanceToShellMin, distanceToShellMax);
+        float minDistanceOutside = std::min(distanceToShell.x, std::min(distanceToShell.y, distanceToShell.z))
+                * cellSize;
+        if (closestPoints.size() == k && closestPoints.top().first <= minDistanceOutside * minDistanceOutside) {
+            break;
+        }
+    }
+
+    pointIndices.resize(closestPoints.size());
+    for (size_t i = closestPoints.size(); i > 0; i--) {
+        pointIndices[i - 1] = closestPoints.top().second;
+        closestPoints.pop();
+    }
+}
+
+}
@@ -0,0 +1,119 @@
+/*!
+ * HashGrid3.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_MATH_GEOMETRY_HASHGRID3_HPP_
+#define SRC_MATH_GEOMETRY_HASHGRID3_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include "AABB3.hpp"
+
+namespace sgl {
+
+/*! Uniform grid over a point set for neighborhood queries (e.g. the density of line vertices).
+ * The cells are mapped to a hash table with (at least) one bucket per point, so memory usage only depends on the
+ * number of points and not on the extent of the data. The points are sorted by bucket using a parallel radix sort
+ * (i.e., a sequence of stable counting sorts), and a copy of the points is stored in that order for cache-friendly
+ * queries. All queries return the indices
+ * of the points passed to build. */
+class DLL_OBJECT HashGrid3 {
+public:
+    /*! \param cellSize Edge length of the grid cells. Ideally, this is in the order of the typical query radius.
+     * If it is not positive, the cell size is chosen such that there are about four points per cell. */
+    explicit HashGrid3(float cellSize = 0.0f);
+
+    void build(const glm::vec3 *points, size_t numPoints);
+    inline void build(const std::vector<glm::vec3> &points) {
+        build(points.empty() ? nullptr : &points.front(), points.size());
+    }
+    /*! Bulk insert: Appends the points (with the indices getNumPoints(), getNumPoints() + 1, ...) and rebuilds the
+     * grid. The build takes linear time, so insert points in large batches. */
+    void insert(const std::vector<glm::vec3> &points);
+    void clear();
+
+    //! All points with a distance of at most radius to center.
+    void queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &pointIndices) const;
+    //! Number of points with a distance of at most radius to center (e.g. for density estimation).
+    size_t countRadius(const glm::vec3 &center, float radius) const;
+    //! The k points closest to center sorted by distance (fewer if the grid contains less than k points).
+    void queryKNearest(const glm::vec3 &center, size_t k, std::vector<uint32_t> &pointIndices) const;
+    //! All points inside of the box.
+    void queryAABB(const AABB3 &aabb, std::vector<uint32_t> &pointIndices) const;
+
+    inline float getCellSize() const { return cellSize; }
+    inline size_t getNumPoints() const { return sortedPoints.size(); }
+    inline const AABB3 &getAABB() const { return aabb; }
+    inline bool isEmpty() const { return sortedPoints.empty(); }
+
+private:
+    //! One stable counting sort pass of the values by the bits [shift, shift + 8) of the keys.
+    static void radixSortPass(
+            const std::vector<uint32_t> &keys, const std::vector<uint32_t> &values,
+            std::vector<uint32_t> &sortedKeys, std::vector<uint32_t> &sortedValues, int shift);
+    //! Cell of a point inside of the grid bounds (truncation is the same as flooring for non-negative values).
+    inline glm::ivec3 getCell(const glm::vec3 &point) const {
+        glm::ivec3 cell = glm::ivec3(glm::max((point - aabb.min) * inverseCellSize, glm::vec3(0.0f)));
+        return glm::min(cell, gridSize - glm::ivec3(1));
+    }
+    //! Cell of the point without clamping to the grid (for query positions outside of the grid).
+    inline glm::ivec3 getCellUnclamped(const glm::vec3 &point) const {
+        glm::vec3 cell = glm::floor(glm::clamp((point - aabb.min) * inverseCellSize, glm::vec3(-1e9f),
+                glm::vec3(1e9f)));
+        return glm::ivec3(cell);
+    }
+    inline uint32_t getBucket(const glm::ivec3 &cell) const {
+        return (uint32_t(cell.x) * 73856093u ^ uint32_t(cell.y) * 19349663u ^ uint32_t(cell.z) * 83492791u)
+                & bucketMask;
+    }
+    /*! Calls visitor(sortedIndex) for all points in the cells of the range [minCell, maxCell] (clamped to the grid).
+     * Points of other cells mapped to the same bucket are skipped. */
+    template<class Visitor>
+    void visitCells(glm::ivec3 minCell, glm::ivec3 maxCell, Visitor visitor) const;
+    template<class Visitor>
+    inline void visitCell(const glm::ivec3 &cell, Visitor &visitor) const {
+        const uint32_t bucket = getBucket(cell);
+        for (uint32_t i = bucketStarts[bucket]; i < bucketStarts[bucket + 1]; i++) {
+            if (getCell(sortedPoints[i]) == cell) {
+                visitor(i);
+            }
+        }
+    }
+
+    float requestedCellSize;
+    float cellSize = 0.0f;
+    float inverseCellSize = 0.0f;
+    AABB3 aabb;
+    glm::ivec3 gridSize = glm::ivec3(0);
+    uint32_t bucketMask = 0;
+    //! Bucket i contains the entries [bucketStarts[i], bucketStarts[i+1]) of sortedPoints and sortedPointIndices
+    std::vector<uint32_t> bucketStarts;
+    std::vector<glm::vec3> sortedPoints;
+    std::vector<uint32_t> sortedPointIndices;
+};
+
+template<class Visitor>
+void HashGrid3::visitCells(glm::ivec3 minCell, glm::ivec3 maxCell, Visitor visitor) const
+{
+    minCell = glm::max(minCell, glm::ivec3(0));
+    maxCell = glm::min(maxCell, gridSize - glm::ivec3(1));
+    for (int z = minCell.z; z <= maxCell.z; z++) {
+        for (int y = minCell.y; y <= maxCell.y; y++) {
+            for (int x = minCell.x; x <= maxCell.x; x++) {
+                visitCell(glm::ivec3(x, y, z), visitor);
+            }
+        }
+    }
+}
+
+}
+
+/*! SRC_MATH_GEOMETRY_HASHGRID3_HPP_ */
+#endif
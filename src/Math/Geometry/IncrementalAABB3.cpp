@@ -0,0 +1,95 @@
+/*
+ * IncrementalAABB3.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "IncrementalAABB3.hpp"
+#include <algorithm>
+
+namespace sgl {
+
+IncrementalAABB3::IncrementalAABB3(size_t pointsPerBlock) : pointsPerBlock(std::max(pointsPerBlock, size_t(1)))
+{
+}
+
+void IncrementalAABB3::build(const glm::vec3 *points, size_t numPoints, size_t pointStride)
+{
+    this->numPoints = numPoints;
+    this->pointStride = pointStride;
+    const size_t numBlocks = numPoints == 0 ? 0 : (numPoints - 1) / pointsPerBlock + 1;
+    blockAABBs.clear();
+    blockAABBs.resize(numBlocks);
+    dirtyBlocks.clear();
+    isBlockDirty.clear();
+    isBlockDirty.resize(numBlocks, false);
+
+    #pragma omp parallel for shared(points, numBlocks) default(none)
+    for (size_t blockIdx = 0; blockIdx < numBlocks; ++blockIdx) {
+        recomputeBlock(points, blockIdx);
+    }
+    recomputeTotalAABB();
+}
+
+void IncrementalAABB3::recomputeBlock(const glm::vec3 *points, size_t blockIdx)
+{
+    size_t firstPoint = blockIdx * pointsPerBlock;
+    size_t numBlockPoints = std::min(pointsPerBlock, numPoints - firstPoint);
+    const uint8_t *pointBytes = reinterpret_cast<const uint8_t*>(points) + firstPoint * pointStride;
+    AABB3 blockAABB;
+    blockAABB.combine(reinterpret_cast<const glm::vec3*>(pointBytes), numBlockPoints, pointStride);
+    blockAABBs.at(blockIdx) = blockAABB;
+}
+
+void IncrementalAABB3::recomputeTotalAABB()
+{
+    totalAABB = AABB3();
+    for (const AABB3 &blockAABB : blockAABBs) {
+        totalAABB.combine(blockAABB);
+    }
+    totalAABBDirty = false;
+}
+
+void IncrementalAABB3::markDirty(size_t firstIndex, size_t count)
+{
+    if (count == 0 || firstIndex >= numPoints) {
+        return;
+    }
+    size_t lastIndex = std::min(firstIndex + count, numPoints) - 1;
+    for (size_t blockIdx = firstIndex / pointsPerBlock; blockIdx <= lastIndex / pointsPerBlock; ++blockIdx) {
+        if (!isBlockDirty.at(blockIdx)) {
+            isBlockDirty.at(blockIdx) = true;
+            dirtyBlocks.push_back(blockIdx);
+        }
+    }
+    totalAABBDirty = true;
+}
+
+void IncrementalAABB3::update(const glm::vec3 *points, size_t firstIndex, size_t count)
+{
+    markDirty(firstIndex, count);
+    getAABB(points);
+}
+
+const AABB3 &IncrementalAABB3::getAABB(const glm::vec3 *points)
+{
+    if (!dirtyBlocks.empty()) {
+        MY_ASSERT(points != nullptr);
+        const size_t numDirtyBlocks = dirtyBlocks.size();
+        #pragma omp parallel for shared(points, numDirtyBlocks) default(none) if(numDirtyBlocks > 16)
+        for (size_t i = 0; i < numDirtyBlocks; ++i) {
+            recomputeBlock(points, dirtyBlocks[i]);
+        }
+        for (size_t blockIdx : dirtyBlocks) {
+            isBlockDirty.at(blockIdx) = false;
+        }
+        dirtyBlocks.clear();
+    }
+    if (totalAABBDirty) {
+        recomputeTotalAABB();
+    }
+    return totalAABB;
+}
+
+}
@@ -0,0 +1,57 @@
+/*!
+ * IncrementalAABB3.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_MATH_GEOMETRY_INCREMENTALAABB3_HPP_
+#define SRC_MATH_GEOMETRY_INCREMENTALAABB3_HPP_
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include "AABB3.hpp"
+
+namespace sgl {
+
+/*! Bounding box of a dynamic point array that can be updated for modified index ranges only.
+ * The points are split into blocks with one AABB each. When a range of points changes, only the affected blocks are
+ * recomputed (this also handles shrinking bounds correctly), and the total AABB is merged from the block AABBs.
+ * Usage:
+ * - build(points, numPoints) once (and whenever the number of points changes).
+ * - update(points, firstIndex, count) after modifying the points in [firstIndex, firstIndex + count).
+ * - getAABB() to retrieve the current bounds. */
+class DLL_OBJECT IncrementalAABB3 {
+public:
+    explicit IncrementalAABB3(size_t pointsPerBlock = 4096);
+
+    //! Recomputes the bounds of all blocks (in parallel for large arrays).
+    void build(const glm::vec3 *points, size_t numPoints, size_t pointStride = sizeof(glm::vec3));
+    //! Recomputes the bounds of all blocks overlapping with the modified index range.
+    void update(const glm::vec3 *points, size_t firstIndex, size_t count);
+    //! Marks the index range as modified. The bounds are recomputed lazily by the next call to getAABB.
+    void markDirty(size_t firstIndex, size_t count);
+
+    //! Returns the bounds of all points. Points needs to be passed if markDirty was used.
+    const AABB3 &getAABB(const glm::vec3 *points = nullptr);
+    inline size_t getNumPoints() const { return numPoints; }
+
+private:
+    void recomputeBlock(const glm::vec3 *points, size_t blockIdx);
+    void recomputeTotalAABB();
+
+    size_t pointsPerBlock;
+    size_t pointStride = sizeof(glm::vec3);
+    size_t numPoints = 0;
+    std::vector<AABB3> blockAABBs;
+    std::vector<size_t> dirtyBlocks;
+    std::vector<bool> isBlockDirty;
+    AABB3 totalAABB;
+    bool totalAABBDirty = false;
+};
+
+}
+
+/*! SRC_MATH_GEOMETRY_INCREMENTALAABB3_HPP_ */
+#endif
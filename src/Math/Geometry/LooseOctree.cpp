@@ -0,0 +1,332 @@
+/*
+ * LooseOctree.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "LooseOctree.hpp"
+#include <queue>
+#include <cmath>
+#include <algorithm>
+#include <functional>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+LooseOctree::LooseOctree(const AABB3 &bounds, size_t maxDepth, size_t maxItemsPerNode, float looseness)
+        : maxDepth(maxDepth), maxItemsPerNode(std::max(maxItemsPerNode, size_t(1))),
+          looseness(std::max(looseness, 1.0f)), bounds(bounds)
+{
+    clear();
+}
+
+void LooseOctree::clear()
+{
+    nodes.clear();
+    itemAABBs.clear();
+
+    glm::vec3 extent = bounds.getExtent();
+    LooseOctreeNode root;
+    root.center = bounds.getCenter();
+    root.halfSize = std::max(extent.x, std::max(extent.y, extent.z));
+    root.firstChild = -1;
+    root.depth = 0;
+    nodes.push_back(root);
+}
+
+uint32_t LooseOctree::insert(const AABB3 &aabb)
+{
+    uint32_t itemIndex = uint32_t(itemAABBs.size());
+    itemAABBs.push_back(aabb);
+    insertItem(itemIndex, true);
+    return itemIndex;
+}
+
+bool LooseOctree::checkNumItems(size_t numNewItems)
+{
+    // The OpenMP loop of insertItemsSorted uses int indices.
+    if (itemAABBs.size() + numNewItems >= size_t(INT32_MAX)) {
+        Logfile::get()->writeError("LooseOctree::insert: Too many items!");
+        return false;
+    }
+    return true;
+}
+
+void LooseOctree::insert(const std::vector<AABB3> &aabbs)
+{
+    if (!checkNumItems(aabbs.size())) {
+        return;
+    }
+    const uint32_t firstItem = uint32_t(itemAABBs.size());
+    itemAABBs.insert(itemAABBs.end(), aabbs.begin(), aabbs.end());
+    insertItemsSorted(firstItem, uint32_t(aabbs.size()));
+}
+
+void LooseOctree::insert(const std::vector<glm::vec3> &points)
+{
+    if (!checkNumItems(points.size())) {
+        return;
+    }
+    const uint32_t firstItem = uint32_t(itemAABBs.size());
+    itemAABBs.reserve(itemAABBs.size() + points.size());
+    for (const glm::vec3 &point : points) {
+        itemAABBs.push_back(AABB3(point, point));
+    }
+    insertItemsSorted(firstItem, uint32_t(points.size()));
+}
+
+static inline uint32_t expandBits10(uint32_t value)
+{
+    value = (value | (value << 16)) & 0x030000FFu;
+    value = (value | (value << 8)) & 0x0300F00Fu;
+    value = (value | (value << 4)) & 0x030C30C3u;
+    value = (value | (value << 2)) & 0x09249249u;
+    return value;
+}
+
+void LooseOctree::insertItemsSorted(uint32_t firstItem, uint32_t numItems)
+{
+    // Inserting the items in Morton order of their centers makes consecutive insertions follow mostly the same path
+    // through the tree, which is much more cache friendly than the input order.
+    const LooseOctreeNode &root = nodes.front();
+    const glm::vec3 rootMin = root.center - glm::vec3(root.halfSize);
+    const float scale = root.halfSize > 0.0f ? 1023.0f / (2.0f * root.halfSize) : 0.0f;
+    std::vector<std::pair<uint32_t, uint32_t>> mortonCodes(numItems);
+    const AABB3 *itemAABBsPtr = itemAABBs.empty() ? nullptr : &itemAABBs.front();
+    std::pair<uint32_t, uint32_t> *mortonCodesPtr = mortonCodes.empty() ? nullptr : &mortonCodes.front();
+    const int numItemsInt = int(numItems);
+    #pragma omp parallel for default(none) \
+            shared(firstItem, numItemsInt, rootMin, scale, itemAABBsPtr, mortonCodesPtr)
+    for (int i = 0; i < numItemsInt; i++) {
+        uint32_t itemIndex = firstItem + uint32_t(i);
+        glm::vec3 cell = glm::clamp(
+                (itemAABBsPtr[itemIndex].getCenter() - rootMin) * scale, glm::vec3(0.0f), glm::vec3(1023.0f));
+        uint32_t mortonCode = expandBits10(uint32_t(cell.x)) | (expandBits10(uint32_t(cell.y)) << 1)
+                | (expandBits10(uint32_t(cell.z)) << 2);
+        mortonCodesPtr[i] = std::make_pair(mortonCode, itemIndex);
+    }
+    std::sort(mortonCodes.begin(), mortonCodes.end());
+
+    for (const std::pair<uint32_t, uint32_t> &mortonCode : mortonCodes) {
+        insertItem(mortonCode.second, false);
+    }
+    recomputeSubtreeAABBs();
+}
+
+void LooseOctree::recomputeSubtreeAABBs()
+{
+    // Children are always stored after their parent, so iterating backwards visits the children first
+    for (size_t nodeIndex = nodes.size(); nodeIndex > 0; nodeIndex--) {
+        LooseOctreeNode &node = nodes[nodeIndex - 1];
+        AABB3 subtreeAABB;
+        for (uint32_t itemIndex : node.items) {
+            subtreeAABB.combine(itemAABBs[itemIndex]);
+        }
+        if (node.firstChild >= 0) {
+            for (int32_t childIndex = node.firstChild; childIndex < node.firstChild + 8; childIndex++) {
+                subtreeAABB.combine(nodes[childIndex].subtreeAABB);
+            }
+        }
+        node.subtreeAABB = subtreeAABB;
+    }
+}
+
+int32_t LooseOctree::getChildForItem(const LooseOctreeNode &node, const AABB3 &aabb) const
+{
+    const glm::vec3 itemCenter = aabb.getCenter();
+    const glm::vec3 itemExtent = aabb.getExtent();
+    const float childHalfSize = node.halfSize * 0.5f;
+
+    // The item center lies inside of the child cube, so the loose child bounds contain the whole item if its extent
+    // is at most (looseness - 1) times the half size of the child.
+    const float maxExtent = (looseness - 1.0f) * childHalfSize;
+    if (itemExtent.x > maxExtent || itemExtent.y > maxExtent || itemExtent.z > maxExtent) {
+        return -1;
+    }
+    glm::vec3 offset = itemCenter - node.center;
+    if (std::abs(offset.x) > node.halfSize || std::abs(offset.y) > node.halfSize
+            || std::abs(offset.z) > node.halfSize) {
+        // Only possible for the root node
+        return -1;
+    }
+    int32_t octant = (offset.x >= 0.0f ? 1 : 0) | (offset.y >= 0.0f ? 2 : 0) | (offset.z >= 0.0f ? 4 : 0);
+    return node.firstChild + octant;
+}
+
+void LooseOctree::insertItem(uint32_t itemIndex, bool updateSubtreeAABBs)
+{
+    const AABB3 &aabb = itemAABBs[itemIndex];
+    uint32_t nodeIndex = 0;
+    if (updateSubtreeAABBs) {
+        nodes[nodeIndex].subtreeAABB.combine(aabb);
+    }
+    while (nodes[nodeIndex].firstChild >= 0) {
+        int32_t childIndex = getChildForItem(nodes[nodeIndex], aabb);
+        if (childIndex < 0) {
+            break;
+        }
+        nodeIndex = uint32_t(childIndex);
+        if (updateSubtreeAABBs) {
+            nodes[nodeIndex].subtreeAABB.combine(aabb);
+        }
+    }
+
+    LooseOctreeNode &node = nodes[nodeIndex];
+    node.items.push_back(itemIndex);
+    if (node.firstChild < 0 && node.items.size() > maxItemsPerNode && node.depth < maxDepth) {
+        splitNode(nodeIndex);
+    }
+}
+
+void LooseOctree::splitNode(uint32_t nodeIndex)
+{
+    const int32_t firstChild = int32_t(nodes.size());
+    const glm::vec3 center = nodes[nodeIndex].center;
+    const float childHalfSize = nodes[nodeIndex].halfSize * 0.5f;
+    const uint32_t childDepth = nodes[nodeIndex].depth + 1;
+    for (int octant = 0; octant < 8; octant++) {
+        LooseOctreeNode child;
+        child.center = center + childHalfSize * glm::vec3(
+                (octant & 1) ? 1.0f : -1.0f, (octant & 2) ? 1.0f : -1.0f, (octant & 4) ? 1.0f : -1.0f);
+        child.halfSize = childHalfSize;
+        child.firstChild = -1;
+        child.depth = childDepth;
+        nodes.push_back(child);
+    }
+
+    // Move the items fitting into a child down (the references into nodes are only valid after the push_back calls)
+    LooseOctreeNode &node = nodes[nodeIndex];
+    node.firstChild = firstChild;
+    std::vector<uint32_t> remainingItems;
+    for (uint32_t itemIndex : node.items) {
+        int32_t childIndex = getChildForItem(node, itemAABBs[itemIndex]);
+        if (childIndex < 0) {
+            remainingItems.push_back(itemIndex);
+        } else {
+            nodes[childIndex].items.push_back(itemIndex);
+            nodes[childIndex].subtreeAABB.combine(itemAABBs[itemIndex]);
+        }
+    }
+    node.items.swap(remainingItems);
+
+    for (int32_t childIndex = firstChild; childIndex < firstChild + 8; childIndex++) {
+        if (nodes[childIndex].items.size() > maxItemsPerNode && childDepth < maxDepth) {
+            splitNode(uint32_t(childIndex));
+        }
+    }
+}
+
+float LooseOctree::getDistanceSquared(const AABB3 &aabb, const glm::vec3 &point)
+{
+    glm::vec3 diff = glm::max(glm::max(aabb.min - point, point - aabb.max), glm::vec3(0.0f));
+    return glm::dot(diff, diff);
+}
+
+static inline bool aabbsOverlap(const AABB3 &aabb0, const AABB3 &aabb1)
+{
+    return aabb0.min.x <= aabb1.max.x && aabb0.min.y <= aabb1.max.y && aabb0.min.z <= aabb1.max.z
+            && aabb1.min.x <= aabb0.max.x && aabb1.min.y <= aabb0.max.y && aabb1.min.z <= aabb0.max.z;
+}
+
+void LooseOctree::queryAABB(const AABB3 &aabb, std::vector<uint32_t> &itemIndices) const
+{
+    itemIndices.clear();
+    std::vector<uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const LooseOctreeNode &node = nodes[stack.back()];
+        stack.pop_back();
+        if (!aabbsOverlap(node.subtreeAABB, aabb)) {
+            continue;
+        }
+        for (uint32_t itemIndex : node.items) {
+            if (aabbsOverlap(itemAABBs[itemIndex], aabb)) {
+                itemIndices.push_back(itemIndex);
+            }
+        }
+        if (node.firstChild >= 0) {
+            for (int32_t childIndex = node.firstChild; childIndex < node.firstChild + 8; childIndex++) {
+                stack.push_back(uint32_t(childIndex));
+            }
+        }
+    }
+}
+
+void LooseOctree::queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &itemIndices) const
+{
+    itemIndices.clear();
+    const float radiusSquared = radius * radius;
+    std::vector<uint32_t> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const LooseOctreeNode &node = nodes[stack.back()];
+        stack.pop_back();
+        if (getDistanceSquared(node.subtreeAABB, center) > radiusSquared) {
+            continue;
+        }
+        for (uint32_t itemIndex : node.items) {
+            if (getDistanceSquared(itemAABBs[itemIndex], center) <= radiusSquared) {
+                itemIndices.push_back(itemIndex);
+            }
+        }
+        if (node.firstChild >= 0) {
+            for (int32_t childIndex = node.firstChild; childIndex < node.firstChild + 8; childIndex++) {
+                stack.push_back(uint32_t(childIndex));
+            }
+        }
+    }
+}
+
+void LooseOctree::queryKNearest(const glm::vec3 &center, size_t k, std::vector<uint32_t> &itemIndices) const
+{
+    itemIndices.clear();
+    if (k == 0) {
+        return;
+    }
+
+    // Best-first search over the nodes ordered by the distance to the bounds of their subtrees. The search stops when
+    // the next node is farther away than the k-th closest item found so far.
+    typedef std::pair<float, uint32_t> DistanceIndexPair;
+    std::priority_queue<DistanceIndexPair, std::vector<DistanceIndexPair>, std::greater<DistanceIndexPair>> nodeQueue;
+    std::priority_queue<DistanceIndexPair> closestItems;
+    nodeQueue.push(DistanceIndexPair(0.0f, 0));
+    while (!nodeQueue.empty()) {
+        DistanceIndexPair nodeEntry = nodeQueue.top();
+        nodeQueue.pop();
+        if (closestItems.size() == k && nodeEntry.first > closestItems.top().first) {
+            break;
+        }
+
+        const LooseOctreeNode &node = nodes[nodeEntry.second];
+        for (uint32_t itemIndex : node.items) {
+            float distanceSquared = getDistanceSquared(itemAABBs[itemIndex], center);
+            if (closestItems.size() < k) {
+                closestItems.push(DistanceIndexPair(distanceSquared, itemIndex));
+            } else if (distanceSquared < closestItems.top().first) {
+                closestItems.pop();
+                closestItems.push(DistanceIndexPair(distanceSquared, itemIndex));
+            }
+        }
+        if (node.firstChild >= 0) {
+            for (int32_t childIndex = node.firstChild; childIndex < node.firstChild + 8; childIndex++) {
+                const LooseOctreeNode &child = nodes[childIndex];
+                if (child.items.empty() && child.firstChild < 0) {
+                    continue;
+                }
+                float distanceSquared = getDistanceSquared(child.subtreeAABB, center);
+                if (closestItems.size() < k || distanceSquared <= closestItems.top().first) {
+                    nodeQueue.push(DistanceIndexPair(distanceSquared, uint32_t(childIndex)));
+                }
+            }
+        }
+    }
+
+    itemIndices.resize(closestItems.size());
+    for (size_t i = closestItems.size(); i > 0; i--) {
+        itemIndices[i - 1] = closestItems.top().second;
+        closestItems.pop();
+    }
+}
+
+}
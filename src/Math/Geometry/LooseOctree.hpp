@@ -0,0 +1,87 @@
+/*!
+ * LooseOctree.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_MATH_GEOMETRY_LOOSEOCTREE_HPP_
+#define SRC_MATH_GEOMETRY_LOOSEOCTREE_HPP_
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <Defs.hpp>
+#include "AABB3.hpp"
+
+namespace sgl {
+
+struct DLL_OBJECT LooseOctreeNode {
+    glm::vec3 center;
+    float halfSize;
+    //! Index of the first of the eight children (stored consecutively), or -1 for leaves
+    int32_t firstChild;
+    uint32_t depth;
+    //! Bounds of all items in the subtree (tighter than the loose bounds, so the queries use them for culling)
+    AABB3 subtreeAABB;
+    std::vector<uint32_t> items;
+};
+
+/*! Loose octree over items with bounding boxes (e.g. line segments) or points.
+ * The bounds of every node are enlarged by the looseness factor, so an item is stored in the deepest node whose
+ * (tight) cube contains the item center and whose loose bounds contain the whole item. This way, every item is
+ * stored exactly once. Nodes are split when they contain more than maxItemsPerNode items. Items outside of the
+ * bounds passed to the constructor are stored in the root node. The queries cull nodes using the bounds of the items
+ * in their subtree. All queries return the item indices, i.e., the order in which the items were inserted. */
+class DLL_OBJECT LooseOctree {
+public:
+    /*! \param bounds The region covered by the octree (it is extended to a cube).
+     * \param looseness Factor the node bounds are enlarged by (values in [1.5, 2] are a good choice). */
+    explicit LooseOctree(const AABB3 &bounds, size_t maxDepth = 10, size_t maxItemsPerNode = 16,
+            float looseness = 2.0f);
+
+    //! Returns the index of the item.
+    uint32_t insert(const AABB3 &aabb);
+    inline uint32_t insert(const glm::vec3 &point) { return insert(AABB3(point, point)); }
+    /*! Bulk insert. The items get consecutive indices starting at getNumItems(). This is faster than inserting the
+     * items one by one, as the items are inserted in spatially coherent order. */
+    void insert(const std::vector<AABB3> &aabbs);
+    void insert(const std::vector<glm::vec3> &points);
+    void clear();
+
+    //! All items whose bounding boxes overlap with the passed box.
+    void queryAABB(const AABB3 &aabb, std::vector<uint32_t> &itemIndices) const;
+    //! All items whose bounding boxes have a distance of at most radius to center.
+    void queryRadius(const glm::vec3 &center, float radius, std::vector<uint32_t> &itemIndices) const;
+    //! The k items whose bounding boxes are closest to center sorted by distance.
+    void queryKNearest(const glm::vec3 &center, size_t k, std::vector<uint32_t> &itemIndices) const;
+
+    inline const AABB3 &getItemAABB(uint32_t itemIndex) const { return itemAABBs.at(itemIndex); }
+    inline size_t getNumItems() const { return itemAABBs.size(); }
+    inline const std::vector<LooseOctreeNode> &getNodes() const { return nodes; }
+
+private:
+    //! Returns the child of the node containing the item, or -1 if the item needs to stay in the node.
+    int32_t getChildForItem(const LooseOctreeNode &node, const AABB3 &aabb) const;
+    //! If updateSubtreeAABBs is false, recomputeSubtreeAABBs needs to be called after inserting.
+    void insertItem(uint32_t itemIndex, bool updateSubtreeAABBs);
+    //! Inserts the items [firstItem, firstItem + numItems) of itemAABBs.
+    void insertItemsSorted(uint32_t firstItem, uint32_t numItems);
+    //! Checks whether numNewItems more items fit (and writes an error to the log file otherwise).
+    bool checkNumItems(size_t numNewItems);
+    void recomputeSubtreeAABBs();
+    void splitNode(uint32_t nodeIndex);
+    static float getDistanceSquared(const AABB3 &aabb, const glm::vec3 &point);
+
+    size_t maxDepth;
+    size_t maxItemsPerNode;
+    float looseness;
+    AABB3 bounds;
+    std::vector<LooseOctreeNode> nodes;
+    std::vector<AABB3> itemAABBs;
+};
+
+}
+
+/*! SRC_MATH_GEOMETRY_LOOSEOCTREE_HPP_ */
+#endif
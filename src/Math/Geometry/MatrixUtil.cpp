@@ -6,6 +6,13 @@
  */
 
 #include "MatrixUtil.hpp"
+#include "MatrixUtilKernels.hpp"
+#include <algorithm>
+#include <Utils/CpuFeatures.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 namespace sgl {
 
@@ -34,6 +41,196 @@ glm::vec2 transformDirection(const glm::mat4 &mat, const glm::vec2 &vec) {
 }
 
 
+//! Arrays smaller than this are transformed on one thread, larger arrays are split into chunks of this size.
+#define TRANSFORM_PARALLEL_CHUNK_SIZE (size_t(1) << 16)
+
+/*! Kernels using instruction sets above the baseline of the build. They are compiled in separate files with the
+ * corresponding ISA flags and selected at runtime depending on the CPU. */
+static const KernelTable<TransformAoSKernel> transformAoSKernels(
+        nullptr, nullptr, SGL_AVX2_KERNEL(transformAoSAVX2));
+static const KernelTable<TransformSoAKernel> transformSoAKernels(
+        nullptr, nullptr, SGL_AVX2_KERNEL(transformSoAAVX2), SGL_AVX512_KERNEL(transformSoAAVX512));
+
+static BatchTransform getBatchTransform(const glm::mat4 &mat, bool isPoint)
+{
+    BatchTransform transform;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            transform.c[i][j] = (i == 3 && !isPoint) ? 0.0f : mat[i][j];
+        }
+    }
+    transform.divide = isPoint && (mat[0][3] != 0.0f || mat[1][3] != 0.0f || mat[2][3] != 0.0f || mat[3][3] != 1.0f);
+    return transform;
+}
+
+static inline void transformScalar(const BatchTransform &t, float x, float y, float z,
+        float &outX, float &outY, float &outZ)
+{
+    float tx = t.c[0][0] * x + t.c[1][0] * y + t.c[2][0] * z + t.c[3][0];
+    float ty = t.c[0][1] * x + t.c[1][1] * y + t.c[2][1] * z + t.c[3][1];
+    float tz = t.c[0][2] * x + t.c[1][2] * y + t.c[2][2] * z + t.c[3][2];
+    if (t.divide) {
+        float tw = t.c[0][3] * x + t.c[1][3] * y + t.c[2][3] * z + t.c[3][3];
+        if (tw != 1.0f) {
+            tx /= tw; ty /= tw; tz /= tw;
+        }
+    }
+    outX = tx; outY = ty; outZ = tz;
+}
+
+/*
+ * The array of structures kernels load four consecutive vectors as a = (x0 y0 z0 x1), b = (y1 z1 x2 y2),
+ * c = (z2 x3 y3 z3), transpose them to x, y and z registers, and transpose the results back before storing them.
+ * All kernels return the number of vectors processed, the remaining ones are transformed using transformScalar.
+ */
+#ifdef __SSE2__
+#define SHUFFLE_XXYY(a, b, i, j) _mm_shuffle_ps(a, b, _MM_SHUFFLE(j, j, i, i))
+#define SHUFFLE_EVEN(a, b) _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))
+
+static inline void transformVectorsSSE2(const BatchTransform &t, __m128 &x, __m128 &y, __m128 &z)
+{
+    __m128 tx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[0][0]), x), _mm_mul_ps(_mm_set1_ps(t.c[1][0]), y)),
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[2][0]), z), _mm_set1_ps(t.c[3][0])));
+    __m128 ty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[0][1]), x), _mm_mul_ps(_mm_set1_ps(t.c[1][1]), y)),
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[2][1]), z), _mm_set1_ps(t.c[3][1])));
+    __m128 tz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[0][2]), x), _mm_mul_ps(_mm_set1_ps(t.c[1][2]), y)),
+            _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[2][2]), z), _mm_set1_ps(t.c[3][2])));
+    if (t.divide) {
+        __m128 tw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[0][3]), x),
+                _mm_mul_ps(_mm_set1_ps(t.c[1][3]), y)),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.c[2][3]), z), _mm_set1_ps(t.c[3][3])));
+        tx = _mm_div_ps(tx, tw); ty = _mm_div_ps(ty, tw); tz = _mm_div_ps(tz, tw);
+    }
+    x = tx; y = ty; z = tz;
+}
+
+static size_t transformAoSSSE2(const BatchTransform &t, const float *in, float *out, size_t numVectors)
+{
+    size_t i = 0;
+    for (; i + 4 <= numVectors; i += 4) {
+        __m128 a = _mm_loadu_ps(in + i * 3), b = _mm_loadu_ps(in + i * 3 + 4), c = _mm_loadu_ps(in + i * 3 + 8);
+        __m128 x = _mm_shuffle_ps(a, SHUFFLE_XXYY(b, c, 2, 1), _MM_SHUFFLE(2, 0, 3, 0));
+        __m128 y = SHUFFLE_EVEN(SHUFFLE_XXYY(a, b, 1, 0), SHUFFLE_XXYY(b, c, 3, 2));
+        __m128 z = SHUFFLE_EVEN(SHUFFLE_XXYY(a, b, 2, 1), SHUFFLE_XXYY(c, c, 0, 3));
+        transformVectorsSSE2(t, x, y, z);
+        _mm_storeu_ps(out + i * 3, SHUFFLE_EVEN(SHUFFLE_XXYY(x, y, 0, 0), SHUFFLE_XXYY(z, x, 0, 1)));
+        _mm_storeu_ps(out + i * 3 + 4, SHUFFLE_EVEN(SHUFFLE_XXYY(y, z, 1, 1), SHUFFLE_XXYY(x, y, 2, 2)));
+        _mm_storeu_ps(out + i * 3 + 8, SHUFFLE_EVEN(SHUFFLE_XXYY(z, x, 2, 3), SHUFFLE_XXYY(y, z, 3, 3)));
+    }
+    return i;
+}
+
+static size_t transformSoASSE2(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors)
+{
+    size_t i = 0;
+    for (; i + 4 <= numVectors; i += 4) {
+        __m128 x = _mm_loadu_ps(inX + i), y = _mm_loadu_ps(inY + i), z = _mm_loadu_ps(inZ + i);
+        transformVectorsSSE2(t, x, y, z);
+        _mm_storeu_ps(outX + i, x); _mm_storeu_ps(outY + i, y); _mm_storeu_ps(outZ + i, z);
+    }
+    return i;
+}
+#undef SHUFFLE_XXYY
+#undef SHUFFLE_EVEN
+#endif
+
+static void transformAoS(const BatchTransform &t, const float *in, float *out, size_t numVectors)
+{
+    size_t i = 0;
+    TransformAoSKernel kernel = transformAoSKernels.get();
+    if (kernel != nullptr) {
+        i = kernel(t, in, out, numVectors);
+    }
+#ifdef __SSE2__
+    i += transformAoSSSE2(t, in + i * 3, out + i * 3, numVectors - i);
+#endif
+    for (; i < numVectors; i++) {
+        transformScalar(t, in[i * 3], in[i * 3 + 1], in[i * 3 + 2], out[i * 3], out[i * 3 + 1], out[i * 3 + 2]);
+    }
+}
+
+static void transformSoA(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors)
+{
+    size_t i = 0;
+    TransformSoAKernel kernel = transformSoAKernels.get();
+    if (kernel != nullptr) {
+        i = kernel(t, inX, inY, inZ, outX, outY, outZ, numVectors);
+    }
+#ifdef __SSE2__
+    i += transformSoASSE2(t, inX + i, inY + i, inZ + i, outX + i, outY + i, outZ + i, numVectors - i);
+#endif
+    for (; i < numVectors; i++) {
+        transformScalar(t, inX[i], inY[i], inZ[i], outX[i], outY[i], outZ[i]);
+    }
+}
+
+static void transformAoSParallel(const BatchTransform &t, const glm::vec3 *in, glm::vec3 *out, size_t numVectors)
+{
+    const float *inData = &in->x;
+    float *outData = &out->x;
+    if (numVectors <= TRANSFORM_PARALLEL_CHUNK_SIZE) {
+        transformAoS(t, inData, outData, numVectors);
+        return;
+    }
+    const size_t numChunks = (numVectors - 1) / TRANSFORM_PARALLEL_CHUNK_SIZE + 1;
+    #pragma omp parallel for shared(t, inData, outData, numVectors, numChunks) default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t first = chunkIdx * TRANSFORM_PARALLEL_CHUNK_SIZE;
+        size_t numChunkVectors = std::min(TRANSFORM_PARALLEL_CHUNK_SIZE, numVectors - first);
+        transformAoS(t, inData + first * 3, outData + first * 3, numChunkVectors);
+    }
+}
+
+static void transformSoAParallel(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors)
+{
+    if (numVectors <= TRANSFORM_PARALLEL_CHUNK_SIZE) {
+        transformSoA(t, inX, inY, inZ, outX, outY, outZ, numVectors);
+        return;
+    }
+    const size_t numChunks = (numVectors - 1) / TRANSFORM_PARALLEL_CHUNK_SIZE + 1;
+    #pragma omp parallel for shared(t, inX, inY, inZ, outX, outY, outZ, numVectors, numChunks) default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t first = chunkIdx * TRANSFORM_PARALLEL_CHUNK_SIZE;
+        size_t numChunkVectors = std::min(TRANSFORM_PARALLEL_CHUNK_SIZE, numVectors - first);
+        transformSoA(t, inX + first, inY + first, inZ + first, outX + first, outY + first, outZ + first,
+                numChunkVectors);
+    }
+}
+
+void transformPoints(const glm::mat4 &mat, const glm::vec3 *points, glm::vec3 *transformedPoints, size_t numPoints)
+{
+    if (numPoints == 0) {
+        return;
+    }
+    transformAoSParallel(getBatchTransform(mat, true), points, transformedPoints, numPoints);
+}
+
+void transformDirections(const glm::mat4 &mat, const glm::vec3 *directions, glm::vec3 *transformedDirections,
+        size_t numDirections)
+{
+    if (numDirections == 0) {
+        return;
+    }
+    transformAoSParallel(getBatchTransform(mat, false), directions, transformedDirections, numDirections);
+}
+
+void transformPoints(const glm::mat4 &mat, const float *x, const float *y, const float *z,
+        float *transformedX, float *transformedY, float *transformedZ, size_t numPoints)
+{
+    transformSoAParallel(getBatchTransform(mat, true), x, y, z, transformedX, transformedY, transformedZ, numPoints);
+}
+
+void transformDirections(const glm::mat4 &mat, const float *x, const float *y, const float *z,
+        float *transformedX, float *transformedY, float *transformedZ, size_t numDirections)
+{
+    transformSoAParallel(getBatchTransform(mat, false), x, y, z, transformedX, transformedY, transformedZ,
+            numDirections);
+}
+
+
 DLL_OBJECT glm::mat4 matrixTranslation(const glm::vec3 &v) {
     /*return glm::translate(glm::vec3(v.x, v.y, v.z));*/
     return glm::mat4(1.0f, 0.0f, 0.0f, 0.0f,
@@ -20,6 +20,26 @@ glm::vec3 transformDirection(const glm::mat4 &mat, const glm::vec3 &vec);
 glm::vec2 transformPoint(const glm::mat4 &mat, const glm::vec2 &vec);
 glm::vec2 transformDirection(const glm::mat4 &mat, const glm::vec2 &vec);
 
+/*! Batch versions of transformPoint/transformDirection for contiguous arrays. The results are the same as the ones of
+ * the single vector functions (up to rounding, as fused multiply-adds may be used). The kernels use SSE2, or AVX2/FMA
+ * and AVX-512 if the CPU supports them (see CpuFeatures.hpp), and large arrays are split across threads. The input and output arrays may be the
+ * same (i.e., in-place transformation), but must not overlap otherwise. */
+DLL_OBJECT void transformPoints(const glm::mat4 &mat, const glm::vec3 *points, glm::vec3 *transformedPoints,
+        size_t numPoints);
+DLL_OBJECT void transformDirections(const glm::mat4 &mat, const glm::vec3 *directions,
+        glm::vec3 *transformedDirections, size_t numDirections);
+inline void transformPointsInPlace(const glm::mat4 &mat, glm::vec3 *points, size_t numPoints) {
+    transformPoints(mat, points, points, numPoints);
+}
+inline void transformDirectionsInPlace(const glm::mat4 &mat, glm::vec3 *directions, size_t numDirections) {
+    transformDirections(mat, directions, directions, numDirections);
+}
+//! Batch transformation of vectors stored in structure of arrays layout.
+DLL_OBJECT void transformPoints(const glm::mat4 &mat, const float *x, const float *y, const float *z,
+        float *transformedX, float *transformedY, float *transformedZ, size_t numPoints);
+DLL_OBJECT void transformDirections(const glm::mat4 &mat, const float *x, const float *y, const float *z,
+        float *transformedX, float *transformedY, float *transformedZ, size_t numDirections);
+
 //! Special types of matrices
 inline     glm::mat4 matrixIdentity() {return glm::mat4(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);}
 inline     glm::mat4 matrixZero() {return glm::mat4(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);}
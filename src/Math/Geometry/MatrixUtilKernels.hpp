@@ -0,0 +1,47 @@
+/*!
+ * MatrixUtilKernels.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SRC_MATH_GEOMETRY_MATRIXUTILKERNELS_HPP_
+#define SRC_MATH_GEOMETRY_MATRIXUTILKERNELS_HPP_
+
+#include <cstddef>
+
+/*
+ * Internal interface between MatrixUtil.cpp and the batch transformation kernels compiled with ISA flags
+ * (MatrixUtil_AVX2.cpp, MatrixUtil_AVX512.cpp). This header is included by the kernel files, so it must not include
+ * glm or other headers with inline functions (see CpuFeatures.hpp).
+ */
+
+namespace sgl {
+
+/*! Matrix columns for a batch transformation. For directions, the translation column is zero. The homogeneous
+ * division is only necessary for points transformed with a projective matrix (i.e., last row != (0, 0, 0, 1)). */
+struct BatchTransform {
+    float c[4][4];
+    bool divide;
+};
+
+//! The kernels return the number of vectors processed, the remaining ones are transformed by the caller.
+typedef size_t (*TransformAoSKernel)(const BatchTransform &t, const float *in, float *out, size_t numVectors);
+typedef size_t (*TransformSoAKernel)(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors);
+
+#ifdef SGL_AVX2_KERNELS
+size_t transformAoSAVX2(const BatchTransform &t, const float *in, float *out, size_t numVectors);
+size_t transformSoAAVX2(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors);
+#endif
+
+#ifdef SGL_AVX512_KERNELS
+size_t transformSoAAVX512(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors);
+#endif
+
+}
+
+/*! SRC_MATH_GEOMETRY_MATRIXUTILKERNELS_HPP_ */
+#endif
@@ -0,0 +1,79 @@
+/*
+ * MatrixUtil_AVX2.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MatrixUtilKernels.hpp"
+
+// MSVC doesn't define __FMA__, but /arch:AVX2 enables the FMA instructions as well.
+#if defined(SGL_AVX2_KERNELS) && defined(__AVX2__) && (defined(__FMA__) || defined(_MSC_VER))
+#include <immintrin.h>
+
+namespace sgl {
+
+/*
+ * The array of structures kernel works like the SSE2 kernel in MatrixUtil.cpp (i.e., transposes the loaded vectors to
+ * x, y and z registers and back) in both 128-bit lanes with the vectors 0-3 in the lower and 4-7 in the upper lane.
+ */
+#define SHUFFLE_XXYY(a, b, i, j) _mm256_shuffle_ps(a, b, _MM_SHUFFLE(j, j, i, i))
+#define SHUFFLE_EVEN(a, b) _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))
+
+static inline void transformVectorsAVX2(const BatchTransform &t, __m256 &x, __m256 &y, __m256 &z)
+{
+    __m256 tx = _mm256_fmadd_ps(_mm256_set1_ps(t.c[0][0]), x, _mm256_fmadd_ps(_mm256_set1_ps(t.c[1][0]), y,
+            _mm256_fmadd_ps(_mm256_set1_ps(t.c[2][0]), z, _mm256_set1_ps(t.c[3][0]))));
+    __m256 ty = _mm256_fmadd_ps(_mm256_set1_ps(t.c[0][1]), x, _mm256_fmadd_ps(_mm256_set1_ps(t.c[1][1]), y,
+            _mm256_fmadd_ps(_mm256_set1_ps(t.c[2][1]), z, _mm256_set1_ps(t.c[3][1]))));
+    __m256 tz = _mm256_fmadd_ps(_mm256_set1_ps(t.c[0][2]), x, _mm256_fmadd_ps(_mm256_set1_ps(t.c[1][2]), y,
+            _mm256_fmadd_ps(_mm256_set1_ps(t.c[2][2]), z, _mm256_set1_ps(t.c[3][2]))));
+    if (t.divide) {
+        __m256 tw = _mm256_fmadd_ps(_mm256_set1_ps(t.c[0][3]), x, _mm256_fmadd_ps(_mm256_set1_ps(t.c[1][3]), y,
+                _mm256_fmadd_ps(_mm256_set1_ps(t.c[2][3]), z, _mm256_set1_ps(t.c[3][3]))));
+        tx = _mm256_div_ps(tx, tw); ty = _mm256_div_ps(ty, tw); tz = _mm256_div_ps(tz, tw);
+    }
+    x = tx; y = ty; z = tz;
+}
+
+size_t transformAoSAVX2(const BatchTransform &t, const float *in, float *out, size_t numVectors)
+{
+    size_t i = 0;
+    for (; i + 8 <= numVectors; i += 8) {
+        const float *p = in + i * 3;
+        __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+        __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+        __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+        __m256 x = _mm256_shuffle_ps(a, SHUFFLE_XXYY(b, c, 2, 1), _MM_SHUFFLE(2, 0, 3, 0));
+        __m256 y = SHUFFLE_EVEN(SHUFFLE_XXYY(a, b, 1, 0), SHUFFLE_XXYY(b, c, 3, 2));
+        __m256 z = SHUFFLE_EVEN(SHUFFLE_XXYY(a, b, 2, 1), SHUFFLE_XXYY(c, c, 0, 3));
+        transformVectorsAVX2(t, x, y, z);
+        a = SHUFFLE_EVEN(SHUFFLE_XXYY(x, y, 0, 0), SHUFFLE_XXYY(z, x, 0, 1));
+        b = SHUFFLE_EVEN(SHUFFLE_XXYY(y, z, 1, 1), SHUFFLE_XXYY(x, y, 2, 2));
+        c = SHUFFLE_EVEN(SHUFFLE_XXYY(z, x, 2, 3), SHUFFLE_XXYY(y, z, 3, 3));
+        float *q = out + i * 3;
+        _mm_storeu_ps(q, _mm256_castps256_ps128(a)); _mm_storeu_ps(q + 12, _mm256_extractf128_ps(a, 1));
+        _mm_storeu_ps(q + 4, _mm256_castps256_ps128(b)); _mm_storeu_ps(q + 16, _mm256_extractf128_ps(b, 1));
+        _mm_storeu_ps(q + 8, _mm256_castps256_ps128(c)); _mm_storeu_ps(q + 20, _mm256_extractf128_ps(c, 1));
+    }
+    return i;
+}
+
+size_t transformSoAAVX2(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors)
+{
+    size_t i = 0;
+    for (; i + 8 <= numVectors; i += 8) {
+        __m256 x = _mm256_loadu_ps(inX + i), y = _mm256_loadu_ps(inY + i), z = _mm256_loadu_ps(inZ + i);
+        transformVectorsAVX2(t, x, y, z);
+        _mm256_storeu_ps(outX + i, x); _mm256_storeu_ps(outY + i, y); _mm256_storeu_ps(outZ + i, z);
+    }
+    return i;
+}
+
+#undef SHUFFLE_XXYY
+#undef SHUFFLE_EVEN
+
+}
+
+#endif
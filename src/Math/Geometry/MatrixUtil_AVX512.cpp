@@ -0,0 +1,44 @@
+/*
+ * MatrixUtil_AVX512.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MatrixUtilKernels.hpp"
+
+#if defined(SGL_AVX512_KERNELS) && defined(__AVX512F__)
+#include <immintrin.h>
+
+namespace sgl {
+
+// The array of structures transformation has no AVX-512 kernel, as the AVX2 kernel is already limited by the shuffles.
+size_t transformSoAAVX512(const BatchTransform &t, const float *inX, const float *inY, const float *inZ,
+        float *outX, float *outY, float *outZ, size_t numVectors)
+{
+    __m512 c[4][4];
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            c[i][j] = _mm512_set1_ps(t.c[i][j]);
+        }
+    }
+
+    size_t i = 0;
+    for (; i + 16 <= numVectors; i += 16) {
+        __m512 x = _mm512_loadu_ps(inX + i), y = _mm512_loadu_ps(inY + i), z = _mm512_loadu_ps(inZ + i);
+        __m512 tx = _mm512_fmadd_ps(c[0][0], x, _mm512_fmadd_ps(c[1][0], y, _mm512_fmadd_ps(c[2][0], z, c[3][0])));
+        __m512 ty = _mm512_fmadd_ps(c[0][1], x, _mm512_fmadd_ps(c[1][1], y, _mm512_fmadd_ps(c[2][1], z, c[3][1])));
+        __m512 tz = _mm512_fmadd_ps(c[0][2], x, _mm512_fmadd_ps(c[1][2], y, _mm512_fmadd_ps(c[2][2], z, c[3][2])));
+        if (t.divide) {
+            __m512 tw = _mm512_fmadd_ps(c[0][3], x, _mm512_fmadd_ps(c[1][3], y,
+                    _mm512_fmadd_ps(c[2][3], z, c[3][3])));
+            tx = _mm512_div_ps(tx, tw); ty = _mm512_div_ps(ty, tw); tz = _mm512_div_ps(tz, tw);
+        }
+        _mm512_storeu_ps(outX + i, tx); _mm512_storeu_ps(outY + i, ty); _mm512_storeu_ps(outZ + i, tz);
+    }
+    return i;
+}
+
+}
+
+#endif
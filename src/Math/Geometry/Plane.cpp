@@ -21,7 +21,8 @@ bool Plane::isOutside(const glm::vec3 &pt) const {
 bool Plane::isOutside(const AABB3 &aabb) const {
     glm::vec3 extent = aabb.getExtent();
     float centerDist = getDistance(aabb.getCenter());
-    float maxAbsDist = fabs(a*extent.x + b*extent.y + c*extent.z);
+    // Projected radius of the box onto the plane normal
+    float maxAbsDist = fabs(a)*extent.x + fabs(b)*extent.y + fabs(c)*extent.z;
     return -centerDist > maxAbsDist;
 }
 
@@ -6,7 +6,9 @@
  */
 
 #include "Plane.hpp"
+#include "AABB3.hpp"
 #include "Ray3.hpp"
+#include <algorithm>
 
 namespace sgl {
 
@@ -24,4 +26,18 @@ RaycastResult Ray3::intersects(const Plane &plane) const {
     }
 }
 
+RaycastResult Ray3::intersects(const AABB3 &aabb) const {
+    // Division by zero results in +-infinity, which the min/max operations below handle correctly
+    glm::vec3 inverseDirection = 1.0f / this->direction;
+    glm::vec3 t0 = (aabb.min - this->origin) * inverseDirection;
+    glm::vec3 t1 = (aabb.max - this->origin) * inverseDirection;
+    glm::vec3 tMin = glm::min(t0, t1), tMax = glm::max(t0, t1);
+    float tEnter = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+    float tExit = std::min(std::min(tMax.x, tMax.y), tMax.z);
+    if (tEnter <= tExit) {
+        return RaycastResult(true, tEnter);
+    }
+    return RaycastResult(false, 0.0f);
+}
+
 }
@@ -27,6 +27,11 @@ public:
     Ray3(const glm::vec3 &origin, const glm::vec3 &direction) : origin(origin), direction(direction) {}
 
     RaycastResult intersects(const Plane &plane) const;
+    /*! Slab test. Returns the ray parameter where the ray enters the box (or 0 if the origin lies inside).
+     * Intersections behind the origin are ignored. */
+    RaycastResult intersects(const AABB3 &aabb) const;
+    inline const glm::vec3 &getOrigin() const { return origin; }
+    inline const glm::vec3 &getDirection() const { return direction; }
     inline glm::vec3 getPoint(float t) const { return origin + direction * t; }
     inline glm::vec2 getPoint2D(float t) const { glm::vec3 pt3d = getPoint(t); return glm::vec2(pt3d.x, pt3d.y); }
 
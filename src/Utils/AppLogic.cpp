@@ -17,10 +17,77 @@
 #include <Utils/File/Logfile.hpp>
 #include <Utils/File/FileUtils.hpp>
 #include <Graphics/Renderer.hpp>
+#include <Utils/TraceRecorder.hpp>
 #include <string>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 namespace sgl {
 
+/// Thread that runs batches of fixed updates of an AppLogic object (see AppLogic::setFixedUpdateOnWorkerThread).
+class FixedUpdateWorker
+{
+public:
+    explicit FixedUpdateWorker(AppLogic *appLogic) : appLogic(appLogic) {
+        thread = std::thread(&FixedUpdateWorker::run, this);
+    }
+    ~FixedUpdateWorker() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            quit = true;
+        }
+        conditionVariable.notify_all();
+        thread.join();
+    }
+
+    /// Starts numSteps fixed updates. The previous batch needs to have finished (see wait).
+    void launch(int numSteps, float dt) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->numSteps = numSteps;
+            this->dt = dt;
+            busy = true;
+        }
+        conditionVariable.notify_all();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        conditionVariable.wait(lock, [this] { return !busy; });
+    }
+
+private:
+    void run() {
+        SGL_TRACE_THREAD_NAME("Fixed Update");
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            conditionVariable.wait(lock, [this] { return busy || quit; });
+            if (quit) {
+                return;
+            }
+            lock.unlock();
+            for (int i = 0; i < numSteps; i++) {
+                SGL_TRACE_SCOPE("AppLogic::updateFixed");
+                appLogic->updateFixed(dt);
+            }
+            lock.lock();
+            busy = false;
+            conditionVariable.notify_all();
+        }
+    }
+
+    AppLogic *appLogic;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bool busy = false;
+    bool quit = false;
+    int numSteps = 0;
+    float dt = 0.0f;
+};
+
 AppLogic::AppLogic() : framerateSmoother(16)
 {
     Timer->setFixedPhysicsFPS(true, 30);
@@ -34,6 +101,60 @@ AppLogic::AppLogic() : framerateSmoother(16)
 
 AppLogic::~AppLogic()
 {
+    fixedUpdateWorker = std::unique_ptr<FixedUpdateWorker>();
+}
+
+void AppLogic::setFixedUpdateOnWorkerThread(bool useWorkerThread)
+{
+    if (useWorkerThread && !fixedUpdateWorker) {
+        fixedUpdateWorker = std::unique_ptr<FixedUpdateWorker>(new FixedUpdateWorker(this));
+    } else if (!useWorkerThread && fixedUpdateWorker) {
+        fixedUpdateWorker->wait();
+        fixedUpdateWorker = std::unique_ptr<FixedUpdateWorker>();
+    }
+}
+
+void AppLogic::waitForFixedUpdates()
+{
+    if (fixedUpdateWorker) {
+        SGL_TRACE_SCOPE("AppLogic::waitForFixedUpdates");
+        fixedUpdateWorker->wait();
+    }
+}
+
+void AppLogic::scheduleFixedUpdates(uint64_t elapsedMicroseconds)
+{
+    int numSteps;
+    float stepSeconds;
+    if (Timer->getFixedPhysicsFPSEnabled() && Timer->getFixedPhysicsFPS() > 0) {
+        // Integer nanoseconds, so no time is lost to rounding errors
+        const uint64_t stepNS = 1000000000ull / Timer->getFixedPhysicsFPS();
+        accumulatedTimeFixedNS += elapsedMicroseconds * 1000ull;
+        uint64_t numStepsDue = accumulatedTimeFixedNS / stepNS;
+        if (numStepsDue > uint64_t(maxFixedUpdateCatchUpSteps)) {
+            // Drop the time we cannot catch up with
+            numStepsDue = uint64_t(std::max(maxFixedUpdateCatchUpSteps, 0));
+            accumulatedTimeFixedNS = numStepsDue * stepNS + accumulatedTimeFixedNS % stepNS;
+        }
+        accumulatedTimeFixedNS -= numStepsDue * stepNS;
+        numSteps = int(numStepsDue);
+        stepSeconds = float(double(stepNS) * 1e-9);
+        fixedUpdateInterpolationAlpha = float(double(accumulatedTimeFixedNS) / double(stepNS));
+    } else {
+        accumulatedTimeFixedNS = 0;
+        numSteps = 1;
+        stepSeconds = float(double(elapsedMicroseconds) * 1e-6);
+        fixedUpdateInterpolationAlpha = 1.0f;
+    }
+
+    if (fixedUpdateWorker) {
+        fixedUpdateWorker->launch(numSteps, stepSeconds);
+    } else {
+        for (int i = 0; i < numSteps; i++) {
+            SGL_TRACE_SCOPE("AppLogic::updateFixed");
+            updateFixed(stepSeconds);
+        }
+    }
 }
 
 void AppLogic::saveScreenshot(const std::string &filename)
@@ -61,21 +182,34 @@ void AppLogic::makeScreenshot()
 void AppLogic::run()
 {
     Window *window = AppSettings::get()->getMainWindow();
-    // Used for only calling "updateFixed(...)" at fixed update rate
-    uint64_t accumulatedTimeFixed = 0;
-    float fixedFPSInMicroSeconds = Timer->getFixedPhysicsFPS()*1000000ul;
     uint64_t fpsTimer = 0;
+    SGL_TRACE_THREAD_NAME("Main");
+    auto lastFrameTime = std::chrono::steady_clock::now();
+    bool isFirstFrame = true;
 
     while (running) {
+        SGL_TRACE_SCOPE("Frame");
         Timer->update();
-        accumulatedTimeFixed += Timer->getElapsedMicroseconds();
+        auto currentFrameTime = std::chrono::steady_clock::now();
+        if (!isFirstFrame) {
+            frameStatistics.addFrameTime(uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    currentFrameTime - lastFrameTime).count()));
+        }
+        lastFrameTime = currentFrameTime;
+        isFirstFrame = false;
 
-        do {
-            updateFixed(Timer->getFixedPhysicsFPS());
-            accumulatedTimeFixed -= fixedFPSInMicroSeconds;
-        } while(Timer->getFixedPhysicsFPSEnabled() && accumulatedTimeFixed >= fixedFPSInMicroSeconds);
+        // Only call "updateFixed(...)" at the fixed update rate
+        waitForFixedUpdates();
+        {
+            SGL_TRACE_SCOPE("AppLogic::onFixedUpdatesFinished");
+            onFixedUpdatesFinished();
+        }
+        scheduleFixedUpdates(Timer->getElapsedMicroseconds());
 
-        running = window->processEvents([this](const SDL_Event &event) { this->processSDLEvent(event); });
+        {
+            SGL_TRACE_SCOPE("Window::processEvents");
+            running = window->processEvents([this](const SDL_Event &event) { this->processSDLEvent(event); });
+        }
 
         //float dt = Timer->getElapsedSeconds();
         framerateSmoother.addSample(1.0f/Timer->getElapsedSeconds());
@@ -83,16 +217,22 @@ void AppLogic::run()
         Mouse->update(dt);
         Keyboard->update(dt);
         Gamepad->update(dt);
-        updateBase(dt);
-        update(dt);
+        {
+            SGL_TRACE_SCOPE("AppLogic::update");
+            updateBase(dt);
+            update(dt);
+        }
 
         // Decided to quit during update?
         if (!running) {
             break;
         }
 
-        window->clear(Color(0, 0, 0));
-        render();
+        {
+            SGL_TRACE_SCOPE("AppLogic::render");
+            window->clear(Color(0, 0, 0));
+            render();
+        }
 
         if (uint64_t(abs((int64_t)fpsTimer - (int64_t)Timer->getTicksMicroseconds())) > fpsCounterUpdateFrequency) {
             fps = 1.0f/dt;//Timer->getElapsedSeconds();
@@ -110,10 +250,17 @@ void AppLogic::run()
         if (screenshot) {
             makeScreenshot();
         }
-        Timer->waitForFPSLimit();
-        window->flip();
+        {
+            SGL_TRACE_SCOPE("Timer::waitForFPSLimit");
+            Timer->waitForFPSLimit();
+        }
+        {
+            SGL_TRACE_SCOPE("Window::flip");
+            window->flip();
+        }
     }
 
+    waitForFixedUpdates();
     Logfile::get()->write("INFO: End of main loop.", BLUE);
 }
 
@@ -9,15 +9,18 @@
 #define LOGIC_APPLOGIC_HPP_
 
 #include <iostream>
+#include <memory>
 #include <boost/shared_ptr.hpp>
 #include <SDL2/SDL.h>
 
 #include "Utils/FramerateSmoother.hpp"
+#include "Utils/FrameStatistics.hpp"
 
 namespace sgl {
 
 class Event;
 typedef boost::shared_ptr<Event> EventPtr;
+class FixedUpdateWorker;
 
 class AppLogic
 {
@@ -29,23 +32,57 @@ public:
 
     /// Override these functions in the derived classes
     virtual void update(float dt) {} // Called once per rendered frame
-    virtual void updateFixed(float dt) {} // Called at a fixed rate (e.g. for physics simulation)
+    /// Called at a fixed rate (e.g. for physics simulation) with dt = 1 / Timer->getFixedPhysicsFPS().
+    /// If fixed updates are disabled in the timer, it is called once per frame with the frame time.
+    virtual void updateFixed(float dt) {}
+    /// Called on the main thread once per frame, after the fixed updates launched in the last frame have finished and
+    /// before the fixed updates of this frame are launched (i.e., the worker thread of setFixedUpdateOnWorkerThread is
+    /// idle). This is the place to swap or copy the simulation state written by updateFixed.
+    virtual void onFixedUpdatesFinished() {}
     virtual void processSDLEvent(const SDL_Event &event) {}
     virtual void resolutionChanged(EventPtr event) {}
     virtual void render() {}
 
     virtual void setPrintFPS(bool enabled);
     inline float getFPS() { return fps; }
+    /// Frame time percentiles and hitches of the last frames
+    inline const FrameStatistics &getFrameStatistics() const { return frameStatistics; }
     inline void quit() { running = false; }
 
+    /**
+     * How far the rendered frame is between the last two fixed updates (in [0, 1)). For smooth motion, render()
+     * can interpolate the simulation state: state = previousState * (1 - alpha) + currentState * alpha.
+     * Is 1 if fixed updates are disabled.
+     */
+    inline float getFixedUpdateInterpolationAlpha() const { return fixedUpdateInterpolationAlpha; }
+    /// Maximum number of fixed updates per frame. If the simulation falls further behind, the time is dropped
+    /// (i.e., the simulation slows down) instead of spending more and more time on catching up.
+    inline void setMaxFixedUpdateCatchUpSteps(int maxSteps) { maxFixedUpdateCatchUpSteps = maxSteps; }
+    /**
+     * Runs updateFixed on a worker thread, pipelined one frame ahead: The fixed updates of a frame run concurrently
+     * with update() and render() of the same frame, and the worker is waited for at the start of the next frame.
+     * This means updateFixed must not touch the state that is read by update() and render() without synchronization
+     * (e.g. it should write to a separate copy of the simulation state that is swapped in onFixedUpdatesFinished).
+     */
+    void setFixedUpdateOnWorkerThread(bool useWorkerThread);
+
 protected:
     void makeScreenshot();
     virtual void saveScreenshot(const std::string &filename);
     bool screenshot;
     float fps;
     FramerateSmoother framerateSmoother;
+    FrameStatistics frameStatistics;
 
 private:
+    /// Runs (or launches) the fixed updates for the elapsed time.
+    void scheduleFixedUpdates(uint64_t elapsedMicroseconds);
+    void waitForFixedUpdates();
+    uint64_t accumulatedTimeFixedNS = 0;
+    int maxFixedUpdateCatchUpSteps = 5;
+    float fixedUpdateInterpolationAlpha = 1.0f;
+    std::unique_ptr<FixedUpdateWorker> fixedUpdateWorker;
+
     bool running;
     uint64_t fpsCounterUpdateFrequency;
     bool printFPS;
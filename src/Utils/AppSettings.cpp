@@ -16,6 +16,8 @@
 #include <Graphics/OpenGL/SystemGL.hpp>
 #include <Graphics/Mesh/Material.hpp>
 #include <Utils/Timer.hpp>
+#include <Utils/CpuFeatures.hpp>
+#include <Utils/MemoryTracker.hpp>
 #include <SDL/SDLWindow.hpp>
 #include <SDL/Input/SDLMouse.hpp>
 #include <SDL/Input/SDLKeyboard.hpp>
@@ -144,6 +146,7 @@ Window *AppSettings::createWindow()
 void AppSettings::initializeSubsystems()
 {
     Logfile::get()->createLogfile((FileUtils::get()->getConfigDirectory() + "Logfile.html").c_str(), "ShapeDetector");
+    Logfile::get()->write(std::string() + "CPU Features: " + getCpuFeaturesString(), BLUE);
 
 #ifndef OPENGLES
     renderSystem = OPENGL;
@@ -206,6 +209,10 @@ void AppSettings::release()
     //Mix_CloseAudio();
     //TTF_Quit();
     SDL_Quit();
+
+#ifdef SGL_MEMORY_TRACKING
+    MemoryTracker::get()->reportLeaks();
+#endif
 }
 
 void AppSettings::setLoadGUI(
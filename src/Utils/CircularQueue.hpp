@@ -30,74 +30,225 @@
 #define HEXVOLUMERENDERER_CIRCULARQUEUE_HPP
 
 #include <cstddef>
+#include <cstring>
 #include <cassert>
+#include <new>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <Utils/MemoryTracker.hpp>
 
+/**
+ * A growable FIFO queue on a ring buffer. The capacity is always a power of two, so the indices wrap around using a
+ * bit mask. The slots are uninitialized storage, i.e., elements are only constructed when they are enqueued and
+ * destroyed when they are popped. Trivially copyable types are copied with memcpy by resize and the batch functions.
+ * For a thread-safe version see ConcurrentCircularQueue.hpp.
+ */
 template<class T>
 class CircularQueue
 {
 public:
     CircularQueue(size_t maxCapacity = 32) {
         startPointer = 0;
-        endPointer = 0;
-        queueCapacity = maxCapacity;
         queueSize = 0;
+        queueCapacity = 0;
+        queueData = nullptr;
         if (maxCapacity != 0) {
-            queueData = new T[queueCapacity];
-        } else {
-            queueData = nullptr;
+            queueCapacity = roundUpToPowerOfTwo(maxCapacity);
+            queueData = sgl::newTrackedArray<Slot>(queueCapacity, sgl::MEMORY_TAG_CIRCULAR_QUEUE);
         }
     }
     ~CircularQueue() {
-        delete[] queueData;
+        clear();
+        sgl::deleteTrackedArray(queueData);
+    }
+    CircularQueue(const CircularQueue&) = delete;
+    CircularQueue &operator=(const CircularQueue&) = delete;
+    CircularQueue(CircularQueue &&other)
+            : queueData(other.queueData), startPointer(other.startPointer), queueCapacity(other.queueCapacity),
+              queueSize(other.queueSize) {
+        other.queueData = nullptr;
+        other.startPointer = 0;
+        other.queueCapacity = 0;
+        other.queueSize = 0;
+    }
+    CircularQueue &operator=(CircularQueue &&other) {
+        if (this != &other) {
+            clear();
+            sgl::deleteTrackedArray(queueData);
+            queueData = other.queueData;
+            startPointer = other.startPointer;
+            queueCapacity = other.queueCapacity;
+            queueSize = other.queueSize;
+            other.queueData = nullptr;
+            other.startPointer = 0;
+            other.queueCapacity = 0;
+            other.queueSize = 0;
+        }
+        return *this;
     }
 
-    void enqueue(const T& data) {
+    template<class... Args>
+    T &emplace(Args&&... args) {
+        T *element;
         if (queueSize == queueCapacity) {
-            resize(queueCapacity == 0 ? 4 : queueCapacity * 2);
+            // The new element is constructed before the old ones are moved, as args might refer to one of them
+            // (e.g. q.emplace(q.front())).
+            const size_t newCapacity = queueCapacity == 0 ? 4 : queueCapacity * 2;
+            Slot *newData = sgl::newTrackedArray<Slot>(newCapacity, sgl::MEMORY_TAG_CIRCULAR_QUEUE);
+            try {
+                element = new (reinterpret_cast<T*>(newData) + queueSize) T(std::forward<Args>(args)...);
+            } catch (...) {
+                sgl::deleteTrackedArray(newData);
+                throw;
+            }
+            relocate(newData, newCapacity);
+        } else {
+            element = new (getElement(startPointer + queueSize)) T(std::forward<Args>(args)...);
         }
-
-        queueData[endPointer] = data;
-        endPointer = (endPointer + 1) % queueCapacity;
         queueSize++;
+        return *element;
     }
+    inline void enqueue(const T& data) { emplace(data); }
+    inline void enqueue(T&& data) { emplace(std::move(data)); }
     T popFront() {
         assert(queueSize > 0);
-        T data = queueData[startPointer];
-        startPointer = (startPointer + 1) % queueCapacity;
+        T *element = getElement(startPointer);
+        T data(std::move(*element));
+        element->~T();
+        startPointer = (startPointer + 1) & (queueCapacity - 1);
         queueSize--;
         return data;
     }
+    inline T &front() { assert(queueSize > 0); return *getElement(startPointer); }
 
-    inline size_t isEmpty() { return queueSize == 0; }
-    inline size_t getSize() { return queueSize; }
-    inline size_t getCapacity() { return queueCapacity; }
+    //! Appends the values (with at most two memcpy calls for trivially copyable types).
+    void pushBatch(const T *values, size_t numValues) {
+        if (queueSize + numValues > queueCapacity) {
+            // As in emplace, the values might be elements of this queue, so they are copied before the old elements
+            // are moved.
+            const size_t newCapacity = roundUpToPowerOfTwo(std::max(queueSize + numValues, queueCapacity * 2));
+            Slot *newData = sgl::newTrackedArray<Slot>(newCapacity, sgl::MEMORY_TAG_CIRCULAR_QUEUE);
+            copyConstruct(reinterpret_cast<T*>(newData) + queueSize, values, numValues);
+            relocate(newData, newCapacity);
+            queueSize += numValues;
+            return;
+        }
+        const size_t endPointer = (startPointer + queueSize) & (queueCapacity - 1);
+        const size_t numValuesFirstPart = std::min(numValues, queueCapacity - endPointer);
+        copyConstruct(getElement(endPointer), values, numValuesFirstPart);
+        copyConstruct(getElement(0), values + numValuesFirstPart, numValues - numValuesFirstPart);
+        queueSize += numValues;
+    }
+    //! Moves up to maxNumValues elements from the front to values and returns how many were popped.
+    size_t popBatch(T *values, size_t maxNumValues) {
+        const size_t numValues = std::min(maxNumValues, queueSize);
+        const size_t numValuesFirstPart = std::min(numValues, queueCapacity - startPointer);
+        moveOut(values, getElement(startPointer), numValuesFirstPart);
+        moveOut(values + numValuesFirstPart, getElement(0), numValues - numValuesFirstPart);
+        if (numValues > 0) {
+            startPointer = (startPointer + numValues) & (queueCapacity - 1);
+            queueSize -= numValues;
+        }
+        return numValues;
+    }
 
+    void clear() {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < queueSize; i++) {
+                getElement(startPointer + i)->~T();
+            }
+        }
+        startPointer = 0;
+        queueSize = 0;
+    }
+
+    inline bool isEmpty() const { return queueSize == 0; }
+    inline size_t getSize() const { return queueSize; }
+    inline size_t getCapacity() const { return queueCapacity; }
+
+    //! Changes the capacity (rounded up to a power of two, and at least the current size).
     void resize(size_t newCapacity) {
-        // Copy data to larger array.
-        T *newData = new T[newCapacity];
-        int readIdx = startPointer;
-        int writeIdx = 0;
-        for (int i = 0; i < queueSize; i++) {
-            newData[writeIdx] = queueData[readIdx];
-            readIdx = (readIdx + 1) % queueCapacity;
-            writeIdx++;
+        newCapacity = roundUpToPowerOfTwo(std::max(newCapacity, queueSize));
+        if (newCapacity == queueCapacity) {
+            return;
+        }
+
+        relocate(sgl::newTrackedArray<Slot>(newCapacity, sgl::MEMORY_TAG_CIRCULAR_QUEUE), newCapacity);
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+
+    //! Moves the elements to the front of newData (with the capacity newCapacity) and frees the old array.
+    void relocate(Slot *newData, size_t newCapacity) {
+        // Move the data to the new array (in at most two parts, as the old data may wrap around).
+        const size_t numValuesFirstPart = std::min(queueSize, queueCapacity - startPointer);
+        T *newElements = reinterpret_cast<T*>(newData);
+        if (queueSize > 0) {
+            moveConstruct(newElements, getElement(startPointer), numValuesFirstPart);
+            moveConstruct(newElements + numValuesFirstPart, getElement(0), queueSize - numValuesFirstPart);
         }
 
         // Reset the pointers.
         startPointer = 0;
-        endPointer = queueSize;
         queueCapacity = newCapacity;
 
-        // Delete the old data and copy the new data.
-        if (queueData) {
-            delete[] queueData;
-        }
+        // Delete the old data and use the new data.
+        sgl::deleteTrackedArray(queueData);
         queueData = newData;
     }
 
-private:
-    T *queueData;
-    size_t startPointer, endPointer;
+    static inline size_t roundUpToPowerOfTwo(size_t x) {
+        size_t powerOfTwo = 1;
+        while (powerOfTwo < x) {
+            powerOfTwo <<= 1;
+        }
+        return powerOfTwo;
+    }
+    inline T *getElement(size_t index) { return reinterpret_cast<T*>(&queueData[index & (queueCapacity - 1)]); }
+
+    // Helpers for contiguous ranges of elements that use memcpy for trivially copyable types.
+    static void copyConstruct(T *dst, const T *src, size_t count) {
+        if (std::is_trivially_copyable<T>::value) {
+            if (count > 0) {
+                memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                new (dst + i) T(src[i]);
+            }
+        }
+    }
+    //! Move constructs dst from src and destroys src.
+    static void moveConstruct(T *dst, T *src, size_t count) {
+        if (std::is_trivially_copyable<T>::value) {
+            if (count > 0) {
+                memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                new (dst + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+    //! Move assigns dst from src and destroys src.
+    static void moveOut(T *dst, T *src, size_t count) {
+        if (std::is_trivially_copyable<T>::value) {
+            if (count > 0) {
+                memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < count; i++) {
+                dst[i] = std::move(src[i]);
+                src[i].~T();
+            }
+        }
+    }
+
+    Slot *queueData;
+    size_t startPointer;
     size_t queueCapacity;
     size_t queueSize;
 };
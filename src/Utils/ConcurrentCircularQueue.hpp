@@ -0,0 +1,384 @@
+/*!
+ * ConcurrentCircularQueue.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_CONCURRENTCIRCULARQUEUE_HPP_
+#define UTILS_CONCURRENTCIRCULARQUEUE_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace sgl {
+
+//! Head and tail counters are placed on separate cache lines to avoid false sharing between producers and consumers.
+#define CONCURRENT_QUEUE_CACHE_LINE_SIZE 64
+
+namespace detail {
+
+inline size_t roundUpToPowerOfTwo(size_t x) {
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < x) {
+        powerOfTwo <<= 1;
+    }
+    return powerOfTwo;
+}
+
+/*! Lets the blocking functions wait for the other side of a queue. They first spin and yield for a few iterations,
+ * then sleep on a condition variable, so a thread waiting for a long time (e.g. a consumer of an idle queue) doesn't
+ * burn a core. The successful side calls notify, which only takes the mutex if somebody is sleeping, but costs a
+ * sequentially consistent fence per call, so the lock-free fast path stays free of system calls. */
+class Waiter {
+public:
+    Waiter() : numSleepers(0), epoch(0) {}
+    Waiter(const Waiter&) = delete;
+    Waiter &operator=(const Waiter&) = delete;
+
+    //! Blocks until tryOperation returns true. tryOperation is called without holding the mutex.
+    template<class TryOperation>
+    void waitUntil(TryOperation tryOperation) {
+        for (int i = 0; i < 80; i++) {
+            if (tryOperation()) {
+                return;
+            }
+            if (i >= 64) {
+                std::this_thread::yield();
+            }
+        }
+
+        numSleepers.fetch_add(1, std::memory_order_seq_cst);
+        for (;;) {
+            // Pairs with the fence in notify: Either tryOperation sees the change of the other side, or the other side
+            // sees numSleepers > 0 and increments the epoch under the mutex, so the wakeup can't get lost.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const unsigned int lastEpoch = epoch.load(std::memory_order_acquire);
+            if (tryOperation()) {
+                break;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            conditionVariable.wait(lock, [this, lastEpoch] {
+                return epoch.load(std::memory_order_relaxed) != lastEpoch;
+            });
+        }
+        numSleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    //! Wakes up the sleeping threads (if any) after the state of the queue has changed.
+    inline void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (numSleepers.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            epoch.fetch_add(1, std::memory_order_release);
+            conditionVariable.notify_all();
+        }
+    }
+
+private:
+    std::atomic<int> numSleepers;
+    std::atomic<unsigned int> epoch;
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+};
+
+}
+
+/*! Lock-free bounded queue for exactly one producer and one consumer thread (e.g. loader -> uploader).
+ * The capacity is rounded up to a power of two, and the slots are raw storage, i.e., elements are only constructed
+ * when pushed and destroyed when popped. T only needs to be move constructible (e.g. std::unique_ptr).
+ * The try functions never block, while push/pop wait until there is space or an element (see detail::Waiter). */
+template<class T>
+class SpscCircularQueue
+{
+public:
+    explicit SpscCircularQueue(size_t capacity = 1024)
+            : capacity(detail::roundUpToPowerOfTwo(capacity < 1 ? 1 : capacity)), mask(this->capacity - 1),
+              slots(new Slot[this->capacity]), head(0), tail(0), cachedTail(0), cachedHead(0) {}
+    ~SpscCircularQueue() {
+        const size_t end = tail.load(std::memory_order_relaxed);
+        for (size_t i = head.load(std::memory_order_relaxed); i != end; i++) {
+            element(i)->~T();
+        }
+        delete[] slots;
+    }
+    SpscCircularQueue(const SpscCircularQueue&) = delete;
+    SpscCircularQueue &operator=(const SpscCircularQueue&) = delete;
+
+    // Producer side
+    template<class... Args>
+    bool tryEmplace(Args&&... args) {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - cachedHead == capacity) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (currentTail - cachedHead == capacity) {
+                return false;
+            }
+        }
+        new (element(currentTail)) T(std::forward<Args>(args)...);
+        tail.store(currentTail + 1, std::memory_order_release);
+        notEmptyWaiter.notify();
+        return true;
+    }
+    inline bool tryPush(const T &value) { return tryEmplace(value); }
+    inline bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+    void push(T &&value) {
+        notFullWaiter.waitUntil([this, &value] { return tryEmplace(std::move(value)); });
+    }
+    void push(const T &value) {
+        notFullWaiter.waitUntil([this, &value] { return tryEmplace(value); });
+    }
+    //! Moves up to numValues elements into the queue and returns how many were pushed (with one synchronization).
+    size_t tryPushBatch(T *values, size_t numValues) {
+        const size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (capacity - (currentTail - cachedHead) < numValues) {
+            cachedHead = head.load(std::memory_order_acquire);
+        }
+        const size_t numPushed = std::min(numValues, capacity - (currentTail - cachedHead));
+        for (size_t i = 0; i < numPushed; i++) {
+            new (element(currentTail + i)) T(std::move(values[i]));
+        }
+        tail.store(currentTail + numPushed, std::memory_order_release);
+        if (numPushed > 0) {
+            notEmptyWaiter.notify();
+        }
+        return numPushed;
+    }
+    //! Blocks until all values were pushed.
+    void pushBatch(T *values, size_t numValues) {
+        while (numValues > 0) {
+            notFullWaiter.waitUntil([this, &values, &numValues] {
+                size_t numPushed = tryPushBatch(values, numValues);
+                values += numPushed;
+                numValues -= numPushed;
+                return numPushed > 0;
+            });
+        }
+    }
+
+    // Consumer side
+    bool tryPop(T &value) {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (currentHead == cachedTail) {
+                return false;
+            }
+        }
+        T *slotElement = element(currentHead);
+        value = std::move(*slotElement);
+        slotElement->~T();
+        head.store(currentHead + 1, std::memory_order_release);
+        notFullWaiter.notify();
+        return true;
+    }
+    void pop(T &value) {
+        notEmptyWaiter.waitUntil([this, &value] { return tryPop(value); });
+    }
+    /*! Returns the element at position index (0 is the front) without removing it, or nullptr if there are fewer
+     * elements. Doesn't modify the queue, so it can also be used as a best effort by other threads (e.g. for dumping
+     * the elements in a crash handler), as long as the consumer doesn't pop the element meanwhile. */
+    const T *peek(size_t index = 0) {
+        const size_t currentHead = head.load(std::memory_order_acquire);
+        if (tail.load(std::memory_order_acquire) - currentHead <= index) {
+            return nullptr;
+        }
+        return element(currentHead + index);
+    }
+    //! Moves up to maxNumValues elements to values and returns how many were popped (with one synchronization).
+    size_t tryPopBatch(T *values, size_t maxNumValues) {
+        const size_t currentHead = head.load(std::memory_order_relaxed);
+        if (cachedTail - currentHead < maxNumValues) {
+            cachedTail = tail.load(std::memory_order_acquire);
+        }
+        const size_t numPopped = std::min(maxNumValues, cachedTail - currentHead);
+        for (size_t i = 0; i < numPopped; i++) {
+            T *slotElement = element(currentHead + i);
+            values[i] = std::move(*slotElement);
+            slotElement->~T();
+        }
+        head.store(currentHead + numPopped, std::memory_order_release);
+        if (numPopped > 0) {
+            notFullWaiter.notify();
+        }
+        return numPopped;
+    }
+
+    //! Only a snapshot if the other thread is active.
+    inline size_t getSizeApprox() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+    inline bool isEmptyApprox() const { return getSizeApprox() == 0; }
+    inline size_t getCapacity() const { return capacity; }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Slot;
+    inline T *element(size_t index) { return reinterpret_cast<T*>(&slots[index & mask]); }
+
+    const size_t capacity;
+    const size_t mask;
+    Slot *slots;
+
+    // Index of the next element to pop (written by the consumer) and of the next free slot (written by the producer).
+    // Both threads keep a cached copy of the counter of the other thread on their own cache line.
+    char padding0[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    std::atomic<size_t> head;
+    char padding1[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    std::atomic<size_t> tail;
+    char padding2[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    size_t cachedTail; //!< Only used by the consumer
+    char padding3[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    size_t cachedHead; //!< Only used by the producer
+    char padding4[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+
+    // Used by push/pop to sleep while the queue is full/empty.
+    detail::Waiter notFullWaiter;
+    detail::Waiter notEmptyWaiter;
+};
+
+/*! Lock-free bounded queue for any number of producer and consumer threads (Dmitry Vyukov's bounded MPMC queue).
+ * Every slot has a sequence number telling whether it is ready for the producer or the consumer of the current lap,
+ * so producers and consumers only contend on their own counter. The capacity is rounded up to a power of two (at least
+ * two). The batch functions push/pop element by element, so other threads may interleave with a batch. */
+template<class T>
+class MpmcCircularQueue
+{
+public:
+    explicit MpmcCircularQueue(size_t capacity = 1024)
+            : capacity(detail::roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)), mask(this->capacity - 1),
+              cells(new Cell[this->capacity]), head(0), tail(0) {
+        for (size_t i = 0; i < this->capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    ~MpmcCircularQueue() {
+        const size_t end = tail.load(std::memory_order_relaxed);
+        for (size_t i = head.load(std::memory_order_relaxed); i != end; i++) {
+            cells[i & mask].element()->~T();
+        }
+        delete[] cells;
+    }
+    MpmcCircularQueue(const MpmcCircularQueue&) = delete;
+    MpmcCircularQueue &operator=(const MpmcCircularQueue&) = delete;
+
+    template<class... Args>
+    bool tryEmplace(Args&&... args) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[position & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Full
+            } else {
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        new (cell->element()) T(std::forward<Args>(args)...);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        notEmptyWaiter.notify();
+        return true;
+    }
+    inline bool tryPush(const T &value) { return tryEmplace(value); }
+    inline bool tryPush(T &&value) { return tryEmplace(std::move(value)); }
+    void push(T &&value) {
+        notFullWaiter.waitUntil([this, &value] { return tryEmplace(std::move(value)); });
+    }
+    void push(const T &value) {
+        notFullWaiter.waitUntil([this, &value] { return tryEmplace(value); });
+    }
+    size_t tryPushBatch(T *values, size_t numValues) {
+        size_t numPushed = 0;
+        while (numPushed < numValues && tryEmplace(std::move(values[numPushed]))) {
+            numPushed++;
+        }
+        return numPushed;
+    }
+    void pushBatch(T *values, size_t numValues) {
+        for (size_t i = 0; i < numValues; i++) {
+            push(std::move(values[i]));
+        }
+    }
+
+    bool tryPop(T &value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        Cell *cell;
+        for (;;) {
+            cell = &cells[position & mask];
+            const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+            if (difference == 0) {
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Empty
+            } else {
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+        T *cellElement = cell->element();
+        value = std::move(*cellElement);
+        cellElement->~T();
+        cell->sequence.store(position + capacity, std::memory_order_release);
+        notFullWaiter.notify();
+        return true;
+    }
+    void pop(T &value) {
+        notEmptyWaiter.waitUntil([this, &value] { return tryPop(value); });
+    }
+    size_t tryPopBatch(T *values, size_t maxNumValues) {
+        size_t numPopped = 0;
+        while (numPopped < maxNumValues && tryPop(values[numPopped])) {
+            numPopped++;
+        }
+        return numPopped;
+    }
+
+    //! Only a snapshot if other threads are active.
+    inline size_t getSizeApprox() const {
+        const size_t currentTail = tail.load(std::memory_order_acquire);
+        const size_t currentHead = head.load(std::memory_order_acquire);
+        return currentTail > currentHead ? currentTail - currentHead : 0;
+    }
+    inline bool isEmptyApprox() const { return getSizeApprox() == 0; }
+    inline size_t getCapacity() const { return capacity; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        inline T *element() { return reinterpret_cast<T*>(&storage); }
+    };
+
+    const size_t capacity;
+    const size_t mask;
+    Cell *cells;
+
+    char padding0[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    std::atomic<size_t> head;
+    char padding1[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+    std::atomic<size_t> tail;
+    char padding2[CONCURRENT_QUEUE_CACHE_LINE_SIZE];
+
+    // Used by push/pop to sleep while the queue is full/empty.
+    detail::Waiter notFullWaiter;
+    detail::Waiter notEmptyWaiter;
+};
+
+}
+
+/*! UTILS_CONCURRENTCIRCULARQUEUE_HPP_ */
+#endif
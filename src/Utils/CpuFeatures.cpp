@@ -0,0 +1,165 @@
+/*
+ * CpuFeatures.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "CpuFeatures.hpp"
+#include <cstdint>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define CPU_FEATURES_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define CPU_FEATURES_X86
+#endif
+
+namespace sgl {
+
+#ifdef CPU_FEATURES_X86
+//! Returns false if the leaf is not supported.
+static bool cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4])
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (uint32_t(info[0]) < leaf) {
+        return false;
+    }
+    __cpuidex(info, int(leaf), int(subleaf));
+    for (int i = 0; i < 4; i++) {
+        regs[i] = uint32_t(info[i]);
+    }
+    return true;
+#else
+    unsigned int a, b, c, d;
+    if (!__get_cpuid_count(leaf, subleaf, &a, &b, &c, &d)) {
+        return false;
+    }
+    regs[0] = a; regs[1] = b; regs[2] = c; regs[3] = d;
+    return true;
+#endif
+}
+
+//! Extended control register 0, i.e., the register states saved by the operating system.
+static uint64_t getXCR0()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (uint64_t(edx) << 32) | eax;
+#endif
+}
+
+static CpuFeatures detectCpuFeatures()
+{
+    CpuFeatures features;
+    uint32_t regs[4];
+    if (!cpuid(1, 0, regs)) {
+        return features;
+    }
+    const uint32_t ecx1 = regs[2], edx1 = regs[3];
+    features.sse2 = (edx1 & (1u << 26)) != 0;
+    features.sse41 = (ecx1 & (1u << 19)) != 0;
+    features.sse42 = (ecx1 & (1u << 20)) != 0;
+
+    // The OS needs to save the YMM (XCR0 bits 1-2) and the ZMM registers (bits 5-7) on context switches
+    const bool osxsave = (ecx1 & (1u << 27)) != 0;
+    const uint64_t xcr0 = osxsave ? getXCR0() : 0;
+    const bool osSupportsYMM = (xcr0 & 0x6) == 0x6;
+    const bool osSupportsZMM = (xcr0 & 0xE6) == 0xE6;
+    features.avx = osSupportsYMM && (ecx1 & (1u << 28)) != 0;
+    features.fma = features.avx && (ecx1 & (1u << 12)) != 0;
+    features.f16c = features.avx && (ecx1 & (1u << 29)) != 0;
+
+    if (cpuid(7, 0, regs)) {
+        const uint32_t ebx7 = regs[1];
+        features.avx2 = features.avx && (ebx7 & (1u << 5)) != 0;
+        features.avx512f = osSupportsZMM && (ebx7 & (1u << 16)) != 0;
+        features.avx512dq = features.avx512f && (ebx7 & (1u << 17)) != 0;
+        features.avx512bw = features.avx512f && (ebx7 & (1u << 30)) != 0;
+        features.avx512vl = features.avx512f && (ebx7 & (1u << 31)) != 0;
+    }
+    return features;
+}
+#else
+static CpuFeatures detectCpuFeatures()
+{
+    return CpuFeatures();
+}
+#endif
+
+static CpuSimdLevel maxCpuSimdLevel = SIMD_LEVEL_AVX512;
+
+const CpuFeatures &getCpuFeatures()
+{
+    static const CpuFeatures features = detectCpuFeatures();
+    return features;
+}
+
+static CpuSimdLevel getSupportedCpuSimdLevel()
+{
+    const CpuFeatures &features = getCpuFeatures();
+    if (features.avx2 && features.fma && features.avx512f && features.avx512bw && features.avx512dq
+            && features.avx512vl) {
+        return SIMD_LEVEL_AVX512;
+    }
+    if (features.avx2 && features.fma) {
+        return SIMD_LEVEL_AVX2;
+    }
+    if (features.sse2) {
+        return SIMD_LEVEL_SSE2;
+    }
+    return SIMD_LEVEL_SCALAR;
+}
+
+CpuSimdLevel getCpuSimdLevel()
+{
+    static const CpuSimdLevel supportedLevel = getSupportedCpuSimdLevel();
+    return supportedLevel < maxCpuSimdLevel ? supportedLevel : maxCpuSimdLevel;
+}
+
+void setMaxCpuSimdLevel(CpuSimdLevel level)
+{
+    maxCpuSimdLevel = level;
+}
+
+const char *getCpuSimdLevelName(CpuSimdLevel level)
+{
+    switch (level) {
+    case SIMD_LEVEL_SSE2:
+        return "SSE2";
+    case SIMD_LEVEL_AVX2:
+        return "AVX2";
+    case SIMD_LEVEL_AVX512:
+        return "AVX-512";
+    default:
+        return "Scalar";
+    }
+}
+
+std::string getCpuFeaturesString()
+{
+    const CpuFeatures &features = getCpuFeatures();
+    std::string featuresString;
+    const std::pair<bool, const char*> featureNames[] = {
+            { features.sse2, "SSE2" }, { features.sse41, "SSE4.1" }, { features.sse42, "SSE4.2" },
+            { features.avx, "AVX" }, { features.avx2, "AVX2" }, { features.fma, "FMA" }, { features.f16c, "F16C" },
+            { features.avx512f, "AVX512F" }, { features.avx512bw, "AVX512BW" }, { features.avx512dq, "AVX512DQ" },
+            { features.avx512vl, "AVX512VL" }
+    };
+    for (const std::pair<bool, const char*> &featureName : featureNames) {
+        if (featureName.first) {
+            featuresString += std::string() + featureName.second + " ";
+        }
+    }
+    return featuresString + "(dispatch level: " + getCpuSimdLevelName(getCpuSimdLevel()) + ")";
+}
+
+}
@@ -0,0 +1,101 @@
+/*!
+ * CpuFeatures.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_CPUFEATURES_HPP_
+#define UTILS_CPUFEATURES_HPP_
+
+#include <string>
+#include <Defs.hpp>
+
+/*
+ * Kernels for the higher levels live in files ending with _AVX2.cpp or _AVX512.cpp, which the build compiles with the
+ * corresponding ISA flags. If the compiler supports these flags, SGL_AVX2_KERNELS or SGL_AVX512_KERNELS is defined
+ * for all files. The kernel files should only include intrinsics and plain headers (no glm or standard library
+ * templates), as inline functions instantiated with the ISA flags might otherwise be used by the baseline code.
+ */
+#ifdef SGL_AVX2_KERNELS
+#define SGL_AVX2_KERNEL(kernel) (kernel)
+#else
+#define SGL_AVX2_KERNEL(kernel) nullptr
+#endif
+#ifdef SGL_AVX512_KERNELS
+#define SGL_AVX512_KERNEL(kernel) (kernel)
+#else
+#define SGL_AVX512_KERNEL(kernel) nullptr
+#endif
+
+namespace sgl {
+
+/*! Instruction set extensions supported by the CPU. The AVX and AVX-512 flags are only set if the operating system
+ * also saves the corresponding registers on context switches. */
+struct DLL_OBJECT CpuFeatures {
+    bool sse2 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool avx = false;
+    bool avx2 = false;
+    bool fma = false;
+    bool f16c = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool avx512dq = false;
+    bool avx512vl = false;
+};
+
+/*! The levels kernels can be specialized for. Every level implies the features of the lower levels.
+ * AVX2 also implies FMA, and AVX512 means AVX-512 F/BW/DQ/VL (i.e., the Skylake-X feature set). */
+enum CpuSimdLevel {
+    SIMD_LEVEL_SCALAR = 0, SIMD_LEVEL_SSE2, SIMD_LEVEL_AVX2, SIMD_LEVEL_AVX512, NUM_SIMD_LEVELS
+};
+
+//! Detects the features using cpuid (once, the result is cached).
+DLL_OBJECT const CpuFeatures &getCpuFeatures();
+//! Highest level supported by the CPU, limited by setMaxCpuSimdLevel.
+DLL_OBJECT CpuSimdLevel getCpuSimdLevel();
+/*! Limits the level used for kernel dispatch (e.g. for comparing the kernels or working around bugs). Call this
+ * before any kernels are used, as the dispatched functions may be cached by the callers. */
+DLL_OBJECT void setMaxCpuSimdLevel(CpuSimdLevel level);
+DLL_OBJECT const char *getCpuSimdLevelName(CpuSimdLevel level);
+//! E.g. "SSE2 SSE4.1 SSE4.2 AVX AVX2 FMA F16C (dispatch level: AVX2)" for the log file.
+DLL_OBJECT std::string getCpuFeaturesString();
+
+/*! Table of implementations of one kernel for the different SIMD levels. Entries may be null if there is no
+ * specialized implementation for a level (e.g. because the compiler does not support the instruction set).
+ * get() returns the implementation for the highest level supported by the CPU, or null if there is none.
+ * Usage:
+ *   static const KernelTable<TransformFunction> transformKernels(
+ *           transformScalar, nullptr, SGL_AVX2_KERNEL(transformAVX2));
+ *   transformKernels.get()(...);
+ */
+template<class Function>
+class KernelTable {
+public:
+    KernelTable(Function scalar, Function sse2 = nullptr, Function avx2 = nullptr, Function avx512 = nullptr) {
+        kernels[SIMD_LEVEL_SCALAR] = scalar;
+        kernels[SIMD_LEVEL_SSE2] = sse2;
+        kernels[SIMD_LEVEL_AVX2] = avx2;
+        kernels[SIMD_LEVEL_AVX512] = avx512;
+    }
+
+    inline Function get() const { return get(getCpuSimdLevel()); }
+    Function get(CpuSimdLevel maxLevel) const {
+        for (int level = int(maxLevel); level >= 0; level--) {
+            if (kernels[level] != nullptr) {
+                return kernels[level];
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    Function kernels[NUM_SIMD_LEVELS];
+};
+
+}
+
+/*! UTILS_CPUFEATURES_HPP_ */
+#endif
@@ -6,14 +6,24 @@
  */
 
 #include "EventManager.hpp"
+#include <Utils/TraceRecorder.hpp>
+#include <Utils/Metrics.hpp>
 
 namespace sgl {
 
+static MetricCounter &eventsDispatchedCounter = MetricsRegistry::get()->getCounter(
+        "events.dispatched", "Events passed to the listeners");
+static MetricCounter &eventsQueuedCounter = MetricsRegistry::get()->getCounter(
+        "events.queued", "Events added to the queue of EventManager");
+static MetricCounter &listenerCallsCounter = MetricsRegistry::get()->getCounter(
+        "events.listener_calls", "Calls of event listener functions");
+
 EventManager::EventManager() {
     listenerCounter = 0;
 }
 
 void EventManager::update() {
+    SGL_TRACE_SCOPE("EventManager::update");
     while (!eventQueue.empty()) {
         EventPtr event = eventQueue.front();
         eventQueue.pop_front();
@@ -42,11 +52,13 @@ void EventManager::removeListener(uint32_t eventType, ListenerToken token) {
 
 // Event function is called instantly
 void EventManager::triggerEvent(EventPtr event) {
+    eventsDispatchedCounter.add();
     auto mapEntry = listeners.find(event->getType());
     if (mapEntry == listeners.end()) {
         return;
     }
 
+    listenerCallsCounter.add(mapEntry->second.size());
     for (auto it = mapEntry->second.begin(); it != mapEntry->second.end(); it++) {
         it->second(event);
     }
@@ -54,6 +66,7 @@ void EventManager::triggerEvent(EventPtr event) {
 
 // Adds an event to the event queue, which is updated by calling the function "update"
 void EventManager::queueEvent(EventPtr event) {
+    eventsQueuedCounter.add();
     eventQueue.push_back(event);
 }
 
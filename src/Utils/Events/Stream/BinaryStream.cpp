@@ -9,6 +9,7 @@
 #include "BinaryStream.hpp"
 #include <algorithm>
 #include <cstring>
+#include <Utils/MemoryTracker.hpp>
 #include <cmath>
 #include <Utils/File/Logfile.hpp>
 
@@ -25,7 +26,7 @@ BinaryWriteStream::BinaryWriteStream(size_t size /* = STD_BUFFER_SIZE */)
 BinaryWriteStream::~BinaryWriteStream()
 {
     if (buffer) {
-        delete[] buffer;
+        deleteTrackedArray(buffer);
         buffer = NULL;
         capacity = 0;
         bufferSize = 0;
@@ -36,10 +37,10 @@ void BinaryWriteStream::reserve(size_t size /* = STD_BUFFER_SIZE */)
 {
     size = std::max((size_t)4, size); // Minimum buffer size: 32 bits
     if (size > capacity) {
-        uint8_t *_buffer = new uint8_t[size];
+        uint8_t *_buffer = newTrackedArray<uint8_t>(size, MEMORY_TAG_STREAM);
         if (buffer) {
             memcpy(_buffer, buffer, bufferSize);
-            delete[] buffer;
+            deleteTrackedArray(buffer);
         }
         buffer = _buffer;
         capacity = size;
@@ -96,7 +97,7 @@ BinaryReadStream::BinaryReadStream(void *_buffer, size_t _bufferSize)
 
 BinaryReadStream::BinaryReadStream(const void *_buffer, size_t _bufferSize)
 {
-    buffer = new uint8_t[_bufferSize];
+    buffer = newTrackedArray<uint8_t>(_bufferSize, MEMORY_TAG_STREAM);
     memcpy(buffer, _buffer, _bufferSize);
     bufferSize = _bufferSize;
     bufferStart = 0;
@@ -105,7 +106,7 @@ BinaryReadStream::BinaryReadStream(const void *_buffer, size_t _bufferSize)
 BinaryReadStream::~BinaryReadStream()
 {
     if (buffer) {
-        delete[] buffer;
+        deleteTrackedArray(buffer);
         buffer = NULL;
         bufferStart = 0;
         bufferSize = 0;
@@ -116,6 +117,7 @@ void BinaryReadStream::read(void *data, size_t size)
 {
     if (bufferStart + size > bufferSize) {
         Logfile::get()->writeError("FATAL ERROR: BinaryReadStream::read(void*, size_t)");
+        hasReadError = true;
         return;
     }
     memcpy(data, buffer + bufferStart, size);
@@ -128,6 +130,7 @@ void BinaryReadStream::read(std::string &str)
     read(strSize);
     if (bufferStart + (size_t)strSize > bufferSize) {
         Logfile::get()->writeError("FATAL ERROR: BinaryReadStream::read(string&)");
+        hasReadError = true;
         return;
     }
     char *cstr = new char[strSize+1];
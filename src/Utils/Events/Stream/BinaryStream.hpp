@@ -75,6 +75,10 @@ public:
     BinaryReadStream(const void *_buffer, size_t _bufferSize);
     ~BinaryReadStream();
     inline size_t getSize() const { return bufferSize; }
+    /// Number of bytes that were not read yet
+    inline size_t getNumBytesLeft() const { return bufferSize - bufferStart; }
+    /// Whether a read went past the end of the buffer (the data is left unchanged in this case)
+    inline bool getHasReadError() const { return hasReadError; }
 
     /// Deserialization (see BinaryWriteStream for details).
     void read(void *data, size_t size);
@@ -105,6 +109,7 @@ protected:
     /// The current point in the buffer where the code reads from
     size_t bufferStart;
     uint8_t *buffer;
+    bool hasReadError = false;
 };
 
 }
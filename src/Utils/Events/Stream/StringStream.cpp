@@ -9,6 +9,7 @@
 #include "StringStream.hpp"
 #include <algorithm>
 #include <cstring>
+#include <Utils/MemoryTracker.hpp>
 
 namespace sgl {
 
@@ -23,7 +24,7 @@ StringWriteStream::StringWriteStream(size_t size /* = STD_BUFFER_SIZE */)
 StringWriteStream::~StringWriteStream()
 {
     if (buffer) {
-        delete[] buffer;
+        deleteTrackedArray(buffer);
         buffer = NULL;
         capacity = 0;
         bufferSize = 0;
@@ -34,10 +35,10 @@ void StringWriteStream::reserve(size_t size /* = STD_BUFFER_SIZE */)
 {
     size = std::max((size_t)4, size); // Minimum buffer size: 32 bits
     if (size > capacity) {
-        char *_buffer = new char[size];
+        char *_buffer = newTrackedArray<char>(size, MEMORY_TAG_STREAM);
         if (buffer) {
             memcpy(_buffer, buffer, bufferSize);
-            delete[] buffer;
+            deleteTrackedArray(buffer);
         }
         buffer = _buffer;
         capacity = size;
@@ -93,7 +94,7 @@ StringReadStream::StringReadStream(void *_buffer, size_t _bufferSize)
 StringReadStream::~StringReadStream()
 {
     if (buffer) {
-        delete[] buffer;
+        deleteTrackedArray(buffer);
         buffer = NULL;
         bufferStart = 0;
         bufferSize = 0;
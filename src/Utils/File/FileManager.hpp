@@ -12,6 +12,7 @@
 #include <map>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
+#include <Utils/TraceRecorder.hpp>
 
 namespace sgl {
 
@@ -36,6 +37,7 @@ boost::shared_ptr<AssetType> FileManager<AssetType, AssetInfo>::getAsset(AssetIn
 
     //! Do we need to (re-)load the asset?
     if (it == assetMap.end() || it->second._empty() || it->second.expired()) {
+        SGL_TRACE_SCOPE_CATEGORY("FileManager::loadAsset", "loading");
         boost::shared_ptr<AssetType> asset = loadAsset(assetInfo);
         assetMap[assetInfo] = boost::weak_ptr<AssetType>(asset);
         return asset;
@@ -32,6 +32,7 @@
 
 #include <Utils/File/Logfile.hpp>
 #include <Utils/File/FileUtils.hpp>
+#include <Utils/MemoryTracker.hpp>
 
 #include "LineReader.hpp"
 
@@ -63,7 +64,7 @@ LineReader::LineReader(const std::string& filename)
     fseeko(file, 0, SEEK_SET);
 #endif
 
-    char* fileBuffer = new char[length];
+    char* fileBuffer = newTrackedArray<char>(length, MEMORY_TAG_LINE_READER);
     if (fileBuffer == nullptr) {
         sgl::Logfile::get()->writeError(
                 std::string() + "Error in LineReader::LineReader: Couldn't reserve sufficient "
@@ -76,7 +77,7 @@ LineReader::LineReader(const std::string& filename)
         sgl::Logfile::get()->writeError(
                 std::string() + "Error in LineReader::LineReader: Invalid return value when "
                 + "reading the file \"" + filename + "\".");
-        delete[] fileBuffer;
+        deleteTrackedArray(fileBuffer);
         return;
     }
 
@@ -92,7 +93,7 @@ LineReader::LineReader(const char* bufferData, const size_t bufferSize)
 
 LineReader::~LineReader() {
     if (!userManagedBuffer && bufferData) {
-        delete[] bufferData;
+        deleteTrackedArray(bufferData);
     }
     bufferData = nullptr;
     bufferSize = 0;
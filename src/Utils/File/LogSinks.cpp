@@ -0,0 +1,173 @@
+/*
+ * LogSinks.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <cstdio>
+#include <ctime>
+#include <cstring>
+#include "LogSinks.hpp"
+#include "Logfile.hpp"
+
+namespace sgl {
+
+//! E.g. "2026-10-18 12:00:00.123" (local time)
+static void formatTime(uint64_t timeMicroseconds, char *buffer, size_t bufferSize)
+{
+    time_t seconds = time_t(timeMicroseconds / 1000000u);
+    tm localTime;
+#ifdef _WIN32
+    localtime_s(&localTime, &seconds);
+#else
+    localtime_r(&seconds, &localTime);
+#endif
+    size_t length = strftime(buffer, bufferSize, "%Y-%m-%d %H:%M:%S", &localTime);
+    snprintf(buffer + length, bufferSize - length, ".%03u", unsigned(timeMicroseconds / 1000u % 1000u));
+}
+
+static void writeJsonString(std::ostream &stream, const char *str, size_t length)
+{
+    stream << '"';
+    for (size_t i = 0; i < length; i++) {
+        char c = str[i];
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (c == '\n') {
+            stream << "\\n";
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", unsigned(static_cast<unsigned char>(c)));
+            stream << escaped;
+        } else {
+            stream << c;
+        }
+    }
+    stream << '"';
+}
+
+
+void HtmlLogSink::write(const LogMessage &message)
+{
+    lineBuffer.clear();
+    lineBuffer += '[';
+    lineBuffer += message.category;
+    lineBuffer += "] ";
+    lineBuffer.append(message.text, message.textLength);
+    switch (message.level) {
+    case LOG_LEVEL_ERROR:
+        Logfile::get()->writeError(lineBuffer);
+        break;
+    case LOG_LEVEL_WARNING:
+        Logfile::get()->write(lineBuffer, ORANGE);
+        break;
+    case LOG_LEVEL_INFO:
+        Logfile::get()->write(lineBuffer, BLUE);
+        break;
+    default:
+        Logfile::get()->write(lineBuffer, BLACK);
+        break;
+    }
+}
+
+void HtmlLogSink::flush()
+{
+    Logfile::get()->flush();
+}
+
+
+TextLogSink::TextLogSink(const std::string &filename) : file(filename.c_str())
+{
+    if (!file.is_open()) {
+        Logfile::get()->writeError(std::string() + "ERROR: TextLogSink: Cannot open file \"" + filename + "\".");
+    }
+}
+
+void TextLogSink::write(const LogMessage &message)
+{
+    char timeString[32];
+    formatTime(message.timeMicroseconds, timeString, sizeof(timeString));
+    file << timeString << " [" << getLogLevelName(message.level) << "] [" << message.category << "] ";
+    file.write(message.text, message.textLength);
+    file << '\n';
+    if (message.level >= LOG_LEVEL_ERROR) {
+        file.flush();
+    }
+}
+
+void TextLogSink::flush()
+{
+    file.flush();
+}
+
+
+JsonLinesLogSink::JsonLinesLogSink(const std::string &filename) : file(filename.c_str())
+{
+    if (!file.is_open()) {
+        Logfile::get()->writeError(std::string() + "ERROR: JsonLinesLogSink: Cannot open file \"" + filename + "\".");
+    }
+}
+
+void JsonLinesLogSink::write(const LogMessage &message)
+{
+    const char *levelName = getLogLevelName(message.level);
+    file << "{\"time_us\":" << message.timeMicroseconds << ",\"level\":\"" << levelName << "\",\"category\":";
+    writeJsonString(file, message.category, strlen(message.category));
+    file << ",\"file\":";
+    writeJsonString(file, message.file, strlen(message.file));
+    file << ",\"line\":" << message.line << ",\"message\":";
+    writeJsonString(file, message.text, message.textLength);
+    file << "}\n";
+    if (message.level >= LOG_LEVEL_ERROR) {
+        file.flush();
+    }
+}
+
+void JsonLinesLogSink::flush()
+{
+    file.flush();
+}
+
+
+MemoryLogSink::MemoryLogSink(size_t capacity) : capacity(capacity > 0 ? capacity : 1)
+{
+}
+
+void MemoryLogSink::write(const LogMessage &message)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    StoredLogMessage storedMessage;
+    storedMessage.level = message.level;
+    storedMessage.category = message.category;
+    storedMessage.text.assign(message.text, message.textLength);
+    storedMessage.timeMicroseconds = message.timeMicroseconds;
+    if (messages.size() < capacity) {
+        messages.push_back(std::move(storedMessage));
+    } else {
+        messages.at(nextIndex) = std::move(storedMessage);
+    }
+    nextIndex = (nextIndex + 1) % capacity;
+}
+
+std::vector<StoredLogMessage> MemoryLogSink::getMessages()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (messages.size() < capacity) {
+        return messages;
+    }
+    std::vector<StoredLogMessage> orderedMessages;
+    orderedMessages.reserve(messages.size());
+    orderedMessages.insert(orderedMessages.end(), messages.begin() + nextIndex, messages.end());
+    orderedMessages.insert(orderedMessages.end(), messages.begin(), messages.begin() + nextIndex);
+    return orderedMessages;
+}
+
+void MemoryLogSink::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    messages.clear();
+    nextIndex = 0;
+}
+
+}
@@ -0,0 +1,83 @@
+/*!
+ * LogSinks.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_FILE_LOGSINKS_HPP_
+#define UTILS_FILE_LOGSINKS_HPP_
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include "Logger.hpp"
+
+namespace sgl {
+
+//! Writes the messages to the HTML log file of Logfile (errors are also printed on stderr).
+class DLL_OBJECT HtmlLogSink : public LogSink
+{
+public:
+    virtual void write(const LogMessage &message);
+    virtual void flush();
+
+private:
+    //! Reused for every message, so formatting a message doesn't allocate once the buffer is large enough.
+    std::string lineBuffer;
+};
+
+//! One line per message, e.g. "2026-10-18 12:00:00.123 [WARNING] [ShaderManager] Text".
+class DLL_OBJECT TextLogSink : public LogSink
+{
+public:
+    explicit TextLogSink(const std::string &filename);
+    virtual void write(const LogMessage &message);
+    virtual void flush();
+
+private:
+    std::ofstream file;
+};
+
+//! One JSON object per line (JSON Lines), e.g. for log analysis tools.
+class DLL_OBJECT JsonLinesLogSink : public LogSink
+{
+public:
+    explicit JsonLinesLogSink(const std::string &filename);
+    virtual void write(const LogMessage &message);
+    virtual void flush();
+
+private:
+    std::ofstream file;
+};
+
+//! A message stored by MemoryLogSink.
+struct DLL_OBJECT StoredLogMessage {
+    LogLevel level;
+    std::string category;
+    std::string text;
+    uint64_t timeMicroseconds;
+};
+
+//! Keeps the last messages in memory (e.g. for showing them in the GUI or attaching them to crash reports).
+class DLL_OBJECT MemoryLogSink : public LogSink
+{
+public:
+    explicit MemoryLogSink(size_t capacity = 1024);
+    virtual void write(const LogMessage &message);
+    //! Returns the stored messages from the oldest to the newest one.
+    std::vector<StoredLogMessage> getMessages();
+    void clear();
+
+private:
+    std::mutex mutex;
+    size_t capacity;
+    size_t nextIndex = 0;
+    std::vector<StoredLogMessage> messages;
+};
+
+}
+
+/*! UTILS_FILE_LOGSINKS_HPP_ */
+#endif
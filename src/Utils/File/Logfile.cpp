@@ -9,18 +9,85 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <functional>
+#include <cstring>
+#include <csignal>
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <Utils/Convert.hpp>
 #include <Utils/File/Execute.hpp>
+#include <Utils/ConcurrentCircularQueue.hpp>
 
 namespace sgl {
 
-Logfile::Logfile () : closedLogfile(false)
+//! Number of records a thread can queue before it needs to wait for the writer thread.
+#define LOG_THREAD_BUFFER_CAPACITY 4096
+//! How often the writer thread checks for new records
+#define LOG_WRITER_INTERVAL_MS 20
+//! Suppressed records are forgotten after this time
+#define LOG_RATE_LIMIT_WINDOW_MS 1000
+
+/*! The buffer of a thread is retired when the thread exits and reused by the next thread that starts logging, so the
+ * number of buffers is bounded by the maximum number of threads logging at the same time. The buffers are only freed
+ * with the Logfile, which keeps the list safe to walk for the crash signal handler. */
+enum LogThreadBufferState {
+    LOG_THREAD_BUFFER_IN_USE, LOG_THREAD_BUFFER_RETIRED,
+    LOG_THREAD_BUFFER_ORPHANED //!< The Logfile was destroyed while the thread was still running
+};
+
+struct LogThreadBuffer {
+    LogThreadBuffer() : queue(LOG_THREAD_BUFFER_CAPACITY), state(LOG_THREAD_BUFFER_IN_USE) {}
+    SpscCircularQueue<LogRecord> queue;
+    std::atomic<int> state;
+    LogThreadBuffer *next = nullptr;
+    size_t crashCursor = 0; //!< Only used by Logfile::writeQueuedRecordsAfterCrash
+};
+
+//! Retires the buffer of the thread when the thread exits.
+struct LogThreadBufferOwner {
+    ~LogThreadBufferOwner() {
+        if (threadBuffer != nullptr
+                && threadBuffer->state.exchange(LOG_THREAD_BUFFER_RETIRED) == LOG_THREAD_BUFFER_ORPHANED) {
+            delete threadBuffer;
+        }
+    }
+    LogThreadBuffer *threadBuffer = nullptr;
+};
+
+static thread_local LogThreadBufferOwner currentLogThreadBuffer;
+
+#ifndef _WIN32
+//! The signals the crash handler is installed for in asynchronous mode.
+static const int crashSignals[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+#define NUM_CRASH_SIGNALS int(sizeof(crashSignals) / sizeof(*crashSignals))
+static struct sigaction previousCrashSignalActions[NUM_CRASH_SIGNALS];
+//! The Logfile the crash signal handler writes to (nullptr while the handlers are not installed).
+static std::atomic<Logfile*> crashLogfile(nullptr);
+#endif
+
+Logfile::Logfile () : closedLogfile(false), asynchronous(false), nextSequenceNumber(0), numWrittenRecords(0),
+        numQueueingThreads(0), threadBufferList(nullptr)
 {
 }
 
 Logfile::~Logfile ()
 {
     closeLogfile();
+    // Also restores the crash signal handlers (a crash must never reach the destroyed object).
+    stopWriterThread();
+    LogThreadBuffer *threadBuffer = threadBufferList.exchange(nullptr);
+    while (threadBuffer != nullptr) {
+        LogThreadBuffer *nextThreadBuffer = threadBuffer->next;
+        // Buffers of running threads are freed by the threads when they exit.
+        if (threadBuffer->state.exchange(LOG_THREAD_BUFFER_ORPHANED) == LOG_THREAD_BUFFER_RETIRED) {
+            delete threadBuffer;
+        }
+        threadBuffer = nextThreadBuffer;
+    }
 }
 
 void Logfile::closeLogfile()
@@ -30,14 +97,34 @@ void Logfile::closeLogfile()
         return;
     }
     write("<br><br>End of file</font></body></html>");
-    logfile.close();
+    stopWriterThread();
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        std::string buffer;
+        formatSuppressedRecords(buffer, true);
+        logfile.write(buffer.c_str(), buffer.size());
+        logfile.close();
+#ifndef _WIN32
+        if (crashFileDescriptor >= 0) {
+            close(crashFileDescriptor);
+            crashFileDescriptor = -1;
+        }
+#endif
+    }
     closedLogfile = true;
 }
 
 void Logfile::createLogfile (const char *filename, const char *appName)
 {
     // Open file and write header
-    logfile.open(filename);
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        logfile.open(filename);
+#ifndef _WIN32
+        // Appending, as the records written by the crash handler need to go after the ones written by logfile.
+        crashFileDescriptor = open(filename, O_WRONLY | O_APPEND | O_CLOEXEC);
+#endif
+    }
     write(std::string() + "<html><head><title>Logfile (" + appName + ")</title></head>");
     write("<body><font face='courier new'>");
     writeTopic(std::string() + "Logfile (" + appName + ")", 2);
@@ -62,55 +149,412 @@ void Logfile::createLogfile (const char *filename, const char *appName)
 // Create the heading
 void Logfile::writeTopic (const std::string &text, int size)
 {
-    write("<table width='100%%' ");
-    write("bgcolor='#E0E0E5'><tr><td><font face='arial' ");
-    write(std::string() + "size='+" + toString(size) + "'>");
-    write(text);
-    write("</font></td></tr></table>\n<br>");
+    write(std::string() + "<table width='100%%' bgcolor='#E0E0E5'><tr><td><font face='arial' size='+"
+            + toString(size) + "'>" + text + "</font></td></tr></table>\n<br>");
 }
 
 // Write black text to the file
 void Logfile::write(const std::string &text)
 {
-    logfile.write(text.c_str(), text.size());
-    logfile.flush();
+    writeRecord(text, -1);
 }
 
 // Write colored text to the logfile
 void Logfile::write(const std::string &text, int color)
+{
+    writeRecord(text, color);
+}
+
+void Logfile::writeError(const std::string &text)
+{
+    std::cerr << text << '\n';
+    write(text, RED);
+    if (asynchronous) {
+        flush();
+    }
+}
+
+void Logfile::writeInfo(const std::string &text)
+{
+    std::cout << text << std::endl;
+    write(text, BLUE);
+}
+
+
+void Logfile::writeRecord(const std::string &text, int color)
+{
+    LogRecord record;
+    record.sequenceNumber = nextSequenceNumber.fetch_add(1, std::memory_order_relaxed);
+    record.color = color;
+    record.text = text;
+
+    if (asynchronous.load(std::memory_order_relaxed)) {
+        // The flag is checked again after announcing the record, as stopWriterThread first clears the flag and then
+        // waits for the announced records before the final drain (sequentially consistent, so no record is lost).
+        numQueueingThreads.fetch_add(1);
+        if (asynchronous.load()) {
+            // Lock-free, unless the queue of the thread is full (then we need to wait for the writer thread)
+            getThreadBuffer()->queue.push(std::move(record));
+            numQueueingThreads.fetch_sub(1);
+            return;
+        }
+        numQueueingThreads.fetch_sub(1);
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    std::string buffer;
+    formatRecord(record, buffer);
+    if (repeatedRecords.size() > 1024) {
+        formatSuppressedRecords(buffer, false);
+    }
+    logfile.write(buffer.c_str(), buffer.size());
+    logfile.flush();
+    numWrittenRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+LogThreadBuffer *Logfile::getThreadBuffer()
+{
+    LogThreadBuffer *&threadBuffer = currentLogThreadBuffer.threadBuffer;
+    if (threadBuffer != nullptr) {
+        return threadBuffer;
+    }
+
+    // Reuse the buffer of a thread that has exited. Records it still contains were queued before the records of this
+    // thread (and have smaller sequence numbers), so only the single producer changes.
+    for (LogThreadBuffer *retiredBuffer = threadBufferList.load(); retiredBuffer != nullptr;
+            retiredBuffer = retiredBuffer->next) {
+        int state = LOG_THREAD_BUFFER_RETIRED;
+        if (retiredBuffer->state.compare_exchange_strong(state, LOG_THREAD_BUFFER_IN_USE)) {
+            threadBuffer = retiredBuffer;
+            return threadBuffer;
+        }
+    }
+
+    threadBuffer = new LogThreadBuffer;
+    threadBuffer->next = threadBufferList.load();
+    while (!threadBufferList.compare_exchange_weak(threadBuffer->next, threadBuffer)) {}
+    return threadBuffer;
+}
+
+static const char *getFontTag(int color)
 {
     switch (color) {
     case BLACK:
-        write("<font color=black>");  break;
+        return "<font color=black>";
     case WHITE:
-        write("<font color=white>");  break;
+        return "<font color=white>";
     case RED:
-        write("<font color=red>");    break;
+        return "<font color=red>";
     case GREEN:
-        write("<font color=green>");  break;
+        return "<font color=green>";
     case BLUE:
-        write("<font color=blue>");   break;
+        return "<font color=blue>";
     case PURPLE:
-        write("<font color=purple>"); break;
+        return "<font color=purple>";
     case ORANGE:
-        write("<font color=FF6A00>"); break;
-    };
+        return "<font color=FF6A00>";
+    default:
+        return nullptr;
+    }
+}
+
+void Logfile::formatRecord(const LogRecord &record, std::string &buffer)
+{
+    if (maxRepeatsPerSecond > 0) {
+        auto currentTime = std::chrono::steady_clock::now();
+        size_t key = std::hash<std::string>()(record.text) ^ size_t(record.color + 1);
+        RepeatedRecordInfo &info = repeatedRecords[key];
+        if (info.text != record.text || info.color != record.color
+                || currentTime - info.windowStart > std::chrono::milliseconds(LOG_RATE_LIMIT_WINDOW_MS)) {
+            if (info.numSuppressed > 0) {
+                formatSuppressedRecord(info.text, info.numSuppressed, buffer);
+            }
+            info.windowStart = currentTime;
+            info.numRecordsInWindow = 0;
+            info.numSuppressed = 0;
+            info.color = record.color;
+            info.text = record.text;
+        }
+        if (info.numRecordsInWindow >= maxRepeatsPerSecond) {
+            info.numSuppressed++;
+            return;
+        }
+        info.numRecordsInWindow++;
+    }
 
-    write(text);
-    write("</font>");
-    write("<br>");
+    const char *fontTag = getFontTag(record.color);
+    if (fontTag == nullptr) {
+        buffer += record.text;
+        return;
+    }
+    buffer += fontTag;
+    buffer += record.text;
+    buffer += "</font><br>";
 }
 
-void Logfile::writeError(const std::string &text)
+void Logfile::formatSuppressedRecords(std::string &buffer, bool flushAll)
 {
-    std::cerr << text << std::endl;
-    write(text, RED);
+    auto currentTime = std::chrono::steady_clock::now();
+    for (auto it = repeatedRecords.begin(); it != repeatedRecords.end(); ) {
+        RepeatedRecordInfo &info = it->second;
+        if (flushAll || currentTime - info.windowStart > std::chrono::milliseconds(LOG_RATE_LIMIT_WINDOW_MS)) {
+            if (info.numSuppressed > 0) {
+                formatSuppressedRecord(info.text, info.numSuppressed, buffer);
+            }
+            it = repeatedRecords.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
-void Logfile::writeInfo(const std::string &text)
+
+void Logfile::formatSuppressedRecord(const std::string &text, int numSuppressed, std::string &buffer)
 {
-    std::cout << text << std::endl;
-    write(text, BLUE);
+    buffer += "<font color=FF6A00>Message \"" + text + "\" was repeated " + toString(numSuppressed)
+            + " more times</font><br>";
+}
+
+
+void Logfile::setAsynchronous(bool asynchronous)
+{
+    if (asynchronous == this->asynchronous) {
+        return;
+    }
+    if (asynchronous) {
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            stopWriter = false;
+        }
+        this->asynchronous = true;
+        writerThread = std::thread(&Logfile::writerThreadFunction, this);
+        installCrashSignalHandlers();
+    } else {
+        stopWriterThread();
+    }
+}
+
+void Logfile::stopWriterThread()
+{
+    if (!asynchronous) {
+        return;
+    }
+
+    // New records are written directly from now on. The writer thread keeps emptying the queues until the records
+    // announced before the flag was cleared are queued (a thread might wait for space in its full queue).
+    asynchronous = false;
+    while (numQueueingThreads.load() != 0) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        stopWriter = true;
+    }
+    writerConditionVariable.notify_all();
+    writerThread.join();
+
+    // Nothing can be queued anymore, so this is the final drain.
+    {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        writeQueuedRecords();
+    }
+    restoreCrashSignalHandlers();
+}
+
+void Logfile::flush()
+{
+    if (!asynchronous) {
+        return;
+    }
+    const uint64_t numRecords = nextSequenceNumber.load(std::memory_order_relaxed);
+    std::unique_lock<std::mutex> lock(writerMutex);
+    wakeUpWriter = true;
+    writerConditionVariable.notify_all();
+    writerConditionVariable.wait(lock, [this, numRecords] {
+        return stopWriter || numWrittenRecords.load(std::memory_order_acquire) >= numRecords;
+    });
+}
+
+void Logfile::setRateLimit(int maxRepeatsPerSecond)
+{
+    std::lock_guard<std::mutex> lock(fileMutex);
+    this->maxRepeatsPerSecond = maxRepeatsPerSecond;
+    std::string buffer;
+    formatSuppressedRecords(buffer, true);
+    logfile.write(buffer.c_str(), buffer.size());
+}
+
+void Logfile::writeQueuedRecords()
+{
+    for (LogThreadBuffer *threadBuffer = threadBufferList.load(); threadBuffer != nullptr;
+            threadBuffer = threadBuffer->next) {
+        LogRecord record;
+        while (threadBuffer->queue.tryPop(record)) {
+            recordBatch.push_back(std::move(record));
+        }
+    }
+
+    // The records of different threads are merged in the order they were written
+    std::sort(recordBatch.begin(), recordBatch.end(), [](const LogRecord &a, const LogRecord &b) {
+        return a.sequenceNumber < b.sequenceNumber;
+    });
+    std::string buffer;
+    for (const LogRecord &record : recordBatch) {
+        formatRecord(record, buffer);
+    }
+    formatSuppressedRecords(buffer, false);
+    if (!buffer.empty()) {
+        logfile.write(buffer.c_str(), buffer.size());
+        logfile.flush();
+    }
+    numWrittenRecords.fetch_add(recordBatch.size(), std::memory_order_release);
+    recordBatch.clear();
+}
+
+void Logfile::writerThreadFunction()
+{
+    std::unique_lock<std::mutex> lock(writerMutex);
+    while (true) {
+        writerConditionVariable.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_INTERVAL_MS), [this] {
+            return stopWriter || wakeUpWriter;
+        });
+        wakeUpWriter = false;
+        bool stop = stopWriter;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            writeQueuedRecords();
+        }
+        lock.lock();
+        writerConditionVariable.notify_all();
+        if (stop) {
+            return;
+        }
+    }
+}
+
+void Logfile::installCrashSignalHandlers()
+{
+#ifndef _WIN32
+    crashLogfile = this;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = &Logfile::crashSignalHandler;
+    sigemptyset(&action.sa_mask);
+    for (int i = 0; i < NUM_CRASH_SIGNALS; i++) {
+        sigaction(crashSignals[i], &action, &previousCrashSignalActions[i]);
+    }
+#endif
+}
+
+void Logfile::restoreCrashSignalHandlers()
+{
+#ifndef _WIN32
+    if (crashLogfile.exchange(nullptr) == nullptr) {
+        return;
+    }
+    for (int i = 0; i < NUM_CRASH_SIGNALS; i++) {
+        sigaction(crashSignals[i], &previousCrashSignalActions[i], nullptr);
+    }
+#endif
+}
+
+#ifndef _WIN32
+static void writeToFileDescriptor(int fileDescriptor, const char *text, size_t size)
+{
+    while (size > 0) {
+        ssize_t numBytesWritten = ::write(fileDescriptor, text, size);
+        if (numBytesWritten < 0 && errno == EINTR) {
+            continue;
+        }
+        if (numBytesWritten <= 0) {
+            return;
+        }
+        text += numBytesWritten;
+        size -= size_t(numBytesWritten);
+    }
+}
+
+static inline void writeToFileDescriptor(int fileDescriptor, const char *text)
+{
+    writeToFileDescriptor(fileDescriptor, text, strlen(text));
+}
+#endif
+
+void Logfile::writeQueuedRecordsAfterCrash(int signalNumber)
+{
+#ifndef _WIN32
+    // The records of the threads are merged by their sequence number. They are written as they are (i.e., without
+    // rate limiting), and they stay in the queues. Records the writer thread has popped but not written are lost.
+    for (LogThreadBuffer *threadBuffer = threadBufferList.load(); threadBuffer != nullptr;
+            threadBuffer = threadBuffer->next) {
+        threadBuffer->crashCursor = 0;
+    }
+    while (true) {
+        LogThreadBuffer *nextThreadBuffer = nullptr;
+        const LogRecord *nextRecord = nullptr;
+        for (LogThreadBuffer *threadBuffer = threadBufferList.load(); threadBuffer != nullptr;
+                threadBuffer = threadBuffer->next) {
+            const LogRecord *record = threadBuffer->queue.peek(threadBuffer->crashCursor);
+            if (record != nullptr && (nextRecord == nullptr || record->sequenceNumber < nextRecord->sequenceNumber)) {
+                nextThreadBuffer = threadBuffer;
+                nextRecord = record;
+            }
+        }
+        if (nextRecord == nullptr) {
+            break;
+        }
+        nextThreadBuffer->crashCursor++;
+
+        const char *fontTag = getFontTag(nextRecord->color);
+        if (fontTag != nullptr) {
+            writeToFileDescriptor(crashFileDescriptor, fontTag);
+        }
+        writeToFileDescriptor(crashFileDescriptor, nextRecord->text.data(), nextRecord->text.size());
+        if (fontTag != nullptr) {
+            writeToFileDescriptor(crashFileDescriptor, "</font><br>");
+        }
+    }
+
+    // snprintf is not async-signal-safe.
+    char signalNumberString[16];
+    int numDigits = 0;
+    unsigned int value = unsigned(signalNumber);
+    do {
+        signalNumberString[numDigits++] = char('0' + value % 10);
+        value /= 10;
+    } while (value != 0 && numDigits < 15);
+    std::reverse(signalNumberString, signalNumberString + numDigits);
+    signalNumberString[numDigits] = '\0';
+    writeToFileDescriptor(crashFileDescriptor, "<br><font color=red>The program crashed (signal ");
+    writeToFileDescriptor(crashFileDescriptor, signalNumberString);
+    writeToFileDescriptor(crashFileDescriptor, ").</font><br>");
+#else
+    (void)signalNumber;
+#endif
+}
+
+void Logfile::crashSignalHandler(int signalNumber)
+{
+#ifndef _WIN32
+    // Only the first crashing thread writes the records.
+    Logfile *logfile = crashLogfile.exchange(nullptr);
+    if (logfile != nullptr && logfile->crashFileDescriptor >= 0) {
+        logfile->writeQueuedRecordsAfterCrash(signalNumber);
+    }
+
+    // Chain to the previous handlers (or the default actions). The signal is blocked while this handler runs, so the
+    // raised signal is delivered to the restored handler when this one returns (a faulting instruction also triggers
+    // the signal again when it is executed again).
+    if (logfile != nullptr) {
+        for (int i = 0; i < NUM_CRASH_SIGNALS; i++) {
+            sigaction(crashSignals[i], &previousCrashSignalActions[i], nullptr);
+        }
+    }
+    raise(signalNumber);
+#else
+    (void)signalNumber;
+#endif
 }
 
 }
@@ -9,6 +9,15 @@
 #define SRC_UTILS_FILE_LOGFILE_HPP_
 
 #include <fstream>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
 #include <Utils/Singleton.hpp>
 
 namespace sgl {
@@ -18,6 +27,14 @@ enum FONTCOLORS {
     BLACK, WHITE, RED, GREEN, BLUE, PURPLE, ORANGE
 };
 
+//! Record of the asynchronous mode (color -1 means text without color tags).
+struct LogRecord {
+    uint64_t sequenceNumber;
+    int color;
+    std::string text;
+};
+struct LogThreadBuffer;
+
 class Logfile : public Singleton<Logfile>
 {
 public:
@@ -30,14 +47,75 @@ public:
     void writeTopic(const std::string &text, int size);
     void write(const std::string &text);
     void write(const std::string &text, int color);
-    //! Outputs text on stderr, too
+    //! Outputs text on stderr, too (and flushes the log file in asynchronous mode)
     void writeError(const std::string &text);
     //! Outputs text on stdout, too
     void writeInfo(const std::string &text);
 
+    /*! In asynchronous mode, the write functions only append the text to a lock-free queue of the calling thread, and
+     * a background thread writes the queued records in batches (with one flush per batch). The log file is flushed
+     * explicitly on errors and when closing it. On POSIX systems, the queued records are also written if the program
+     * crashes (SIGSEGV, SIGABRT, SIGFPE or SIGILL). The signal handlers are only installed while the asynchronous mode
+     * is active, and the previously installed handlers are restored afterwards and called after writing the records.
+     * By default, every record is written and flushed directly. */
+    void setAsynchronous(bool asynchronous);
+    inline bool getAsynchronous() const { return asynchronous.load(std::memory_order_relaxed); }
+    //! Waits until all records written so far are in the file.
+    void flush();
+    /*! Writes at most maxRepeatsPerSecond identical records per second. The suppressed records are counted and
+     * reported once the second is over. 0 disables the rate limiting (the default). */
+    void setRateLimit(int maxRepeatsPerSecond);
+
 private:
+    //! -1 means text without color tags
+    void writeRecord(const std::string &text, int color);
+    //! Appends the HTML for the record to buffer (or nothing if the record is suppressed by the rate limit).
+    void formatRecord(const LogRecord &record, std::string &buffer);
+    void formatSuppressedRecords(std::string &buffer, bool flushAll);
+    static void formatSuppressedRecord(const std::string &text, int numSuppressed, std::string &buffer);
+    //! Writes all queued records. Expects fileMutex to be locked.
+    void writeQueuedRecords();
+    void writerThreadFunction();
+    void stopWriterThread();
+    LogThreadBuffer *getThreadBuffer();
+    void installCrashSignalHandlers();
+    void restoreCrashSignalHandlers();
+    static void crashSignalHandler(int signalNumber);
+    //! Only uses async-signal-safe functions (no locks, allocations or streams).
+    void writeQueuedRecordsAfterCrash(int signalNumber);
+
     bool closedLogfile;
     std::ofstream logfile;
+    //! Second descriptor of the log file (opened for appending) the crash signal handler writes to (POSIX only).
+    int crashFileDescriptor = -1;
+    //! Protects the file and the rate limit state. In asynchronous mode, only the thread holding it pops records.
+    std::mutex fileMutex;
+
+    // Asynchronous mode
+    std::atomic<bool> asynchronous;
+    std::thread writerThread;
+    std::mutex writerMutex;
+    std::condition_variable writerConditionVariable;
+    bool stopWriter = false;
+    bool wakeUpWriter = false;
+    std::atomic<uint64_t> nextSequenceNumber;
+    std::atomic<uint64_t> numWrittenRecords;
+    //! Threads currently queueing a record (stopWriterThread waits for them before the final drain).
+    std::atomic<int> numQueueingThreads;
+    //! Lock-free singly linked list, so that the crash signal handler can walk it.
+    std::atomic<LogThreadBuffer*> threadBufferList;
+    std::vector<LogRecord> recordBatch;
+
+    // Rate limiting of repeated records
+    struct RepeatedRecordInfo {
+        std::chrono::steady_clock::time_point windowStart;
+        int numRecordsInWindow = 0;
+        int numSuppressed = 0;
+        int color = -1;
+        std::string text;
+    };
+    int maxRepeatsPerSecond = 0;
+    std::map<size_t, RepeatedRecordInfo> repeatedRecords;
 };
 
 }
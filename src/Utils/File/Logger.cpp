@@ -0,0 +1,191 @@
+/*
+ * Logger.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <cstdio>
+#include <cstdarg>
+#include <chrono>
+#include <algorithm>
+#include "Logger.hpp"
+#include "LogSinks.hpp"
+
+namespace sgl {
+
+//! Messages up to this length are formatted without allocating memory.
+#define LOG_STACK_BUFFER_SIZE 1024
+
+const char *getLogLevelName(LogLevel level)
+{
+    switch (level) {
+    case LOG_LEVEL_TRACE:
+        return "TRACE";
+    case LOG_LEVEL_DEBUG:
+        return "DEBUG";
+    case LOG_LEVEL_INFO:
+        return "INFO";
+    case LOG_LEVEL_WARNING:
+        return "WARNING";
+    case LOG_LEVEL_ERROR:
+        return "ERROR";
+    default:
+        return "NONE";
+    }
+}
+
+LogCategory::LogCategory(const char *name) : name(name), minLevel(LOG_LEVEL_INFO)
+{
+    Logger::get()->registerCategory(this);
+}
+
+LogCategory::~LogCategory()
+{
+    Logger::get()->unregisterCategory(this);
+}
+
+LogCategory &getDefaultLogCategory()
+{
+    static LogCategory defaultCategory("sgl");
+    return defaultCategory;
+}
+
+
+Logger *Logger::get()
+{
+    static Logger *logger = new Logger;
+    return logger;
+}
+
+Logger::Logger() : defaultLevel(LOG_LEVEL_INFO)
+{
+    sinks.push_back(LogSinkPtr(new HtmlLogSink));
+}
+
+void Logger::registerCategory(LogCategory *category)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    categories.push_back(category);
+    auto it = categoryLevels.find(category->name);
+    category->minLevel.store(it != categoryLevels.end() ? it->second : defaultLevel, std::memory_order_relaxed);
+}
+
+void Logger::unregisterCategory(LogCategory *category)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    categories.erase(std::remove(categories.begin(), categories.end(), category), categories.end());
+}
+
+void Logger::setLevel(LogLevel level)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    defaultLevel = level;
+    for (LogCategory *category : categories) {
+        if (categoryLevels.find(category->name) == categoryLevels.end()) {
+            category->minLevel.store(level, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::setCategoryLevel(const std::string &categoryName, LogLevel level)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    categoryLevels[categoryName] = level;
+    for (LogCategory *category : categories) {
+        if (categoryName == category->name) {
+            category->minLevel.store(level, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::addSink(const LogSinkPtr &sink)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sinks.push_back(sink);
+}
+
+void Logger::removeSink(const LogSinkPtr &sink)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), sink), sinks.end());
+}
+
+void Logger::clearSinks()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sinks.clear();
+}
+
+void Logger::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (LogSinkPtr &sink : sinks) {
+        sink->flush();
+    }
+}
+
+
+static uint64_t getWallClockMicroseconds()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void Logger::log(LogLevel level, const LogCategory &category, const char *file, int line, const char *format, ...)
+{
+    char stackBuffer[LOG_STACK_BUFFER_SIZE];
+    std::vector<char> heapBuffer;
+    char *text = stackBuffer;
+
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(stackBuffer, LOG_STACK_BUFFER_SIZE, format, arguments);
+    va_end(arguments);
+    if (length < 0) {
+        return;
+    }
+    if (length >= LOG_STACK_BUFFER_SIZE) {
+        heapBuffer.resize(size_t(length) + 1);
+        va_start(arguments, format);
+        vsnprintf(heapBuffer.data(), heapBuffer.size(), format, arguments);
+        va_end(arguments);
+        text = heapBuffer.data();
+    }
+
+    LogMessage message;
+    message.level = level;
+    message.category = category.getName();
+    message.text = text;
+    message.textLength = size_t(length);
+    message.timeMicroseconds = getWallClockMicroseconds();
+    message.file = file;
+    message.line = line;
+    dispatch(message);
+}
+
+void Logger::logString(LogLevel level, const LogCategory &category, const std::string &text)
+{
+    if (!category.isEnabled(level)) {
+        return;
+    }
+    LogMessage message;
+    message.level = level;
+    message.category = category.getName();
+    message.text = text.c_str();
+    message.textLength = text.size();
+    message.timeMicroseconds = getWallClockMicroseconds();
+    message.file = "";
+    message.line = 0;
+    dispatch(message);
+}
+
+void Logger::dispatch(const LogMessage &message)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (LogSinkPtr &sink : sinks) {
+        sink->write(message);
+    }
+}
+
+}
@@ -0,0 +1,145 @@
+/*!
+ * Logger.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_FILE_LOGGER_HPP_
+#define UTILS_FILE_LOGGER_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <Defs.hpp>
+
+/*
+ * Structured logging with severity levels, categories and pluggable sinks (see LogSinks.hpp).
+ * The level of the category is checked before the arguments are evaluated or any formatting happens, so disabled
+ * debug messages only cost a relaxed atomic load. Messages use printf-style format strings, which GCC and Clang check
+ * at compile time. The text is formatted into a stack buffer (no temporary strings).
+ * Usage:
+ *   static sgl::LogCategory shaderLog("ShaderManager");
+ *   SGL_LOG_DEBUG(shaderLog, "Compiled shader \"%s\" in %.2fms", name.c_str(), timeMS);
+ *   sgl::Logger::get()->setCategoryLevel("ShaderManager", sgl::LOG_LEVEL_DEBUG);
+ * Messages below SGL_LOG_MIN_LEVEL (e.g. -DSGL_LOG_MIN_LEVEL=2 for INFO) are removed at compile time.
+ */
+#ifndef SGL_LOG_MIN_LEVEL
+#define SGL_LOG_MIN_LEVEL 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SGL_PRINTF_FORMAT(formatIndex, firstArgumentIndex) \
+        __attribute__((format(printf, formatIndex, firstArgumentIndex)))
+#else
+#define SGL_PRINTF_FORMAT(formatIndex, firstArgumentIndex)
+#endif
+
+#define SGL_LOG(level, category, ...) \
+        do { \
+            if (int(level) >= SGL_LOG_MIN_LEVEL && (category).isEnabled(level)) { \
+                sgl::Logger::get()->log((level), (category), __FILE__, __LINE__, __VA_ARGS__); \
+            } \
+        } while (0)
+#define SGL_LOG_TRACE(category, ...) SGL_LOG(sgl::LOG_LEVEL_TRACE, category, __VA_ARGS__)
+#define SGL_LOG_DEBUG(category, ...) SGL_LOG(sgl::LOG_LEVEL_DEBUG, category, __VA_ARGS__)
+#define SGL_LOG_INFO(category, ...) SGL_LOG(sgl::LOG_LEVEL_INFO, category, __VA_ARGS__)
+#define SGL_LOG_WARNING(category, ...) SGL_LOG(sgl::LOG_LEVEL_WARNING, category, __VA_ARGS__)
+#define SGL_LOG_ERROR(category, ...) SGL_LOG(sgl::LOG_LEVEL_ERROR, category, __VA_ARGS__)
+
+namespace sgl {
+
+enum LogLevel {
+    LOG_LEVEL_TRACE = 0, LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARNING, LOG_LEVEL_ERROR, LOG_LEVEL_NONE
+};
+DLL_OBJECT const char *getLogLevelName(LogLevel level);
+
+//! A message as passed to the sinks. The pointers are only valid during the call of LogSink::write.
+struct DLL_OBJECT LogMessage {
+    LogLevel level;
+    const char *category;
+    const char *text;
+    size_t textLength;
+    //! Wall clock time (microseconds since the Unix epoch)
+    uint64_t timeMicroseconds;
+    const char *file;
+    int line;
+};
+
+//! Sinks receive the messages that pass the level filter (see LogSinks.hpp for the implementations).
+class DLL_OBJECT LogSink
+{
+public:
+    virtual ~LogSink() {}
+    //! Called with the mutex of the logger locked, i.e., never concurrently for one sink.
+    virtual void write(const LogMessage &message)=0;
+    virtual void flush() {}
+};
+typedef std::shared_ptr<LogSink> LogSinkPtr;
+
+/*! Category of log messages (usually one static object per module). The level is cached in the object, so checking
+ * it does not need a lookup. */
+class DLL_OBJECT LogCategory
+{
+public:
+    explicit LogCategory(const char *name);
+    ~LogCategory();
+    LogCategory(const LogCategory&) = delete;
+    LogCategory &operator=(const LogCategory&) = delete;
+
+    inline bool isEnabled(LogLevel level) const { return int(level) >= minLevel.load(std::memory_order_relaxed); }
+    inline const char *getName() const { return name; }
+
+private:
+    friend class Logger;
+    const char *name;
+    std::atomic<int> minLevel;
+};
+
+//! Category for messages of modules without their own category.
+DLL_OBJECT LogCategory &getDefaultLogCategory();
+
+class DLL_OBJECT Logger
+{
+public:
+    //! Thread-safe; the logger is created on first use and never destroyed (so static objects can log at exit).
+    static Logger *get();
+
+    //! Sets the level of all categories without their own level (LOG_LEVEL_INFO by default).
+    void setLevel(LogLevel level);
+    //! Overrides the level of a category (also for categories that are constructed later).
+    void setCategoryLevel(const std::string &categoryName, LogLevel level);
+
+    //! By default, the messages are written to the HTML log file (HtmlLogSink).
+    void addSink(const LogSinkPtr &sink);
+    void removeSink(const LogSinkPtr &sink);
+    void clearSinks();
+    void flush();
+
+    //! Use the SGL_LOG macros instead, which check the level before the arguments are evaluated.
+    void log(LogLevel level, const LogCategory &category, const char *file, int line, const char *format, ...)
+            SGL_PRINTF_FORMAT(6, 7);
+    void logString(LogLevel level, const LogCategory &category, const std::string &text);
+
+private:
+    Logger();
+    friend class LogCategory;
+    void registerCategory(LogCategory *category);
+    void unregisterCategory(LogCategory *category);
+    void dispatch(const LogMessage &message);
+
+    std::mutex mutex;
+    std::vector<LogSinkPtr> sinks;
+    LogLevel defaultLevel;
+    std::vector<LogCategory*> categories;
+    std::map<std::string, LogLevel> categoryLevels;
+};
+
+}
+
+/*! UTILS_FILE_LOGGER_HPP_ */
+#endif
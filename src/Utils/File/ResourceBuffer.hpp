@@ -10,14 +10,17 @@
 
 #include <boost/shared_ptr.hpp>
 #include <atomic>
+#include <Utils/MemoryTracker.hpp>
 
 namespace sgl {
 
 class ResourceBuffer
 {
 public:
-    ResourceBuffer(size_t size) : bufferSize(size), loaded(false) { data = new char[bufferSize]; }
-    ~ResourceBuffer() { if (data) { delete[] data; data = NULL; } }
+    ResourceBuffer(size_t size) : bufferSize(size), loaded(false) {
+        data = newTrackedArray<char>(bufferSize, MEMORY_TAG_RESOURCE_BUFFER);
+    }
+    ~ResourceBuffer() { if (data) { deleteTrackedArray(data); data = NULL; } }
     inline char *getBuffer() { return data; }
     inline const char *getBuffer() const { return data; }
     inline size_t getBufferSize() { return bufferSize; }
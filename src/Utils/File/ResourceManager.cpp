@@ -8,18 +8,31 @@
 #include "ResourceManager.hpp"
 #include "ResourceBuffer.hpp"
 #include <Utils/File/FileUtils.hpp>
+#include <Utils/TraceRecorder.hpp>
+#include <Utils/Metrics.hpp>
 #include <fstream>
 #include <boost/shared_ptr.hpp>
 
 namespace sgl {
 
+static MetricCounter &filesLoadedCounter = MetricsRegistry::get()->getCounter(
+        "resources.files_loaded", "Number of files read by ResourceManager");
+static MetricCounter &bytesLoadedCounter = MetricsRegistry::get()->getCounter(
+        "resources.bytes_loaded", "Number of bytes read by ResourceManager");
+static MetricCounter &cacheHitsCounter = MetricsRegistry::get()->getCounter(
+        "resources.cache_hits", "Requests for files that were still in memory");
+static MetricHistogram &fileSizeHistogram = MetricsRegistry::get()->getHistogram(
+        "resources.file_size_bytes", "Sizes of the files read by ResourceManager");
+
 ResourceBufferPtr ResourceManager::getFileSync(const char *filename)
 {
     ResourceBufferPtr resource = getResourcePointer(filename);
 
     // Is the file already loaded?
-    if (resource)
+    if (resource) {
+        cacheHitsCounter.add();
         return resource;
+    }
 
     // Load the resource on this thread otherwise
     if (FileUtils::get()->exists(filename) && !FileUtils::get()->isDirectory(filename)) {
@@ -35,6 +48,7 @@ ResourceBufferPtr ResourceManager::getFileSync(const char *filename)
 
 bool ResourceManager::loadFile(const char *filename, ResourceBufferPtr &resource)
 {
+    SGL_TRACE_SCOPE_CATEGORY("ResourceManager::loadFile", "loading");
     //assert(resource.get() && "ResourceManager::loadFile: resource.get()");
     std::streampos size;
     std::ifstream file(filename, std::ios::in|std::ios::binary|std::ios::ate);
@@ -44,6 +58,9 @@ bool ResourceManager::loadFile(const char *filename, ResourceBufferPtr &resource
         file.seekg(0, std::ios::beg);
         file.read(resource->getBuffer(), size);
         file.close();
+        filesLoadedCounter.add();
+        bytesLoadedCounter.add(uint64_t(size));
+        fileSizeHistogram.record(uint64_t(size));
         //resource->setIsLoaded();
         return true;
     }
@@ -0,0 +1,186 @@
+/*
+ * FrameStatistics.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "FrameStatistics.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sgl {
+
+// Histogram buckets: Values below 2^(SUB_BUCKET_BITS+1) have their own bucket, and every further power of two is split
+// into 2^SUB_BUCKET_BITS buckets. Frame times are clamped to 2^MAX_VALUE_BITS ns (~18 minutes).
+#define SUB_BUCKET_BITS 5
+#define NUM_SUB_BUCKETS (1u << SUB_BUCKET_BITS)
+#define MAX_VALUE_BITS 40
+#define NUM_BUCKETS ((MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * NUM_SUB_BUCKETS)
+#define HITCH_FLAG (uint64_t(1) << 63)
+//! Weight of new frames in the moving average of the typical frame time
+#define TYPICAL_FRAME_TIME_WEIGHT 0.1
+
+static inline int getMostSignificantBit(uint64_t value)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return int(index);
+#else
+    int msb = 0;
+    while (value >>= 1) {
+        msb++;
+    }
+    return msb;
+#endif
+}
+
+FrameStatistics::FrameStatistics(size_t windowSize, double hitchFactor)
+        : windowSize(std::max(windowSize, size_t(1))), hitchFactor(hitchFactor)
+{
+    frameTimesNS.resize(this->windowSize, 0);
+    histogram.resize(NUM_BUCKETS, 0);
+}
+
+void FrameStatistics::clear()
+{
+    std::fill(frameTimesNS.begin(), frameTimesNS.end(), 0);
+    std::fill(histogram.begin(), histogram.end(), 0);
+    writeIndex = 0;
+    numFrames = 0;
+    sumFrameTimesNS = 0;
+    numHitches = 0;
+    typicalFrameTimeNS = 0.0;
+    lastFrameTimeNS = 0;
+    lastFrameWasHitch = false;
+    totalNumHitches = 0;
+}
+
+size_t FrameStatistics::getBucketIndex(uint64_t valueNS)
+{
+    valueNS = std::min(valueNS, (uint64_t(1) << MAX_VALUE_BITS) - 1);
+    if (valueNS < 2 * NUM_SUB_BUCKETS) {
+        return size_t(valueNS);
+    }
+    int shift = getMostSignificantBit(valueNS) - SUB_BUCKET_BITS;
+    size_t mantissa = size_t(valueNS >> shift); // In [NUM_SUB_BUCKETS, 2 * NUM_SUB_BUCKETS)
+    return size_t(shift + 1) * NUM_SUB_BUCKETS + (mantissa - NUM_SUB_BUCKETS);
+}
+
+double FrameStatistics::getBucketValueNS(size_t bucketIndex)
+{
+    if (bucketIndex < 2 * NUM_SUB_BUCKETS) {
+        return double(bucketIndex);
+    }
+    int shift = int(bucketIndex / NUM_SUB_BUCKETS) - 1;
+    uint64_t mantissa = bucketIndex % NUM_SUB_BUCKETS + NUM_SUB_BUCKETS;
+    // Center of the bucket
+    return double(mantissa << shift) + double((uint64_t(1) << shift) - 1) * 0.5;
+}
+
+bool FrameStatistics::addFrameTime(uint64_t frameTimeNS)
+{
+    frameTimeNS &= ~HITCH_FLAG;
+    bool isHitch = typicalFrameTimeNS > 0.0 && double(frameTimeNS) > hitchFactor * typicalFrameTimeNS;
+
+    // Hitches only move the typical frame time slowly, so a persistent slowdown stops counting as hitch after a while
+    if (typicalFrameTimeNS <= 0.0) {
+        typicalFrameTimeNS = double(frameTimeNS);
+    } else {
+        double clampedFrameTimeNS = std::min(double(frameTimeNS), hitchFactor * typicalFrameTimeNS);
+        typicalFrameTimeNS += TYPICAL_FRAME_TIME_WEIGHT * (clampedFrameTimeNS - typicalFrameTimeNS);
+    }
+
+    // Remove the oldest frame from the window
+    if (numFrames == windowSize) {
+        uint64_t oldEntry = frameTimesNS.at(writeIndex);
+        uint64_t oldFrameTimeNS = oldEntry & ~HITCH_FLAG;
+        histogram.at(getBucketIndex(oldFrameTimeNS))--;
+        sumFrameTimesNS -= oldFrameTimeNS;
+        if ((oldEntry & HITCH_FLAG) != 0) {
+            numHitches--;
+        }
+    } else {
+        numFrames++;
+    }
+
+    frameTimesNS.at(writeIndex) = frameTimeNS | (isHitch ? HITCH_FLAG : 0);
+    writeIndex = (writeIndex + 1) % windowSize;
+    histogram.at(getBucketIndex(frameTimeNS))++;
+    sumFrameTimesNS += frameTimeNS;
+    if (isHitch) {
+        numHitches++;
+        totalNumHitches++;
+    }
+
+    lastFrameTimeNS = frameTimeNS;
+    lastFrameWasHitch = isHitch;
+    return isHitch;
+}
+
+double FrameStatistics::getPercentileMS(double percentile) const
+{
+    if (numFrames == 0) {
+        return 0.0;
+    }
+    size_t rank = size_t(std::ceil(percentile / 100.0 * double(numFrames)));
+    rank = std::max(std::min(rank, numFrames), size_t(1));
+    size_t count = 0;
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+        count += histogram.at(i);
+        if (count >= rank) {
+            return getBucketValueNS(i) * 1e-6;
+        }
+    }
+    return getBucketValueNS(NUM_BUCKETS - 1) * 1e-6;
+}
+
+FrameTimeStatistics FrameStatistics::computeStatistics() const
+{
+    FrameTimeStatistics statistics;
+    statistics.numFrames = numFrames;
+    statistics.numHitches = numHitches;
+    if (numFrames == 0) {
+        return statistics;
+    }
+
+    statistics.avgMS = double(sumFrameTimesNS) / double(numFrames) * 1e-6;
+    statistics.avgFPS = statistics.avgMS > 0.0 ? 1000.0 / statistics.avgMS : 0.0;
+
+    // One pass over the histogram for all percentiles
+    const double percentiles[3] = { 50.0, 95.0, 99.0 };
+    double *results[3] = { &statistics.p50MS, &statistics.p95MS, &statistics.p99MS };
+    int nextPercentile = 0;
+    size_t count = 0;
+    for (size_t i = 0; i < NUM_BUCKETS && nextPercentile < 3; i++) {
+        count += histogram.at(i);
+        while (nextPercentile < 3) {
+            size_t rank = size_t(std::ceil(percentiles[nextPercentile] / 100.0 * double(numFrames)));
+            if (count < std::max(rank, size_t(1))) {
+                break;
+            }
+            *results[nextPercentile] = getBucketValueNS(i) * 1e-6;
+            nextPercentile++;
+        }
+    }
+
+    // The maximum is exact (the histogram only knows the bucket)
+    uint64_t maxFrameTimeNS = 0;
+    for (size_t i = 0; i < numFrames; i++) {
+        maxFrameTimeNS = std::max(maxFrameTimeNS, frameTimesNS.at(i) & ~HITCH_FLAG);
+    }
+    statistics.maxMS = double(maxFrameTimeNS) * 1e-6;
+    statistics.p50MS = std::min(statistics.p50MS, statistics.maxMS);
+    statistics.p95MS = std::min(statistics.p95MS, statistics.maxMS);
+    statistics.p99MS = std::min(statistics.p99MS, statistics.maxMS);
+    return statistics;
+}
+
+}
@@ -0,0 +1,75 @@
+/*!
+ * FrameStatistics.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_FRAMESTATISTICS_HPP_
+#define UTILS_FRAMESTATISTICS_HPP_
+
+#include <cstdint>
+#include <vector>
+#include <Defs.hpp>
+
+namespace sgl {
+
+//! Frame times in milliseconds over the window of a FrameStatistics object.
+struct DLL_OBJECT FrameTimeStatistics {
+    double avgMS = 0.0;
+    double p50MS = 0.0;
+    double p95MS = 0.0;
+    double p99MS = 0.0;
+    double maxMS = 0.0;
+    double avgFPS = 0.0; //!< 1000 / avgMS
+    size_t numFrames = 0; //!< Number of frames in the window
+    size_t numHitches = 0; //!< Number of hitches in the window
+};
+
+/*! Keeps the frame times of the last frames in a ring and maintains a log-linear histogram (like an HDR histogram with
+ * 5 bits of precision, i.e., <= 1.6% relative error) of the frames in the ring. Adding a frame is O(1), and the
+ * percentiles are computed from the histogram, i.e., independent of the window size.
+ * A frame counts as hitch if it takes longer than hitchFactor times the typical frame time (a moving average that
+ * ignores the hitches themselves). Average FPS hide these frames, which are what makes an application feel stuttery.
+ */
+class DLL_OBJECT FrameStatistics
+{
+public:
+    explicit FrameStatistics(size_t windowSize = 1024, double hitchFactor = 2.0);
+    //! Returns whether the frame is a hitch.
+    bool addFrameTime(uint64_t frameTimeNS);
+    void clear();
+
+    //! percentile in [0, 100]
+    double getPercentileMS(double percentile) const;
+    FrameTimeStatistics computeStatistics() const;
+    inline uint64_t getLastFrameTimeNS() const { return lastFrameTimeNS; }
+    inline bool getLastFrameWasHitch() const { return lastFrameWasHitch; }
+    //! Total number of hitches since the creation or the last call to clear.
+    inline size_t getTotalNumHitches() const { return totalNumHitches; }
+
+private:
+    static size_t getBucketIndex(uint64_t valueNS);
+    static double getBucketValueNS(size_t bucketIndex);
+
+    size_t windowSize;
+    double hitchFactor;
+
+    // Ring of the last frame times (the highest bit marks hitches)
+    std::vector<uint64_t> frameTimesNS;
+    size_t writeIndex = 0;
+    size_t numFrames = 0;
+    uint64_t sumFrameTimesNS = 0;
+    size_t numHitches = 0;
+    std::vector<uint32_t> histogram;
+
+    double typicalFrameTimeNS = 0.0;
+    uint64_t lastFrameTimeNS = 0;
+    bool lastFrameWasHitch = false;
+    size_t totalNumHitches = 0;
+};
+
+}
+
+/*! UTILS_FRAMESTATISTICS_HPP_ */
+#endif
@@ -30,6 +30,6 @@ float FramerateSmoother::computeAverage()
 float FramerateSmoother::computeMedian()
 {
     std::vector<float> sortedSamples = samples;
-    std::sort(sortedSamples.begin(), sortedSamples.end());
+    std::nth_element(sortedSamples.begin(), sortedSamples.begin() + numSamples/2, sortedSamples.end());
     return sortedSamples.at(numSamples/2);
 }
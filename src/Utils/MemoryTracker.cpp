@@ -0,0 +1,253 @@
+/*
+ * MemoryTracker.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "MemoryTracker.hpp"
+
+#ifdef SGL_MEMORY_TRACKING
+#include <cstdlib>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <sstream>
+#include <Utils/Metrics.hpp>
+#include <Utils/Convert.hpp>
+#include <Utils/File/Logfile.hpp>
+#if defined(__GLIBC__)
+#include <execinfo.h>
+#endif
+#endif
+
+namespace sgl {
+
+const char *getMemoryTagName(MemoryTag tag)
+{
+    switch (tag) {
+    case MEMORY_TAG_BITMAP:
+        return "bitmap";
+    case MEMORY_TAG_RESOURCE_BUFFER:
+        return "resource_buffer";
+    case MEMORY_TAG_STREAM:
+        return "stream";
+    case MEMORY_TAG_LINE_READER:
+        return "line_reader";
+    case MEMORY_TAG_CIRCULAR_QUEUE:
+        return "circular_queue";
+    default:
+        return "other";
+    }
+}
+
+#ifdef SGL_MEMORY_TRACKING
+
+//! The live allocations are distributed over multiple maps to reduce lock contention.
+#define MEMORY_NUM_ALLOCATION_SHARDS 16
+
+struct AllocationInfo {
+    size_t size;
+    MemoryTag tag;
+    uint64_t allocationIndex;
+    std::vector<void*> callStack; //!< Only for sampled allocations
+};
+
+struct AllocationShard {
+    std::mutex mutex;
+    std::unordered_map<const void*, AllocationInfo> allocations;
+};
+
+struct MemoryTagMetrics {
+    MetricGauge *bytes;
+    MetricGauge *peakBytes;
+    MetricGauge *liveAllocations;
+    MetricCounter *allocations;
+};
+
+struct MemoryTrackerData {
+    MemoryTrackerData() : allocationCounter(0), callStackSamplingInterval(0) {}
+    AllocationShard shards[MEMORY_NUM_ALLOCATION_SHARDS];
+    //! One entry per tag, and the totals in the last entry.
+    MemoryTagMetrics tagMetrics[NUM_MEMORY_TAGS + 1];
+    std::atomic<uint64_t> allocationCounter;
+    std::atomic<uint32_t> callStackSamplingInterval;
+};
+
+static inline AllocationShard &getAllocationShard(MemoryTrackerData *data, const void *pointer)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+    return data->shards[((address >> 4) ^ (address >> 12)) % MEMORY_NUM_ALLOCATION_SHARDS];
+}
+
+MemoryTracker *MemoryTracker::get()
+{
+    static MemoryTracker *tracker = new MemoryTracker;
+    return tracker;
+}
+
+MemoryTracker::MemoryTracker() : data(new MemoryTrackerData)
+{
+    MetricsRegistry *registry = MetricsRegistry::get();
+    for (int i = 0; i <= NUM_MEMORY_TAGS; i++) {
+        const char *tagName = i == NUM_MEMORY_TAGS ? "total" : getMemoryTagName(MemoryTag(i));
+        std::string prefix = std::string() + "memory." + tagName;
+        MemoryTagMetrics &tagMetrics = data->tagMetrics[i];
+        tagMetrics.bytes = &registry->getGauge(prefix + ".bytes", "Size of the live tracked allocations");
+        tagMetrics.peakBytes = &registry->getGauge(prefix + ".peak_bytes", "High-water mark of the live allocations");
+        tagMetrics.liveAllocations = &registry->getGauge(prefix + ".live_allocations", "Number of live allocations");
+        tagMetrics.allocations = &registry->getCounter(prefix + ".allocations", "Number of allocations");
+    }
+}
+
+void MemoryTracker::onAllocate(const void *pointer, size_t size, MemoryTag tag)
+{
+    AllocationInfo info;
+    info.size = size;
+    info.tag = tag;
+    info.allocationIndex = data->allocationCounter.fetch_add(1, std::memory_order_relaxed);
+#if defined(__GLIBC__)
+    uint32_t samplingInterval = data->callStackSamplingInterval.load(std::memory_order_relaxed);
+    if (samplingInterval != 0 && info.allocationIndex % samplingInterval == 0) {
+        void *frames[MEMORY_MAX_CALL_STACK_DEPTH];
+        int numFrames = backtrace(frames, MEMORY_MAX_CALL_STACK_DEPTH);
+        // Skip onAllocate itself.
+        if (numFrames > 1) {
+            info.callStack.assign(frames + 1, frames + numFrames);
+        }
+    }
+#endif
+
+    AllocationShard &shard = getAllocationShard(data, pointer);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.allocations[pointer] = std::move(info);
+    }
+
+    for (int i : { int(tag), int(NUM_MEMORY_TAGS) }) {
+        MemoryTagMetrics &tagMetrics = data->tagMetrics[i];
+        tagMetrics.allocations->add();
+        tagMetrics.liveAllocations->add(1);
+        tagMetrics.peakBytes->setMax(tagMetrics.bytes->add(int64_t(size)));
+    }
+}
+
+void MemoryTracker::onFree(const void *pointer)
+{
+    size_t size;
+    MemoryTag tag;
+    AllocationShard &shard = getAllocationShard(data, pointer);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.allocations.find(pointer);
+        if (it == shard.allocations.end()) {
+            return;
+        }
+        size = it->second.size;
+        tag = it->second.tag;
+        shard.allocations.erase(it);
+    }
+
+    for (int i : { int(tag), int(NUM_MEMORY_TAGS) }) {
+        MemoryTagMetrics &tagMetrics = data->tagMetrics[i];
+        tagMetrics.liveAllocations->subtract(1);
+        tagMetrics.bytes->subtract(int64_t(size));
+    }
+}
+
+static MemoryTagStatistics getMemoryTagStatistics(const MemoryTagMetrics &tagMetrics)
+{
+    MemoryTagStatistics statistics;
+    statistics.currentBytes = tagMetrics.bytes->getValue();
+    statistics.peakBytes = tagMetrics.peakBytes->getValue();
+    statistics.numLiveAllocations = tagMetrics.liveAllocations->getValue();
+    statistics.numAllocations = tagMetrics.allocations->getValue();
+    return statistics;
+}
+
+MemoryTagStatistics MemoryTracker::getStatistics(MemoryTag tag)
+{
+    return getMemoryTagStatistics(data->tagMetrics[tag]);
+}
+
+MemoryTagStatistics MemoryTracker::getTotalStatistics()
+{
+    return getMemoryTagStatistics(data->tagMetrics[NUM_MEMORY_TAGS]);
+}
+
+void MemoryTracker::setCallStackSamplingInterval(uint32_t interval)
+{
+    data->callStackSamplingInterval.store(interval, std::memory_order_relaxed);
+}
+
+static void writeMemoryTagStatistics(std::ostream &stream, const char *name, const MemoryTagStatistics &statistics)
+{
+    stream << name << ": " << statistics.currentBytes << " bytes in " << statistics.numLiveAllocations
+           << " allocations (peak " << statistics.peakBytes << " bytes, " << statistics.numAllocations
+           << " allocations in total)\n";
+}
+
+size_t MemoryTracker::writeReport(std::ostream &stream)
+{
+    for (int i = 0; i < NUM_MEMORY_TAGS; i++) {
+        writeMemoryTagStatistics(stream, getMemoryTagName(MemoryTag(i)), getStatistics(MemoryTag(i)));
+    }
+    writeMemoryTagStatistics(stream, "total", getTotalStatistics());
+
+    std::vector<AllocationInfo> liveAllocations;
+    for (int i = 0; i < MEMORY_NUM_ALLOCATION_SHARDS; i++) {
+        std::lock_guard<std::mutex> lock(data->shards[i].mutex);
+        for (auto &it : data->shards[i].allocations) {
+            liveAllocations.push_back(it.second);
+        }
+    }
+    if (liveAllocations.empty()) {
+        return 0;
+    }
+
+    size_t numReportedAllocations = std::min(liveAllocations.size(), size_t(MEMORY_MAX_REPORTED_ALLOCATIONS));
+    std::partial_sort(
+            liveAllocations.begin(), liveAllocations.begin() + numReportedAllocations, liveAllocations.end(),
+            [](const AllocationInfo &a, const AllocationInfo &b) { return a.size > b.size; });
+    stream << "Largest live allocations (" << numReportedAllocations << " of " << liveAllocations.size() << "):\n";
+    for (size_t i = 0; i < numReportedAllocations; i++) {
+        const AllocationInfo &info = liveAllocations.at(i);
+        stream << "  " << info.size << " bytes (" << getMemoryTagName(info.tag) << ", allocation #"
+               << info.allocationIndex << ")\n";
+#if defined(__GLIBC__)
+        if (!info.callStack.empty()) {
+            char **symbols = backtrace_symbols(info.callStack.data(), int(info.callStack.size()));
+            if (symbols != nullptr) {
+                for (size_t j = 0; j < info.callStack.size(); j++) {
+                    stream << "      " << symbols[j] << '\n';
+                }
+                free(symbols);
+            }
+        }
+#endif
+    }
+    return liveAllocations.size();
+}
+
+void MemoryTracker::reportLeaks()
+{
+    std::ostringstream stream;
+    size_t numLiveAllocations = writeReport(stream);
+    if (numLiveAllocations == 0) {
+        return;
+    }
+
+    Logfile::get()->writeError(std::string() + "WARNING: MemoryTracker::reportLeaks: "
+            + toString(numLiveAllocations) + " tracked allocations were not freed.");
+    std::string line;
+    std::istringstream reportStream(stream.str());
+    while (std::getline(reportStream, line)) {
+        Logfile::get()->write(line + "<br>");
+    }
+}
+
+#endif
+
+}
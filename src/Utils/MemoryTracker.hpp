@@ -0,0 +1,113 @@
+/*!
+ * MemoryTracker.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_MEMORYTRACKER_HPP_
+#define UTILS_MEMORYTRACKER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <Defs.hpp>
+
+/*
+ * Accounting of the large heap buffers of sgl (bitmaps, file buffers, streams, queues) per subsystem.
+ * The classes allocate their buffers with newTrackedArray and free them with deleteTrackedArray. If SGL_MEMORY_TRACKING
+ * is not defined (CMake option SGL_ENABLE_MEMORY_TRACKING), these are plain new[] and delete[], i.e., tracking has no
+ * cost at all. Otherwise, MemoryTracker keeps the live allocations, and the running totals and high-water marks of
+ * each tag are published as gauges in MetricsRegistry ("memory.<tag>.bytes", "memory.<tag>.peak_bytes", ...), so they
+ * can be watched in MetricsWindow. Allocations that are still alive when AppSettings::release is called are reported
+ * in the log file.
+ */
+
+namespace sgl {
+
+enum MemoryTag {
+    MEMORY_TAG_OTHER, MEMORY_TAG_BITMAP, MEMORY_TAG_RESOURCE_BUFFER, MEMORY_TAG_STREAM, MEMORY_TAG_LINE_READER,
+    MEMORY_TAG_CIRCULAR_QUEUE, NUM_MEMORY_TAGS
+};
+DLL_OBJECT const char *getMemoryTagName(MemoryTag tag);
+
+struct DLL_OBJECT MemoryTagStatistics {
+    int64_t currentBytes = 0;
+    int64_t peakBytes = 0; //!< High-water mark of currentBytes
+    int64_t numLiveAllocations = 0;
+    uint64_t numAllocations = 0; //!< Since the start of the program
+};
+
+#ifdef SGL_MEMORY_TRACKING
+
+//! Number of live allocations listed by MemoryTracker::reportLeaks (the largest ones).
+#define MEMORY_MAX_REPORTED_ALLOCATIONS 64
+//! Maximum number of frames of sampled call stacks.
+#define MEMORY_MAX_CALL_STACK_DEPTH 16
+
+struct MemoryTrackerData;
+
+class DLL_OBJECT MemoryTracker
+{
+public:
+    //! Thread-safe; the tracker is created on first use and never destroyed.
+    static MemoryTracker *get();
+
+    void onAllocate(const void *pointer, size_t size, MemoryTag tag);
+    //! Pointers that were not passed to onAllocate (e.g. buffers owned by the user of a class) are ignored.
+    void onFree(const void *pointer);
+
+    MemoryTagStatistics getStatistics(MemoryTag tag);
+    MemoryTagStatistics getTotalStatistics();
+
+    /**
+     * Records the call stack of every n-th allocation (0 disables sampling, which is the default). The call stacks
+     * are part of the leak report. Only supported with glibc (backtrace).
+     */
+    void setCallStackSamplingInterval(uint32_t interval);
+
+    /**
+     * Writes the statistics of all tags and the largest live allocations to the passed stream.
+     * @return The number of live allocations.
+     */
+    size_t writeReport(std::ostream &stream);
+    //! Writes the report to the log file if there are live allocations left.
+    void reportLeaks();
+
+private:
+    MemoryTracker();
+    MemoryTrackerData *data;
+};
+
+#endif
+
+//! Allocates an array of default-initialized elements that is accounted to the passed tag.
+template<class T>
+inline T *newTrackedArray(size_t numElements, MemoryTag tag)
+{
+    T *pointer = new T[numElements];
+#ifdef SGL_MEMORY_TRACKING
+    MemoryTracker::get()->onAllocate(pointer, numElements * sizeof(T), tag);
+#else
+    (void)tag;
+#endif
+    return pointer;
+}
+
+//! Frees an array allocated by newTrackedArray (or by new[], which is not accounted to any tag).
+template<class T>
+inline void deleteTrackedArray(T *pointer)
+{
+    if (pointer == nullptr) {
+        return;
+    }
+#ifdef SGL_MEMORY_TRACKING
+    MemoryTracker::get()->onFree(pointer);
+#endif
+    delete[] pointer;
+}
+
+}
+
+/*! UTILS_MEMORYTRACKER_HPP_ */
+#endif
@@ -0,0 +1,278 @@
+/*
+ * Metrics.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include <sstream>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include "Metrics.hpp"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace sgl {
+
+static inline int getMostSignificantBit(uint64_t value)
+{
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return int(index);
+#else
+    int msb = 0;
+    while (value >>= 1) {
+        msb++;
+    }
+    return msb;
+#endif
+}
+
+static void *allocateCacheLineAligned(size_t size)
+{
+    void *ptr;
+#ifdef _WIN32
+    ptr = _aligned_malloc(size, METRICS_CACHE_LINE_SIZE);
+#else
+    if (posix_memalign(&ptr, METRICS_CACHE_LINE_SIZE, size) != 0) {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+static void freeCacheLineAligned(void *ptr)
+{
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+size_t allocateMetricsShardIndex()
+{
+    static std::atomic<size_t> nextShardIndex(0);
+    return nextShardIndex.fetch_add(1, std::memory_order_relaxed) % METRICS_NUM_SHARDS;
+}
+
+
+MetricCounter::MetricCounter()
+{
+    for (int i = 0; i < METRICS_NUM_SHARDS; i++) {
+        shards[i].value.store(0, std::memory_order_relaxed);
+    }
+}
+
+void *MetricCounter::operator new(size_t size)
+{
+    return allocateCacheLineAligned(size);
+}
+
+void MetricCounter::operator delete(void *ptr)
+{
+    freeCacheLineAligned(ptr);
+}
+
+uint64_t MetricCounter::getValue() const
+{
+    uint64_t value = 0;
+    for (int i = 0; i < METRICS_NUM_SHARDS; i++) {
+        value += shards[i].value.load(std::memory_order_relaxed);
+    }
+    return value;
+}
+
+
+MetricHistogram::MetricHistogram()
+{
+    for (int i = 0; i < METRICS_NUM_SHARDS; i++) {
+        Shard &shard = shards[i];
+        shard.sum.store(0, std::memory_order_relaxed);
+        shard.max.store(0, std::memory_order_relaxed);
+        for (int j = 0; j < METRICS_NUM_HISTOGRAM_BUCKETS; j++) {
+            shard.buckets[j].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void *MetricHistogram::operator new(size_t size)
+{
+    return allocateCacheLineAligned(size);
+}
+
+void MetricHistogram::operator delete(void *ptr)
+{
+    freeCacheLineAligned(ptr);
+}
+
+void MetricHistogram::record(uint64_t value)
+{
+    Shard &shard = shards[getMetricsShardIndex()];
+    int bucketIndex = value == 0 ? 0 : getMostSignificantBit(value) + 1;
+    shard.buckets[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+    shard.sum.fetch_add(value, std::memory_order_relaxed);
+    uint64_t oldMax = shard.max.load(std::memory_order_relaxed);
+    while (value > oldMax && !shard.max.compare_exchange_weak(oldMax, value, std::memory_order_relaxed)) {}
+}
+
+MetricHistogramSnapshot MetricHistogram::getSnapshot() const
+{
+    // Not an atomic snapshot of all shards; concurrent updates may only be partially visible.
+    MetricHistogramSnapshot snapshot;
+    snapshot.buckets.resize(METRICS_NUM_HISTOGRAM_BUCKETS, 0);
+    for (int i = 0; i < METRICS_NUM_SHARDS; i++) {
+        const Shard &shard = shards[i];
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+        snapshot.max = std::max(snapshot.max, shard.max.load(std::memory_order_relaxed));
+        for (int j = 0; j < METRICS_NUM_HISTOGRAM_BUCKETS; j++) {
+            uint64_t bucketCount = shard.buckets[j].load(std::memory_order_relaxed);
+            snapshot.buckets.at(j) += bucketCount;
+            snapshot.count += bucketCount;
+        }
+    }
+    return snapshot;
+}
+
+double MetricHistogramSnapshot::getPercentile(double percentile) const
+{
+    if (count == 0 || buckets.empty()) {
+        return 0.0;
+    }
+    double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * double(count);
+    uint64_t accumulatedCount = 0;
+    for (size_t i = 0; i < buckets.size(); i++) {
+        if (buckets.at(i) == 0) {
+            continue;
+        }
+        if (double(accumulatedCount + buckets.at(i)) >= rank) {
+            if (i == 0) {
+                return 0.0;
+            }
+            double lower = double(uint64_t(1) << (i - 1));
+            double upper = std::min(lower * 2.0, double(max));
+            double t = (rank - double(accumulatedCount)) / double(buckets.at(i));
+            return lower + t * std::max(upper - lower, 0.0);
+        }
+        accumulatedCount += buckets.at(i);
+    }
+    return double(max);
+}
+
+
+MetricsRegistry *MetricsRegistry::get()
+{
+    static MetricsRegistry *registry = new MetricsRegistry;
+    return registry;
+}
+
+template<class T>
+T &MetricsRegistry::getOrCreateMetric(
+        std::map<std::string, Entry<T>> &metrics, const std::string &name, const std::string &description)
+{
+    auto it = metrics.find(name);
+    if (it != metrics.end()) {
+        return *it->second.metric;
+    }
+    Entry<T> &entry = metrics[name];
+    entry.description = description;
+    entry.metric.reset(new T);
+    return *entry.metric;
+}
+
+MetricCounter &MetricsRegistry::getCounter(const std::string &name, const std::string &description)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return getOrCreateMetric(counters, name, description);
+}
+
+MetricGauge &MetricsRegistry::getGauge(const std::string &name, const std::string &description)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return getOrCreateMetric(gauges, name, description);
+}
+
+MetricHistogram &MetricsRegistry::getHistogram(const std::string &name, const std::string &description)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return getOrCreateMetric(histograms, name, description);
+}
+
+std::vector<MetricSnapshot> MetricsRegistry::getSnapshot()
+{
+    std::vector<MetricSnapshot> snapshots;
+    std::lock_guard<std::mutex> lock(mutex);
+    snapshots.reserve(counters.size() + gauges.size() + histograms.size());
+    for (auto &it : counters) {
+        MetricSnapshot snapshot;
+        snapshot.name = it.first;
+        snapshot.description = it.second.description;
+        snapshot.type = METRIC_COUNTER;
+        snapshot.value = int64_t(it.second.metric->getValue());
+        snapshots.push_back(std::move(snapshot));
+    }
+    for (auto &it : gauges) {
+        MetricSnapshot snapshot;
+        snapshot.name = it.first;
+        snapshot.description = it.second.description;
+        snapshot.type = METRIC_GAUGE;
+        snapshot.value = it.second.metric->getValue();
+        snapshots.push_back(std::move(snapshot));
+    }
+    for (auto &it : histograms) {
+        MetricSnapshot snapshot;
+        snapshot.name = it.first;
+        snapshot.description = it.second.description;
+        snapshot.type = METRIC_HISTOGRAM;
+        snapshot.histogram = it.second.metric->getSnapshot();
+        snapshots.push_back(std::move(snapshot));
+    }
+    std::stable_sort(snapshots.begin(), snapshots.end(), [](const MetricSnapshot &a, const MetricSnapshot &b) {
+        return a.name < b.name;
+    });
+    return snapshots;
+}
+
+void MetricsRegistry::writeText(std::ostream &stream)
+{
+    std::vector<MetricSnapshot> snapshots = getSnapshot();
+    for (const MetricSnapshot &snapshot : snapshots) {
+        stream << snapshot.name;
+        if (snapshot.type == METRIC_COUNTER) {
+            stream << " counter " << snapshot.value;
+        } else if (snapshot.type == METRIC_GAUGE) {
+            stream << " gauge " << snapshot.value;
+        } else {
+            const MetricHistogramSnapshot &histogram = snapshot.histogram;
+            stream << " histogram count=" << histogram.count << " sum=" << histogram.sum
+                   << " mean=" << histogram.getMean() << " p50=" << histogram.getPercentile(50.0)
+                   << " p95=" << histogram.getPercentile(95.0) << " p99=" << histogram.getPercentile(99.0)
+                   << " max=" << histogram.max;
+        }
+        if (!snapshot.description.empty()) {
+            stream << " # " << snapshot.description;
+        }
+        stream << '\n';
+    }
+}
+
+std::string MetricsRegistry::getText()
+{
+    std::ostringstream stream;
+    writeText(stream);
+    return stream.str();
+}
+
+}
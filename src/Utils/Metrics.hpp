@@ -0,0 +1,191 @@
+/*!
+ * Metrics.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_METRICS_HPP_
+#define UTILS_METRICS_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <Defs.hpp>
+
+/*
+ * Registry of named counters, gauges and histograms for monitoring the subsystems of sgl (e.g. "resources.bytes_loaded"
+ * or "textures.count"). Updating a metric is lock-free. Counters and histograms are sharded over multiple cache lines,
+ * so threads updating the same metric do not contend for one atomic variable.
+ * Usage:
+ *   static sgl::MetricCounter &filesLoadedCounter = sgl::MetricsRegistry::get()->getCounter(
+ *           "resources.files_loaded", "Number of files read from disk");
+ *   filesLoadedCounter.add();
+ *   sgl::MetricsRegistry::get()->writeText(std::cout);
+ * The metrics are never destroyed, so references to them can be cached in static variables.
+ */
+
+namespace sgl {
+
+//! Number of shards of counters and histograms (threads are distributed round-robin).
+#define METRICS_NUM_SHARDS 8
+//! Histogram bucket 0 contains the value 0, bucket i > 0 the values in [2^(i-1), 2^i).
+#define METRICS_NUM_HISTOGRAM_BUCKETS 65
+//! The shards are aligned to (and thus padded to multiples of) this size to avoid false sharing.
+#define METRICS_CACHE_LINE_SIZE 64
+
+//! Index of the shard used by the calling thread.
+DLL_OBJECT size_t allocateMetricsShardIndex();
+inline size_t getMetricsShardIndex()
+{
+    static thread_local size_t shardIndex = allocateMetricsShardIndex();
+    return shardIndex;
+}
+
+//! Monotonically increasing value (e.g. number of loaded files).
+class DLL_OBJECT MetricCounter
+{
+public:
+    MetricCounter();
+    MetricCounter(const MetricCounter&) = delete;
+    MetricCounter &operator=(const MetricCounter&) = delete;
+    //! Allocates cache line aligned memory (operator new only respects alignas since C++17).
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
+    inline void add(uint64_t value = 1) {
+        shards[getMetricsShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+    uint64_t getValue() const;
+
+private:
+    struct alignas(METRICS_CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> value;
+    };
+    Shard shards[METRICS_NUM_SHARDS];
+};
+
+//! Value that can go up and down (e.g. number of textures in memory).
+class DLL_OBJECT MetricGauge
+{
+public:
+    MetricGauge() : value(0) {}
+    MetricGauge(const MetricGauge&) = delete;
+    MetricGauge &operator=(const MetricGauge&) = delete;
+
+    inline void set(int64_t newValue) { value.store(newValue, std::memory_order_relaxed); }
+    //! Returns the new value.
+    inline int64_t add(int64_t difference) {
+        return value.fetch_add(difference, std::memory_order_relaxed) + difference;
+    }
+    inline int64_t subtract(int64_t difference) {
+        return value.fetch_sub(difference, std::memory_order_relaxed) - difference;
+    }
+    //! Sets the value to newValue if it is larger (e.g. for high-water marks).
+    inline void setMax(int64_t newValue) {
+        int64_t oldValue = value.load(std::memory_order_relaxed);
+        while (newValue > oldValue && !value.compare_exchange_weak(oldValue, newValue, std::memory_order_relaxed)) {}
+    }
+    inline int64_t getValue() const { return value.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value;
+};
+
+struct DLL_OBJECT MetricHistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets; //!< See METRICS_NUM_HISTOGRAM_BUCKETS
+
+    /**
+     * Estimates a percentile by interpolating linearly within the power-of-two bucket, i.e., the relative error is
+     * below 100% (usually much lower).
+     * @param percentile A value in [0, 100].
+     */
+    double getPercentile(double percentile) const;
+    inline double getMean() const { return count == 0 ? 0.0 : double(sum) / double(count); }
+};
+
+//! Distribution of values (e.g. file sizes or durations) in logarithmic buckets.
+class DLL_OBJECT MetricHistogram
+{
+public:
+    MetricHistogram();
+    MetricHistogram(const MetricHistogram&) = delete;
+    MetricHistogram &operator=(const MetricHistogram&) = delete;
+    //! Allocates cache line aligned memory (see MetricCounter).
+    static void *operator new(size_t size);
+    static void operator delete(void *ptr);
+
+    void record(uint64_t value);
+    MetricHistogramSnapshot getSnapshot() const;
+
+private:
+    struct alignas(METRICS_CACHE_LINE_SIZE) Shard {
+        std::atomic<uint64_t> sum;
+        std::atomic<uint64_t> max;
+        std::atomic<uint64_t> buckets[METRICS_NUM_HISTOGRAM_BUCKETS];
+    };
+    Shard shards[METRICS_NUM_SHARDS];
+};
+
+enum MetricType {
+    METRIC_COUNTER, METRIC_GAUGE, METRIC_HISTOGRAM
+};
+
+//! Value of one metric at the time of MetricsRegistry::getSnapshot.
+struct DLL_OBJECT MetricSnapshot {
+    std::string name;
+    std::string description;
+    MetricType type;
+    int64_t value = 0; //!< Counters and gauges
+    MetricHistogramSnapshot histogram; //!< Histograms
+};
+
+class DLL_OBJECT MetricsRegistry
+{
+public:
+    //! Thread-safe; the registry is created on first use and never destroyed.
+    static MetricsRegistry *get();
+
+    /**
+     * Returns the metric with the passed name and creates it if it doesn't exist yet. Counters, gauges and histograms
+     * use separate name spaces. The returned reference stays valid until the end of the program.
+     */
+    MetricCounter &getCounter(const std::string &name, const std::string &description = "");
+    MetricGauge &getGauge(const std::string &name, const std::string &description = "");
+    MetricHistogram &getHistogram(const std::string &name, const std::string &description = "");
+
+    //! All metrics sorted by their name.
+    std::vector<MetricSnapshot> getSnapshot();
+    //! One line per metric, e.g. "resources.bytes_loaded counter 1048576 # Bytes read from disk".
+    void writeText(std::ostream &stream);
+    std::string getText();
+
+private:
+    MetricsRegistry() {}
+    template<class T>
+    struct Entry {
+        std::string description;
+        std::unique_ptr<T> metric;
+    };
+    template<class T>
+    static T &getOrCreateMetric(
+            std::map<std::string, Entry<T>> &metrics, const std::string &name, const std::string &description);
+
+    std::mutex mutex;
+    std::map<std::string, Entry<MetricCounter>> counters;
+    std::map<std::string, Entry<MetricGauge>> gauges;
+    std::map<std::string, Entry<MetricHistogram>> histograms;
+};
+
+}
+
+/*! UTILS_METRICS_HPP_ */
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Halton.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "Halton.hpp"
+#include <algorithm>
+#include <cmath>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+static const uint32_t HALTON_PRIMES[HALTON_MAX_DIMENSIONS] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+        59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+};
+
+HaltonSequence::HaltonSequence(uint32_t numDimensions, bool scrambled, uint32_t seed)
+        : SampleSequence(numDimensions, scrambled, seed)
+{
+    if (numDimensions > HALTON_MAX_DIMENSIONS || numDimensions == 0) {
+        Logfile::get()->writeError(std::string() + "ERROR: HaltonSequence::HaltonSequence: Only 1 to "
+                + std::to_string(HALTON_MAX_DIMENSIONS) + " dimensions are supported.");
+        this->numDimensions = std::max(std::min(numDimensions, uint32_t(HALTON_MAX_DIMENSIONS)), 1u);
+    }
+
+    for (uint32_t dim = 0; dim < this->numDimensions; dim++) {
+        const uint32_t base = HALTON_PRIMES[dim];
+        bases.push_back(base);
+        numScrambledDigits.push_back(uint32_t(std::ceil(24.0 / std::log2(double(base)))));
+        dimensionSeeds.push_back(hashUint32(hashCombine(seed, dim)));
+    }
+}
+
+float HaltonSequence::getSample(uint32_t index, uint32_t dim) const
+{
+    const uint32_t base = bases[dim];
+    if (base == 2) {
+        uint32_t bits = reverseBits(index);
+        return bitsToFloat(scrambled ? nestedUniformScramble(bits, dimensionSeeds[dim]) : bits);
+    }
+
+    // The digits of the index are mirrored at the decimal point, i.e., the least significant one comes first
+    uint64_t reversedDigits = 0;
+    uint64_t baseToNumDigits = 1;
+    if (scrambled) {
+        // Also the zero digits after the most significant one are shifted (until the float precision is reached)
+        uint32_t prefixHash = dimensionSeeds[dim];
+        for (uint32_t i = 0; i < numScrambledDigits[dim]; i++) {
+            const uint32_t digit = index % base;
+            const uint32_t shiftedDigit = (digit + hashUint32(prefixHash) % base) % base;
+            reversedDigits = reversedDigits * base + shiftedDigit;
+            baseToNumDigits *= base;
+            prefixHash = hashCombine(prefixHash, digit + 1);
+            index /= base;
+        }
+    } else {
+        while (index != 0) {
+            reversedDigits = reversedDigits * base + index % base;
+            baseToNumDigits *= base;
+            index /= base;
+        }
+    }
+    // Round towards zero, so that the samples stay in their strata (and below one)
+    const double sample = double(reversedDigits) / double(baseToNumDigits);
+    float sampleFloat = float(sample);
+    if (double(sampleFloat) > sample) {
+        sampleFloat = std::nextafter(sampleFloat, 0.0f);
+    }
+    return sampleFloat;
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Halton.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_HALTON_HPP_
+#define SYSTEM_RANDOM_HALTON_HPP_
+
+#include "SampleSequence.hpp"
+
+namespace sgl {
+
+//! Number of prime bases, i.e., the maximum number of dimensions.
+#define HALTON_MAX_DIMENSIONS 32
+
+/*! Halton sequence (radical inverses with the prime bases 2, 3, 5, ...) with optional Owen scrambling. Scrambling
+ * removes the correlations between the higher dimensions of the plain sequence. Base 2 uses the hash-based scrambling
+ * of the Sobol sequence. The other bases use nested random digit shifts, where the shift of every digit depends on
+ * all more significant digits (i.e., a simplified Owen scrambling with the same stratification properties). */
+class HaltonSequence : public SampleSequence
+{
+public:
+    explicit HaltonSequence(uint32_t numDimensions, bool scrambled = true, uint32_t seed = 0);
+    float getSample(uint32_t index, uint32_t dim) const;
+    inline uint32_t getBase(uint32_t dim) const { return bases.at(dim); }
+
+private:
+    std::vector<uint32_t> bases;
+    //! Number of digits needed for float precision in every base.
+    std::vector<uint32_t> numScrambledDigits;
+    std::vector<uint32_t> dimensionSeeds;
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_HALTON_HPP_ */
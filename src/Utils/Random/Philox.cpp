@@ -0,0 +1,186 @@
+/*
+ * Philox.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "Philox.hpp"
+#include "RandomKernels.hpp"
+#include <Utils/CpuFeatures.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//! Ranges with more values than this are split into chunks of this size, which are generated in parallel.
+#define PHILOX_PARALLEL_CHUNK_SIZE (size_t(1) << 16)
+
+namespace sgl {
+
+#ifdef __SSE2__
+//! Low and high 32 bits of the products of the four lanes of a with m.
+static inline void mulHiLoSSE2(__m128i a, __m128i m, __m128i &lo, __m128i &hi)
+{
+    __m128i productsEven = _mm_mul_epu32(a, m); // lanes 0 and 2 as 64-bit values
+    __m128i productsOdd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m); // lanes 1 and 3
+    lo = _mm_unpacklo_epi32(_mm_shuffle_epi32(productsEven, _MM_SHUFFLE(3, 1, 2, 0)),
+            _mm_shuffle_epi32(productsOdd, _MM_SHUFFLE(3, 1, 2, 0)));
+    hi = _mm_unpacklo_epi32(_mm_shuffle_epi32(productsEven, _MM_SHUFFLE(2, 0, 3, 1)),
+            _mm_shuffle_epi32(productsOdd, _MM_SHUFFLE(2, 0, 3, 1)));
+}
+
+//! Generates four blocks at once with the counters in structure of arrays layout.
+static size_t philox4x32SSE2(const uint32_t key[2], uint64_t stream, uint64_t firstBlock, size_t numBlocks,
+        uint32_t *values)
+{
+    const __m128i m0 = _mm_set1_epi32(int(PHILOX_M0)), m1 = _mm_set1_epi32(int(PHILOX_M1));
+    const __m128i signBit = _mm_set1_epi32(int(0x80000000u));
+    size_t i = 0;
+    for (; i + 4 <= numBlocks; i += 4) {
+        const uint64_t block = firstBlock + i;
+        // Add the lane offsets to the 64-bit block index with carry (using a signed comparison for unsigned values)
+        __m128i blockLow = _mm_set1_epi32(int(uint32_t(block)));
+        __m128i c0 = _mm_add_epi32(blockLow, _mm_setr_epi32(0, 1, 2, 3));
+        __m128i carry = _mm_cmpgt_epi32(_mm_xor_si128(blockLow, signBit), _mm_xor_si128(c0, signBit));
+        __m128i c1 = _mm_sub_epi32(_mm_set1_epi32(int(uint32_t(block >> 32))), carry);
+        __m128i c2 = _mm_set1_epi32(int(uint32_t(stream)));
+        __m128i c3 = _mm_set1_epi32(int(uint32_t(stream >> 32)));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < PHILOX_NUM_ROUNDS; round++) {
+            __m128i lo0, hi0, lo1, hi1;
+            mulHiLoSSE2(c0, m0, lo0, hi0);
+            mulHiLoSSE2(c2, m1, lo1, hi1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32(int(k0)));
+            c1 = lo1;
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32(int(k1)));
+            c3 = lo0;
+            k0 += PHILOX_W0; k1 += PHILOX_W1;
+        }
+        // Transpose to the four values of each block
+        __m128i t0 = _mm_unpacklo_epi32(c0, c1), t1 = _mm_unpacklo_epi32(c2, c3);
+        __m128i t2 = _mm_unpackhi_epi32(c0, c1), t3 = _mm_unpackhi_epi32(c2, c3);
+        __m128i *out = reinterpret_cast<__m128i*>(values + i * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi64(t2, t3));
+    }
+    return i;
+}
+#define PHILOX_SSE2_KERNEL philox4x32SSE2
+#else
+#define PHILOX_SSE2_KERNEL nullptr
+#endif
+
+static const KernelTable<Philox4x32Kernel> philox4x32Kernels(
+        nullptr, PHILOX_SSE2_KERNEL, SGL_AVX2_KERNEL(philox4x32AVX2));
+
+void PhiloxRandomGenerator::philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t values[4])
+{
+    uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+    uint32_t k0 = key[0], k1 = key[1];
+    for (int round = 0; round < PHILOX_NUM_ROUNDS; round++) {
+        uint64_t product0 = uint64_t(PHILOX_M0) * c0;
+        uint64_t product1 = uint64_t(PHILOX_M1) * c2;
+        c0 = uint32_t(product1 >> 32) ^ c1 ^ k0;
+        c1 = uint32_t(product1);
+        c2 = uint32_t(product0 >> 32) ^ c3 ^ k1;
+        c3 = uint32_t(product0);
+        k0 += PHILOX_W0; k1 += PHILOX_W1;
+    }
+    values[0] = c0; values[1] = c1; values[2] = c2; values[3] = c3;
+}
+
+void PhiloxRandomGenerator::initialize(uint64_t stream)
+{
+    key[0] = seed;
+    key[1] = 0;
+    this->stream = stream;
+    position = 0;
+    cachedBlockIndex = ~uint64_t(0);
+}
+
+uint32_t PhiloxRandomGenerator::getRandomUint32()
+{
+    const uint64_t blockIndex = position / 4;
+    if (blockIndex != cachedBlockIndex) {
+        generateBlocks(blockIndex, 1, cachedBlock);
+        cachedBlockIndex = blockIndex;
+    }
+    return cachedBlock[position++ % 4];
+}
+
+uint32_t PhiloxRandomGenerator::getUint32At(uint64_t index) const
+{
+    uint32_t block[4];
+    generateBlocks(index / 4, 1, block);
+    return block[index % 4];
+}
+
+void PhiloxRandomGenerator::generateBlocks(uint64_t firstBlock, size_t numBlocks, uint32_t *values) const
+{
+    size_t i = 0;
+    Philox4x32Kernel kernel = philox4x32Kernels.get();
+    if (kernel != nullptr) {
+        i = kernel(key, stream, firstBlock, numBlocks, values);
+    }
+    for (; i < numBlocks; i++) {
+        const uint64_t block = firstBlock + i;
+        const uint32_t counter[4] = {
+                uint32_t(block), uint32_t(block >> 32), uint32_t(stream), uint32_t(stream >> 32) };
+        philox4x32(counter, key, values + i * 4);
+    }
+}
+
+void PhiloxRandomGenerator::generateRange(uint64_t firstIndex, uint32_t *values, size_t numValues) const
+{
+    // Values before the first full block, the full blocks, and the values after the last full block
+    size_t i = 0;
+    for (; i < numValues && (firstIndex + i) % 4 != 0; i++) {
+        values[i] = getUint32At(firstIndex + i);
+    }
+    const size_t numBlocks = (numValues - i) / 4;
+    generateBlocks((firstIndex + i) / 4, numBlocks, values + i);
+    i += numBlocks * 4;
+    for (; i < numValues; i++) {
+        values[i] = getUint32At(firstIndex + i);
+    }
+}
+
+void PhiloxRandomGenerator::fillUint32At(uint64_t firstIndex, uint32_t *values, size_t numValues) const
+{
+    if (numValues <= PHILOX_PARALLEL_CHUNK_SIZE) {
+        generateRange(firstIndex, values, numValues);
+        return;
+    }
+    const size_t numChunks = (numValues - 1) / PHILOX_PARALLEL_CHUNK_SIZE + 1;
+    #pragma omp parallel for shared(firstIndex, values, numValues, numChunks) default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t first = chunkIdx * PHILOX_PARALLEL_CHUNK_SIZE;
+        generateRange(firstIndex + first, values + first, std::min(PHILOX_PARALLEL_CHUNK_SIZE, numValues - first));
+    }
+}
+
+void PhiloxRandomGenerator::fillUniformFloatsAt(uint64_t firstIndex, float *values, size_t numValues,
+        float min, float max) const
+{
+    const size_t numChunks = numValues == 0 ? 0 : (numValues - 1) / PHILOX_PARALLEL_CHUNK_SIZE + 1;
+    #pragma omp parallel for if(numChunks > 1) shared(firstIndex, values, numValues, numChunks, min, max) \
+            default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        size_t first = chunkIdx * PHILOX_PARALLEL_CHUNK_SIZE;
+        size_t numChunkValues = std::min(PHILOX_PARALLEL_CHUNK_SIZE, numValues - first);
+        std::vector<uint32_t> randomBits(numChunkValues);
+        generateRange(firstIndex + first, &randomBits.front(), numChunkValues);
+        convertToUniformFloats(&randomBits.front(), values + first, numChunkValues, min, max);
+    }
+}
+
+void PhiloxRandomGenerator::generateUint32(uint32_t *values, size_t numValues)
+{
+    fillUint32At(position, values, numValues);
+    position += numValues;
+}
+
+}
@@ -0,0 +1,64 @@
+/*
+ * Philox.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_PHILOX_HPP_
+#define SYSTEM_RANDOM_PHILOX_HPP_
+
+#include "Random.hpp"
+
+namespace sgl {
+
+/*! Counter-based Philox4x32-10 generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3"). Value i of
+ * a stream is a function of (seed, stream, i) only, so the values can be generated in any order without shared state.
+ * E.g., inside of an OpenMP loop every thread can call fillUint32At/fillUniformFloatsAt for its range of indices and
+ * gets exactly the same values as a serial loop. Different streams with the same seed are independent.
+ * The bulk functions use SSE2/AVX2 and split large ranges across threads. */
+class PhiloxRandomGenerator : public RandomGenerator
+{
+public:
+    PhiloxRandomGenerator() : RandomGenerator() { initialize(0); }
+    PhiloxRandomGenerator(uint32_t _seed, uint64_t stream = 0) : RandomGenerator(_seed) { initialize(stream); }
+    virtual ~PhiloxRandomGenerator() {}
+    //! Returns the value at the current position and advances the position.
+    uint32_t getRandomUint32();
+
+    //! Value i of the stream (independent of the current position).
+    uint32_t getUint32At(uint64_t index) const;
+    //! The values [firstIndex, firstIndex + numValues) of the stream (independent of the current position).
+    void fillUint32At(uint64_t firstIndex, uint32_t *values, size_t numValues) const;
+    //! Like RandomGenerator::fillUniformFloats for the values [firstIndex, firstIndex + numValues) of the stream.
+    void fillUniformFloatsAt(uint64_t firstIndex, float *values, size_t numValues,
+            float min = 0.0f, float max = 1.0f) const;
+
+    //! Index of the value returned by the next call of getRandomUint32 (or the first value of fillUint32).
+    inline uint64_t getPosition() const { return position; }
+    inline void setPosition(uint64_t index) { position = index; }
+    inline uint64_t getStream() const { return stream; }
+
+    //! One Philox4x32-10 block, i.e., four random values for a 128-bit counter.
+    static void philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t values[4]);
+
+protected:
+    void generateUint32(uint32_t *values, size_t numValues);
+
+private:
+    void initialize(uint64_t stream);
+    //! The values of the blocks [firstBlock, firstBlock + numBlocks) on the calling thread.
+    void generateBlocks(uint64_t firstBlock, size_t numBlocks, uint32_t *values) const;
+    void generateRange(uint64_t firstIndex, uint32_t *values, size_t numValues) const;
+
+    uint32_t key[2];
+    uint64_t stream;
+    uint64_t position;
+    //! The block of the last value returned by getRandomUint32
+    uint64_t cachedBlockIndex;
+    uint32_t cachedBlock[4];
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_PHILOX_HPP_ */
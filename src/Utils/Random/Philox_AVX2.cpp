@@ -0,0 +1,66 @@
+/*
+ * Philox_AVX2.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "RandomKernels.hpp"
+
+#if defined(SGL_AVX2_KERNELS) && defined(__AVX2__)
+#include <immintrin.h>
+
+namespace sgl {
+
+//! Low and high 32 bits of the products of the eight lanes of a with m.
+static inline void mulHiLoAVX2(__m256i a, __m256i m, __m256i &lo, __m256i &hi)
+{
+    __m256i productsEven = _mm256_mul_epu32(a, m);
+    __m256i productsOdd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    lo = _mm256_blend_epi32(productsEven, _mm256_slli_epi64(productsOdd, 32), 0xAA);
+    hi = _mm256_blend_epi32(_mm256_srli_epi64(productsEven, 32), productsOdd, 0xAA);
+}
+
+//! Same as the SSE2 kernel in Philox.cpp with eight blocks at once.
+size_t philox4x32AVX2(const uint32_t key[2], uint64_t stream, uint64_t firstBlock, size_t numBlocks,
+        uint32_t *values)
+{
+    const __m256i m0 = _mm256_set1_epi32(int(PHILOX_M0)), m1 = _mm256_set1_epi32(int(PHILOX_M1));
+    const __m256i signBit = _mm256_set1_epi32(int(0x80000000u));
+    size_t i = 0;
+    for (; i + 8 <= numBlocks; i += 8) {
+        const uint64_t block = firstBlock + i;
+        __m256i blockLow = _mm256_set1_epi32(int(uint32_t(block)));
+        __m256i c0 = _mm256_add_epi32(blockLow, _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256i carry = _mm256_cmpgt_epi32(_mm256_xor_si256(blockLow, signBit), _mm256_xor_si256(c0, signBit));
+        __m256i c1 = _mm256_sub_epi32(_mm256_set1_epi32(int(uint32_t(block >> 32))), carry);
+        __m256i c2 = _mm256_set1_epi32(int(uint32_t(stream)));
+        __m256i c3 = _mm256_set1_epi32(int(uint32_t(stream >> 32)));
+        uint32_t k0 = key[0], k1 = key[1];
+        for (int round = 0; round < PHILOX_NUM_ROUNDS; round++) {
+            __m256i lo0, hi0, lo1, hi1;
+            mulHiLoAVX2(c0, m0, lo0, hi0);
+            mulHiLoAVX2(c2, m1, lo1, hi1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(int(k0)));
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(int(k1)));
+            c3 = lo0;
+            k0 += PHILOX_W0; k1 += PHILOX_W1;
+        }
+        // Transpose in both 128-bit lanes (blocks 0-3 in the lower and 4-7 in the upper lane)
+        __m256i t0 = _mm256_unpacklo_epi32(c0, c1), t1 = _mm256_unpacklo_epi32(c2, c3);
+        __m256i t2 = _mm256_unpackhi_epi32(c0, c1), t3 = _mm256_unpackhi_epi32(c2, c3);
+        __m256i r0 = _mm256_unpacklo_epi64(t0, t1), r1 = _mm256_unpackhi_epi64(t0, t1);
+        __m256i r2 = _mm256_unpacklo_epi64(t2, t3), r3 = _mm256_unpackhi_epi64(t2, t3);
+        __m256i *out = reinterpret_cast<__m256i*>(values + i * 4);
+        _mm256_storeu_si256(out, _mm256_permute2x128_si256(r0, r1, 0x20));
+        _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(r2, r3, 0x20));
+        _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(r0, r1, 0x31));
+        _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(r2, r3, 0x31));
+    }
+    return i;
+}
+
+}
+
+#endif
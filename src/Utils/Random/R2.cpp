@@ -0,0 +1,55 @@
+/*
+ * R2.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "R2.hpp"
+#include <cmath>
+
+namespace sgl {
+
+static inline float fixedPointToFloat(uint64_t x)
+{
+    return float(uint32_t(x >> 40)) * (1.0f / 16777216.0f);
+}
+
+R2Sequence::R2Sequence(uint32_t numDimensions, bool scrambled, uint32_t seed)
+        : SampleSequence(numDimensions, scrambled, seed)
+{
+    // Newton iteration for the root of x^(d+1) - x - 1
+    double phi = 2.0;
+    for (int i = 0; i < 32; i++) {
+        phi -= (std::pow(phi, double(numDimensions + 1)) - phi - 1.0)
+                / ((numDimensions + 1) * std::pow(phi, double(numDimensions)) - 1.0);
+    }
+
+    for (uint32_t dim = 0; dim < numDimensions; dim++) {
+        double alpha = std::fmod(std::pow(1.0 / phi, double(dim + 1)), 1.0);
+        alphas.push_back(uint64_t(std::ldexp(alpha, 64)));
+        if (scrambled) {
+            uint32_t hash = hashUint32(hashCombine(seed, dim));
+            offsets.push_back((uint64_t(hash) << 32) | hashUint32(hash));
+        } else {
+            offsets.push_back(uint64_t(1) << 63); // 0.5 as proposed by Roberts
+        }
+    }
+}
+
+float R2Sequence::getSample(uint32_t index, uint32_t dim) const
+{
+    return fixedPointToFloat(offsets[dim] + uint64_t(index) * alphas[dim]);
+}
+
+void R2Sequence::fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const
+{
+    // The fixed point additions wrap around, which is exactly the fractional part
+    const uint64_t alpha = alphas[dim];
+    const uint64_t start = offsets[dim] + uint64_t(firstIndex) * alpha;
+    for (size_t i = 0; i < numSamples; i++) {
+        values[i] = fixedPointToFloat(start + uint64_t(i) * alpha);
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+/*
+ * R2.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_R2_HPP_
+#define SYSTEM_RANDOM_R2_HPP_
+
+#include "SampleSequence.hpp"
+
+namespace sgl {
+
+/*! Generalized golden ratio sequence by Martin Roberts ("R2" in two dimensions), i.e., the additive recurrence
+ * x_n = frac(offset + n * alpha) with alpha_j = 1 / phi^(j+1), where phi is the positive root of x^(d+1) = x + 1.
+ * It is very cheap and has good coverage for any number of samples and dimensions. The sequence has no digit structure
+ * Owen scrambling could permute, so scrambling uses a random offset (Cranley-Patterson rotation) per dimension.
+ * The values are computed in 64-bit fixed point, so they stay exact for all indices. */
+class R2Sequence : public SampleSequence
+{
+public:
+    explicit R2Sequence(uint32_t numDimensions, bool scrambled = true, uint32_t seed = 0);
+    float getSample(uint32_t index, uint32_t dim) const;
+    void fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const;
+
+private:
+    //! Fractional parts as 64-bit fixed point values
+    std::vector<uint64_t> alphas;
+    std::vector<uint64_t> offsets;
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_R2_HPP_ */
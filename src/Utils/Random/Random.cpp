@@ -7,6 +7,13 @@
 
 #include "Random.hpp"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//! Number of random values generated at once on the stack by fillUniformFloats.
+#define UNIFORM_FLOATS_BUFFER_SIZE 1024
+
 namespace sgl {
 
 int RandomGenerator::getRandomIntBetween(int min, int max)
@@ -26,7 +33,42 @@ float RandomGenerator::getRandomFloatBetween(float min, float max)
         min = max;
         max = temp;
     }
-    return (getRandomUint32() / static_cast<float>(4294967295UL) * (max - min) + min);
+    return (getRandomUint32() * (1.0f / static_cast<float>(4294967295UL)) * (max - min) + min);
+}
+
+void RandomGenerator::generateUint32(uint32_t *values, size_t numValues)
+{
+    for (size_t i = 0; i < numValues; i++) {
+        values[i] = getRandomUint32();
+    }
+}
+
+void RandomGenerator::fillUniformFloats(float *values, size_t numValues, float min, float max)
+{
+    uint32_t randomBits[UNIFORM_FLOATS_BUFFER_SIZE];
+    for (size_t i = 0; i < numValues; i += UNIFORM_FLOATS_BUFFER_SIZE) {
+        size_t numBufferValues = std::min(numValues - i, size_t(UNIFORM_FLOATS_BUFFER_SIZE));
+        generateUint32(randomBits, numBufferValues);
+        convertToUniformFloats(randomBits, values + i, numBufferValues, min, max);
+    }
+}
+
+void RandomGenerator::convertToUniformFloats(const uint32_t *randomBits, float *values, size_t numValues,
+        float min, float max)
+{
+    // The upper 24 bits are exactly representable as float, so the values in [0, 1) are evenly spaced
+    const float scale = (max - min) * (1.0f / 16777216.0f);
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128 scaleVec = _mm_set1_ps(scale), minVec = _mm_set1_ps(min);
+    for (; i + 4 <= numValues; i += 4) {
+        __m128i bits = _mm_srli_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(randomBits + i)), 8);
+        _mm_storeu_ps(values + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(bits), scaleVec), minVec));
+    }
+#endif
+    for (; i < numValues; i++) {
+        values[i] = float(randomBits[i] >> 8) * scale + min;
+    }
 }
 
 }
@@ -29,6 +29,22 @@ public:
     virtual int getRandomIntBetween(int min, int max);
     virtual float getRandomFloatBetween(float min, float max);
 
+    /*! Bulk generation, which is much faster than calling getRandomUint32 for every value.
+     * The values are the same as the ones of calling getRandomUint32 numValues times. */
+    inline void fillUint32(uint32_t *values, size_t numValues) { generateUint32(values, numValues); }
+    inline void fillUint32(vector<uint32_t> &values) {
+        generateUint32(values.empty() ? nullptr : &values.front(), values.size());
+    }
+    /*! Uniformly distributed floats in [min, max), computed from the upper 24 bits of the values of fillUint32
+     * (i.e., without any division). */
+    void fillUniformFloats(float *values, size_t numValues, float min = 0.0f, float max = 1.0f);
+    inline void fillUniformFloats(vector<float> &values, float min = 0.0f, float max = 1.0f) {
+        fillUniformFloats(values.empty() ? nullptr : &values.front(), values.size(), min, max);
+    }
+    //! Converts random bits to uniformly distributed floats in [min, max) like fillUniformFloats.
+    static void convertToUniformFloats(const uint32_t *randomBits, float *values, size_t numValues,
+            float min, float max);
+
     // Shuffles the elements in the container
     template <class T>
     void shuffle(vector<T> &container)
@@ -57,6 +73,8 @@ public:
     }*/
 
 protected:
+    //! Override this for generators that can produce many values faster than one by one.
+    virtual void generateUint32(uint32_t *values, size_t numValues);
     uint32_t seed;
 };
 
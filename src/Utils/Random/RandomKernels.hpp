@@ -0,0 +1,48 @@
+/*
+ * RandomKernels.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_RANDOMKERNELS_HPP_
+#define SYSTEM_RANDOM_RANDOMKERNELS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Internal interface between the generators and their kernels compiled with ISA flags (Xoshiro_AVX2.cpp,
+ * Philox_AVX2.cpp). This header must not include headers with inline functions (see Utils/CpuFeatures.hpp).
+ */
+
+namespace sgl {
+
+//! Number of interleaved xoshiro128+ streams, i.e., output i is generated by the stream i % XOSHIRO_NUM_LANES.
+#define XOSHIRO_NUM_LANES 8
+
+/*! Generates numGroups * XOSHIRO_NUM_LANES values (one per lane and group) and advances the state, which is stored
+ * as state[word][lane]. */
+typedef void (*Xoshiro128PlusKernel)(uint32_t state[4][XOSHIRO_NUM_LANES], uint32_t *values, size_t numGroups);
+
+/*! Philox4x32-10 with the counter (block index low bits, block index high bits, stream low bits, stream high bits).
+ * Writes the four values of the blocks [firstBlock, firstBlock + numBlocks) and returns the number of blocks
+ * processed, the remaining ones are generated by the caller. */
+typedef size_t (*Philox4x32Kernel)(const uint32_t key[2], uint64_t stream, uint64_t firstBlock, size_t numBlocks,
+        uint32_t *values);
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_NUM_ROUNDS 10
+
+#ifdef SGL_AVX2_KERNELS
+void xoshiro128PlusAVX2(uint32_t state[4][XOSHIRO_NUM_LANES], uint32_t *values, size_t numGroups);
+size_t philox4x32AVX2(const uint32_t key[2], uint64_t stream, uint64_t firstBlock, size_t numBlocks,
+        uint32_t *values);
+#endif
+
+}
+
+#endif /* SYSTEM_RANDOM_RANDOMKERNELS_HPP_ */
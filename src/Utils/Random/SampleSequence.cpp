@@ -0,0 +1,59 @@
+/*
+ * SampleSequence.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "SampleSequence.hpp"
+#include <algorithm>
+
+//! Samples are generated per dimension in blocks of this size on the stack and then interleaved.
+#define SAMPLE_SEQUENCE_BLOCK_SIZE 1024
+//! Ranges with more samples than this are split into chunks of this size, which are generated in parallel.
+#define SAMPLE_SEQUENCE_PARALLEL_CHUNK_SIZE (size_t(1) << 16)
+
+namespace sgl {
+
+void SampleSequence::fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const
+{
+    for (size_t i = 0; i < numSamples; i++) {
+        values[i] = getSample(firstIndex + uint32_t(i), dim);
+    }
+}
+
+void SampleSequence::fillSamples(uint32_t firstIndex, float *samples, size_t numSamples) const
+{
+    const size_t numChunks = numSamples == 0 ? 0 : (numSamples - 1) / SAMPLE_SEQUENCE_PARALLEL_CHUNK_SIZE + 1;
+    const uint32_t numDims = numDimensions;
+    #pragma omp parallel for if(numChunks > 1) shared(firstIndex, samples, numSamples, numChunks, numDims) \
+            default(none)
+    for (size_t chunkIdx = 0; chunkIdx < numChunks; ++chunkIdx) {
+        const size_t chunkStart = chunkIdx * SAMPLE_SEQUENCE_PARALLEL_CHUNK_SIZE;
+        const size_t chunkEnd = std::min(chunkStart + SAMPLE_SEQUENCE_PARALLEL_CHUNK_SIZE, numSamples);
+        float values[SAMPLE_SEQUENCE_BLOCK_SIZE];
+        for (size_t blockStart = chunkStart; blockStart < chunkEnd; blockStart += SAMPLE_SEQUENCE_BLOCK_SIZE) {
+            const size_t numBlockSamples = std::min(chunkEnd - blockStart, size_t(SAMPLE_SEQUENCE_BLOCK_SIZE));
+            for (uint32_t dim = 0; dim < numDims; dim++) {
+                fillDimension(dim, firstIndex + uint32_t(blockStart), values, numBlockSamples);
+                float *blockSamples = samples + blockStart * numDims + dim;
+                for (size_t i = 0; i < numBlockSamples; i++) {
+                    blockSamples[i * numDims] = values[i];
+                }
+            }
+        }
+    }
+}
+
+uint32_t SampleSequence::hashUint32(uint32_t x)
+{
+    // lowbias32 by Chris Wellons
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * SampleSequence.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_SAMPLESEQUENCE_HPP_
+#define SYSTEM_RANDOM_SAMPLESEQUENCE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace sgl {
+
+/*! Base class of the low-discrepancy sequences (Sobol, Halton, R2). A sample has getNumDimensions() components in
+ * [0, 1). Every sample is a function of its index only, so the sequences support skip-ahead by setting the position,
+ * and every thread can generate a disjoint subsequence (e.g. the samples [firstIndex, firstIndex + numSamples)) with
+ * the same results as a serial loop. If scrambling is enabled, the seed selects one randomization of the sequence,
+ * which keeps its stratification properties. */
+class SampleSequence
+{
+public:
+    SampleSequence(uint32_t numDimensions, bool scrambled, uint32_t seed)
+        : numDimensions(numDimensions), scrambled(scrambled), seed(seed), position(0) {}
+    virtual ~SampleSequence() {}
+
+    //! Component dim of the sample with the passed index.
+    virtual float getSample(uint32_t index, uint32_t dim) const=0;
+    //! Writes component dim of the samples [firstIndex, firstIndex + numSamples) to values (structure of arrays).
+    virtual void fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const;
+    /*! Writes the samples [firstIndex, firstIndex + numSamples) to samples with the components interleaved, i.e.,
+     * samples needs to hold numSamples * getNumDimensions() values. Large ranges are generated in parallel. */
+    void fillSamples(uint32_t firstIndex, float *samples, size_t numSamples) const;
+    inline void fillSamples(uint32_t firstIndex, std::vector<float> &samples) const {
+        if (!samples.empty()) {
+            fillSamples(firstIndex, &samples.front(), samples.size() / numDimensions);
+        }
+    }
+
+    //! Writes the sample at the current position to sample and advances the position.
+    inline void getNextSample(float *sample) {
+        for (uint32_t dim = 0; dim < numDimensions; dim++) {
+            sample[dim] = getSample(position, dim);
+        }
+        position++;
+    }
+    inline uint32_t getPosition() const { return position; }
+    inline void setPosition(uint32_t index) { position = index; }
+    inline void skip(uint32_t numSamples) { position += numSamples; }
+
+    inline uint32_t getNumDimensions() const { return numDimensions; }
+    inline bool getIsScrambled() const { return scrambled; }
+
+protected:
+    //! Hash-based Owen scrambling of base 2 digits (Burley, "Practical Hash-based Owen Scrambling", 2020).
+    static inline uint32_t nestedUniformScramble(uint32_t x, uint32_t seed) {
+        // Laine-Karras style permutation of the reversed bits: Every bit is only influenced by the lower bits, i.e.,
+        // by the more significant bits of the original value (which is the definition of Owen scrambling)
+        x = reverseBits(x);
+        x += seed;
+        x ^= x * 0x6c50b47cu;
+        x ^= x * 0xb82f1e52u;
+        x ^= x * 0xc7afe638u;
+        x ^= x * 0x8d22f6e6u;
+        return reverseBits(x);
+    }
+    static inline uint32_t reverseBits(uint32_t x) {
+        x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+        x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+        x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+        x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+        return (x >> 16) | (x << 16);
+    }
+    static uint32_t hashUint32(uint32_t x);
+    static inline uint32_t hashCombine(uint32_t seed, uint32_t value) {
+        return seed ^ (value + (seed << 6) + (seed >> 2));
+    }
+    //! Converts the upper 24 bits to a float in [0, 1).
+    static inline float bitsToFloat(uint32_t bits) { return float(bits >> 8) * (1.0f / 16777216.0f); }
+
+    uint32_t numDimensions;
+    bool scrambled;
+    uint32_t seed;
+    uint32_t position;
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_SAMPLESEQUENCE_HPP_ */
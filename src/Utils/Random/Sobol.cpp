@@ -0,0 +1,125 @@
+/*
+ * Sobol.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "Sobol.hpp"
+#include <algorithm>
+#include <Utils/File/Logfile.hpp>
+
+namespace sgl {
+
+/*! Primitive polynomials and initial direction numbers of the dimensions 2-16 (Joe & Kuo). The polynomial of degree s
+ * is x^s + a_1 x^(s-1) + ... + a_(s-1) x + 1 with the bits a_1 ... a_(s-1) stored in a. */
+struct SobolInitialNumbers {
+    uint32_t s;
+    uint32_t a;
+    uint32_t m[6];
+};
+static const SobolInitialNumbers SOBOL_INITIAL_NUMBERS[SOBOL_MAX_DIMENSIONS - 1] = {
+        { 1, 0, { 1 } },
+        { 2, 1, { 1, 3 } },
+        { 3, 1, { 1, 3, 1 } },
+        { 3, 2, { 1, 1, 1 } },
+        { 4, 1, { 1, 1, 3, 3 } },
+        { 4, 4, { 1, 3, 5, 13 } },
+        { 5, 2, { 1, 1, 5, 5, 17 } },
+        { 5, 4, { 1, 1, 5, 5, 5 } },
+        { 5, 7, { 1, 1, 7, 11, 19 } },
+        { 5, 11, { 1, 1, 5, 1, 1 } },
+        { 5, 13, { 1, 1, 1, 3, 11 } },
+        { 5, 14, { 1, 3, 5, 5, 31 } },
+        { 6, 1, { 1, 3, 3, 9, 7, 49 } },
+        { 6, 13, { 1, 1, 1, 15, 21, 21 } },
+        { 6, 16, { 1, 3, 1, 13, 27, 49 } },
+};
+
+SobolSequence::SobolSequence(uint32_t numDimensions, bool scrambled, uint32_t seed)
+        : SampleSequence(numDimensions, scrambled, seed)
+{
+    if (numDimensions > SOBOL_MAX_DIMENSIONS || numDimensions == 0) {
+        Logfile::get()->writeError(std::string() + "ERROR: SobolSequence::SobolSequence: Only 1 to "
+                + std::to_string(SOBOL_MAX_DIMENSIONS) + " dimensions are supported.");
+        this->numDimensions = std::max(std::min(numDimensions, uint32_t(SOBOL_MAX_DIMENSIONS)), 1u);
+    }
+
+    directionNumbers.resize(this->numDimensions * 32);
+    for (uint32_t i = 0; i < 32; i++) {
+        directionNumbers[i] = 1u << (31 - i);
+    }
+    for (uint32_t dim = 1; dim < this->numDimensions; dim++) {
+        const SobolInitialNumbers &initialNumbers = SOBOL_INITIAL_NUMBERS[dim - 1];
+        const uint32_t s = initialNumbers.s, a = initialNumbers.a;
+        uint32_t *v = &directionNumbers[dim * 32];
+        for (uint32_t i = 0; i < 32; i++) {
+            if (i < s) {
+                v[i] = initialNumbers.m[i] << (31 - i);
+            } else {
+                v[i] = v[i - s] ^ (v[i - s] >> s);
+                for (uint32_t k = 1; k < s; k++) {
+                    v[i] ^= ((a >> (s - 1 - k)) & 1u) * v[i - k];
+                }
+            }
+        }
+    }
+
+    lowBitsTable.resize(this->numDimensions * 256);
+    dimensionSeeds.resize(this->numDimensions);
+    for (uint32_t dim = 0; dim < this->numDimensions; dim++) {
+        for (uint32_t i = 0; i < 256; i++) {
+            lowBitsTable[dim * 256 + i] = getUnscrambledBits(i, dim);
+        }
+        dimensionSeeds[dim] = hashUint32(hashCombine(seed, dim));
+    }
+}
+
+uint32_t SobolSequence::getUnscrambledBits(uint32_t index, uint32_t dim) const
+{
+    const uint32_t *v = &directionNumbers[dim * 32];
+    uint32_t bits = 0;
+    for (int i = 0; index != 0; index >>= 1, i++) {
+        bits ^= (index & 1u) * v[i];
+    }
+    return bits;
+}
+
+uint32_t SobolSequence::getSampleBits(uint32_t index, uint32_t dim) const
+{
+    uint32_t bits = getUnscrambledBits(index, dim);
+    return scrambled ? nestedUniformScramble(bits, dimensionSeeds[dim]) : bits;
+}
+
+float SobolSequence::getSample(uint32_t index, uint32_t dim) const
+{
+    return bitsToFloat(getSampleBits(index, dim));
+}
+
+void SobolSequence::fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const
+{
+    // The samples of the indices (high | low) with low < 256 are (sample(high) XOR table[low])
+    const uint32_t *table = &lowBitsTable[dim * 256];
+    const uint32_t dimensionSeed = dimensionSeeds[dim];
+    size_t i = 0;
+    while (i < numSamples) {
+        const uint32_t index = firstIndex + uint32_t(i);
+        const uint32_t highBits = getUnscrambledBits(index & ~0xFFu, dim);
+        const uint32_t low = index & 0xFFu;
+        const size_t numBlockSamples = std::min(numSamples - i, size_t(256 - low));
+        const uint32_t *blockTable = table + low;
+        float *blockValues = values + i;
+        if (scrambled) {
+            for (size_t j = 0; j < numBlockSamples; j++) {
+                blockValues[j] = bitsToFloat(nestedUniformScramble(highBits ^ blockTable[j], dimensionSeed));
+            }
+        } else {
+            for (size_t j = 0; j < numBlockSamples; j++) {
+                blockValues[j] = bitsToFloat(highBits ^ blockTable[j]);
+            }
+        }
+        i += numBlockSamples;
+    }
+}
+
+}
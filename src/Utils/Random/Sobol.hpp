@@ -0,0 +1,42 @@
+/*
+ * Sobol.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_SOBOL_HPP_
+#define SYSTEM_RANDOM_SOBOL_HPP_
+
+#include "SampleSequence.hpp"
+
+namespace sgl {
+
+//! Number of dimensions with direction numbers (Joe & Kuo, new-joe-kuo-6.21201).
+#define SOBOL_MAX_DIMENSIONS 16
+
+/*! Sobol sequence with optional hash-based Owen scrambling. The first 2^m samples of every dimension are stratified
+ * into 2^m intervals, and the first two dimensions form a (0, m, 2)-net (also when scrambled).
+ * Supports 2^32 samples and up to SOBOL_MAX_DIMENSIONS dimensions. */
+class SobolSequence : public SampleSequence
+{
+public:
+    explicit SobolSequence(uint32_t numDimensions, bool scrambled = true, uint32_t seed = 0);
+    float getSample(uint32_t index, uint32_t dim) const;
+    //! Uses a table of the samples of the lowest eight index bits, so consecutive samples only need one lookup.
+    void fillDimension(uint32_t dim, uint32_t firstIndex, float *values, size_t numSamples) const;
+    //! The sample as 32-bit fixed point value.
+    uint32_t getSampleBits(uint32_t index, uint32_t dim) const;
+
+private:
+    uint32_t getUnscrambledBits(uint32_t index, uint32_t dim) const;
+    //! directionNumbers[dim * 32 + i] is XORed for bit i of the index.
+    std::vector<uint32_t> directionNumbers;
+    //! lowBitsTable[dim * 256 + i] is the unscrambled sample i.
+    std::vector<uint32_t> lowBitsTable;
+    std::vector<uint32_t> dimensionSeeds;
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_SOBOL_HPP_ */
@@ -30,4 +30,11 @@ uint32_t XorshiftRandomGenerator::xorshift96() // Period: 2^96-1
     return z;
 }
 
+void XorshiftRandomGenerator::generateUint32(uint32_t *values, size_t numValues)
+{
+    for (size_t i = 0; i < numValues; i++) {
+        values[i] = xorshift96();
+    }
+}
+
 }
@@ -20,6 +20,9 @@ public:
     virtual ~XorshiftRandomGenerator() {}
     uint32_t getRandomUint32() { return xorshift96(); }
 
+protected:
+    void generateUint32(uint32_t *values, size_t numValues);
+
 private:
     void initialize();
     uint32_t xorshift96();
@@ -0,0 +1,158 @@
+/*
+ * Xoshiro.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "Xoshiro.hpp"
+#include <Utils/CpuFeatures.hpp>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace sgl {
+
+static inline uint32_t rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t xoshiro128PlusNext(uint32_t s[4])
+{
+    const uint32_t result = s[0] + s[3];
+    const uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
+
+static void xoshiro128PlusScalar(uint32_t state[4][XOSHIRO_NUM_LANES], uint32_t *values, size_t numGroups)
+{
+    for (size_t group = 0; group < numGroups; group++) {
+        for (int lane = 0; lane < XOSHIRO_NUM_LANES; lane++) {
+            uint32_t s[4] = { state[0][lane], state[1][lane], state[2][lane], state[3][lane] };
+            values[group * XOSHIRO_NUM_LANES + lane] = xoshiro128PlusNext(s);
+            for (int i = 0; i < 4; i++) {
+                state[i][lane] = s[i];
+            }
+        }
+    }
+}
+
+#ifdef __SSE2__
+//! The lanes are processed as two halves of four lanes each.
+static void xoshiro128PlusSSE2(uint32_t state[4][XOSHIRO_NUM_LANES], uint32_t *values, size_t numGroups)
+{
+    for (int half = 0; half < 2; half++) {
+        __m128i s0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[0] + half * 4));
+        __m128i s1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[1] + half * 4));
+        __m128i s2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[2] + half * 4));
+        __m128i s3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state[3] + half * 4));
+        for (size_t group = 0; group < numGroups; group++) {
+            __m128i result = _mm_add_epi32(s0, s3);
+            __m128i t = _mm_slli_epi32(s1, 9);
+            s2 = _mm_xor_si128(s2, s0);
+            s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2);
+            s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values + group * XOSHIRO_NUM_LANES + half * 4), result);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[0] + half * 4), s0);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[1] + half * 4), s1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[2] + half * 4), s2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state[3] + half * 4), s3);
+    }
+}
+#define XOSHIRO_SSE2_KERNEL xoshiro128PlusSSE2
+#else
+#define XOSHIRO_SSE2_KERNEL nullptr
+#endif
+
+static const KernelTable<Xoshiro128PlusKernel> xoshiro128PlusKernels(
+        xoshiro128PlusScalar, XOSHIRO_SSE2_KERNEL, SGL_AVX2_KERNEL(xoshiro128PlusAVX2));
+
+//! SplitMix64, which is recommended for seeding the xoshiro generators.
+static uint64_t splitMix64(uint64_t &x)
+{
+    uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+//! Advances the state by 2^64 values.
+static void xoshiro128Jump(uint32_t s[4])
+{
+    static const uint32_t JUMP[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    uint32_t jumped[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 32; b++) {
+            if (JUMP[i] & (1u << b)) {
+                for (int j = 0; j < 4; j++) {
+                    jumped[j] ^= s[j];
+                }
+            }
+            xoshiro128PlusNext(s);
+        }
+    }
+    for (int j = 0; j < 4; j++) {
+        s[j] = jumped[j];
+    }
+}
+
+void Xoshiro128PlusRandomGenerator::initialize()
+{
+    uint64_t splitMixState = seed;
+    uint32_t s[4];
+    uint64_t bits = splitMix64(splitMixState);
+    s[0] = uint32_t(bits); s[1] = uint32_t(bits >> 32);
+    bits = splitMix64(splitMixState);
+    s[2] = uint32_t(bits); s[3] = uint32_t(bits >> 32);
+    if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+        // The all zero state is the only invalid one
+        s[0] = 1;
+    }
+
+    for (int lane = 0; lane < XOSHIRO_NUM_LANES; lane++) {
+        if (lane > 0) {
+            xoshiro128Jump(s);
+        }
+        for (int i = 0; i < 4; i++) {
+            state[i][lane] = s[i];
+        }
+    }
+    bufferPosition = XOSHIRO_NUM_LANES;
+}
+
+void Xoshiro128PlusRandomGenerator::generateGroups(uint32_t *values, size_t numGroups)
+{
+    xoshiro128PlusKernels.get()(state, values, numGroups);
+}
+
+void Xoshiro128PlusRandomGenerator::generateUint32(uint32_t *values, size_t numValues)
+{
+    size_t i = 0;
+    for (; i < numValues && bufferPosition < XOSHIRO_NUM_LANES; i++) {
+        values[i] = buffer[bufferPosition++];
+    }
+
+    size_t numGroups = (numValues - i) / XOSHIRO_NUM_LANES;
+    if (numGroups > 0) {
+        generateGroups(values + i, numGroups);
+        i += numGroups * XOSHIRO_NUM_LANES;
+    }
+
+    for (; i < numValues; i++) {
+        values[i] = getRandomUint32();
+    }
+}
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Xoshiro.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef SYSTEM_RANDOM_XOSHIRO_HPP_
+#define SYSTEM_RANDOM_XOSHIRO_HPP_
+
+#include "Random.hpp"
+#include "RandomKernels.hpp"
+
+namespace sgl {
+
+/*! xoshiro128+ (Blackman & Vigna) with XOSHIRO_NUM_LANES interleaved streams, so that the bulk functions can generate
+ * one value per stream at once using SSE2/AVX2. The streams are 2^64 values apart (using the jump function).
+ * getRandomUint32 returns the values in the same order as the bulk functions, so both can be mixed freely.
+ * The lowest bits have low linear complexity, which does not matter for floats (which use the upper 24 bits). */
+class Xoshiro128PlusRandomGenerator : public RandomGenerator
+{
+public:
+    Xoshiro128PlusRandomGenerator() : RandomGenerator() { initialize(); }
+    Xoshiro128PlusRandomGenerator(uint32_t _seed) : RandomGenerator(_seed) { initialize(); }
+    virtual ~Xoshiro128PlusRandomGenerator() {}
+    uint32_t getRandomUint32() {
+        if (bufferPosition == XOSHIRO_NUM_LANES) {
+            generateGroups(buffer, 1);
+            bufferPosition = 0;
+        }
+        return buffer[bufferPosition++];
+    }
+
+protected:
+    void generateUint32(uint32_t *values, size_t numValues);
+
+private:
+    void initialize();
+    //! Generates numGroups * XOSHIRO_NUM_LANES values.
+    void generateGroups(uint32_t *values, size_t numGroups);
+    uint32_t state[4][XOSHIRO_NUM_LANES];
+    //! Values of the last group not returned yet, starting at bufferPosition.
+    uint32_t buffer[XOSHIRO_NUM_LANES];
+    size_t bufferPosition;
+};
+
+}
+
+#endif /* SYSTEM_RANDOM_XOSHIRO_HPP_ */
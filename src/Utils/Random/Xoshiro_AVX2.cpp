@@ -0,0 +1,40 @@
+/*
+ * Xoshiro_AVX2.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "RandomKernels.hpp"
+
+#if defined(SGL_AVX2_KERNELS) && defined(__AVX2__)
+#include <immintrin.h>
+
+namespace sgl {
+
+void xoshiro128PlusAVX2(uint32_t state[4][XOSHIRO_NUM_LANES], uint32_t *values, size_t numGroups)
+{
+    __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[0]));
+    __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[1]));
+    __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[2]));
+    __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state[3]));
+    for (size_t group = 0; group < numGroups; group++) {
+        __m256i result = _mm256_add_epi32(s0, s3);
+        __m256i t = _mm256_slli_epi32(s1, 9);
+        s2 = _mm256_xor_si256(s2, s0);
+        s3 = _mm256_xor_si256(s3, s1);
+        s1 = _mm256_xor_si256(s1, s2);
+        s0 = _mm256_xor_si256(s0, s3);
+        s2 = _mm256_xor_si256(s2, t);
+        s3 = _mm256_or_si256(_mm256_slli_epi32(s3, 11), _mm256_srli_epi32(s3, 21));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + group * XOSHIRO_NUM_LANES), result);
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[0]), s0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[1]), s1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[2]), s2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state[3]), s3);
+}
+
+}
+
+#endif
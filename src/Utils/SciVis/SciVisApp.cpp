@@ -38,6 +38,7 @@
 #include <Graphics/Texture/TextureManager.hpp>
 #include <Graphics/Texture/Bitmap.hpp>
 #include <Graphics/OpenGL/SystemGL.hpp>
+#include <Graphics/OpenGL/GpuMemoryBudget.hpp>
 
 #include <ImGui/ImGuiWrapper.hpp>
 #include <ImGui/imgui_internal.h>
@@ -50,7 +51,6 @@ namespace sgl {
 SciVisApp::SciVisApp(float fovy)
         : camera(new sgl::Camera()), checkpointWindow(camera), videoWriter(NULL) {
     // https://www.khronos.org/registry/OpenGL/extensions/NVX/NVX_gpu_memory_info.txt
-    GLint gpuInitialFreeMemKilobytes = 0;
     if (usePerformanceMeasurementMode
         && sgl::SystemGL::get()->isGLExtensionAvailable("GL_NVX_gpu_memory_info")) {
         glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &gpuInitialFreeMemKilobytes);
@@ -272,6 +272,28 @@ void SciVisApp::renderGuiFpsCounter() {
         fpsCounter = sgl::Timer->getTicksMicroseconds();
     }
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / fps, fps);
+    sgl::FrameTimeStatistics frameTimeStatistics = frameStatistics.computeStatistics();
+    ImGui::Text("Frame time p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms",
+            frameTimeStatistics.p50MS, frameTimeStatistics.p95MS, frameTimeStatistics.p99MS, frameTimeStatistics.maxMS);
+    ImGui::Text("Hitches: %u of the last %u frames (%u in total)", unsigned(frameTimeStatistics.numHitches),
+            unsigned(frameTimeStatistics.numFrames), unsigned(frameStatistics.getTotalNumHitches()));
+    sgl::GpuMemoryBudget *gpuMemoryBudget = sgl::GpuMemoryBudget::get();
+    const float bytesToMiB = 1.0f / (1024.0f * 1024.0f);
+    ImGui::Text("GPU memory (estimate): %.1f MiB (textures %.1f MiB, buffers %.1f MiB)",
+            gpuMemoryBudget->getUsedBytes(sgl::GPU_MEMORY_TOTAL) * bytesToMiB,
+            gpuMemoryBudget->getUsedBytes(sgl::GPU_MEMORY_TEXTURES) * bytesToMiB,
+            (gpuMemoryBudget->getUsedBytes(sgl::GPU_MEMORY_GEOMETRY_BUFFERS)
+             + gpuMemoryBudget->getUsedBytes(sgl::GPU_MEMORY_SHADER_BUFFERS)) * bytesToMiB);
+    if (gpuMemoryBudget->getBudget(sgl::GPU_MEMORY_TOTAL) != 0) {
+        ImGui::Text("GPU memory budget: %.1f MiB (peak usage %.1f MiB)",
+                gpuMemoryBudget->getBudget(sgl::GPU_MEMORY_TOTAL) * bytesToMiB,
+                gpuMemoryBudget->getPeakBytes(sgl::GPU_MEMORY_TOTAL) * bytesToMiB);
+    }
+    bool showMetricsWindow = metricsWindow.getShowWindow();
+    if (ImGui::Checkbox("Show Metrics", &showMetricsWindow)) {
+        metricsWindow.setShowWindow(showMetricsWindow);
+    }
+    metricsWindow.renderGui();
     ImGui::Separator();
 }
 
@@ -33,6 +33,7 @@
 #include <Utils/SciVis/CameraPath.hpp>
 #include <Graphics/Video/VideoWriter.hpp>
 #include <ImGui/Widgets/CheckpointWindow.hpp>
+#include <ImGui/Widgets/MetricsWindow.hpp>
 #include <ImGui/imgui.h>
 
 namespace sgl {
@@ -119,6 +120,9 @@ protected:
     // For loading and saving camera checkpoints.
     sgl::CheckpointWindow checkpointWindow;
 
+    // Shows the counters of sgl::MetricsRegistry (e.g. loaded bytes, number of textures).
+    sgl::MetricsWindow metricsWindow;
+
     // For making performance measurements.
     bool usePerformanceMeasurementMode = false;
 
@@ -7,6 +7,12 @@
 
 #include <chrono>
 #include <thread>
+#include <algorithm>
+
+#ifndef _WIN32
+#include <time.h>
+#include <cerrno>
+#endif
 
 #include <SDL2/SDL.h>
 
@@ -14,8 +20,55 @@
 
 namespace sgl {
 
+#define NANOSECONDS_PER_SECOND 1000000000ull
+
+// Windows only sleeps with a granularity of ~1ms (or worse), so we need to spin-wait longer there
+#ifdef _WIN32
+#define DEFAULT_SPIN_WAIT_MICROSECONDS 2000
+#else
+#define DEFAULT_SPIN_WAIT_MICROSECONDS 500
+#endif
+
+/// Monotonic clock the frame deadlines refer to (CLOCK_MONOTONIC, as clock_nanosleep uses the same clock).
+static uint64_t getMonotonicNanoseconds()
+{
+#ifdef _WIN32
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#else
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return uint64_t(time.tv_sec) * NANOSECONDS_PER_SECOND + uint64_t(time.tv_nsec);
+#endif
+}
+
+/// Sleeps until the specified time of getMonotonicNanoseconds (or a bit later, depending on the OS).
+static void sleepUntilNanoseconds(uint64_t wakeUpTimeNS)
+{
+#ifdef _WIN32
+    uint64_t currentTimeNS = getMonotonicNanoseconds();
+    if (wakeUpTimeNS > currentTimeNS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(wakeUpTimeNS - currentTimeNS));
+    }
+#else
+    timespec wakeUpTime;
+    wakeUpTime.tv_sec = time_t(wakeUpTimeNS / NANOSECONDS_PER_SECOND);
+    wakeUpTime.tv_nsec = long(wakeUpTimeNS % NANOSECONDS_PER_SECOND);
+    // Absolute wake-up times are not prolonged if the sleep is interrupted by a signal
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeUpTime, NULL) == EINTR) {}
+#endif
+}
+
+/// ticks * multiplier / frequency without overflow for large tick values and without floating point precision loss.
+static inline uint64_t convertTicks(uint64_t ticks, uint64_t frequency, uint64_t multiplier)
+{
+    return ticks / frequency * multiplier + ticks % frequency * multiplier / frequency;
+}
+
 TimerInterface::TimerInterface() : currentTime(0), lastTime(0), elapsedMicroSeconds(0),
-        fpsLimitEnabled(true), fpsLimit(60), fixedPhysicsFPSEnabled(true), physicsFPS(60)
+        fpsLimitEnabled(true), fpsLimit(60), framePacingMode(FRAME_PACING_SLEEP),
+        spinWaitMicroseconds(DEFAULT_SPIN_WAIT_MICROSECONDS), nextFrameDeadlineNS(0), deadlineFPSLimit(0),
+        fixedPhysicsFPSEnabled(true), physicsFPS(60)
 {
     perfFreq = SDL_GetPerformanceFrequency();
     startFrameTime = SDL_GetPerformanceCounter();
@@ -28,7 +81,12 @@ void TimerInterface::sleepMilliseconds(unsigned int milliseconds)
 
 void TimerInterface::waitForFPSLimit()
 {
-    if (!fpsLimitEnabled) {
+    if (!fpsLimitEnabled || fpsLimit == 0) {
+        nextFrameDeadlineNS = 0;
+        return;
+    }
+    if (framePacingMode == FRAME_PACING_PRECISE) {
+        waitForFrameDeadline();
         return;
     }
 
@@ -43,6 +101,46 @@ void TimerInterface::waitForFPSLimit()
     }
 }
 
+void TimerInterface::waitForFrameDeadline()
+{
+    const uint64_t framePeriodNS = NANOSECONDS_PER_SECOND / fpsLimit;
+    uint64_t currentTimeNS = getMonotonicNanoseconds();
+
+    // If we are more than one frame behind (e.g. after loading data) or the FPS limit changed, restart the pacing from
+    // the current time instead of rendering the missed frames in a burst.
+    if (nextFrameDeadlineNS == 0 || deadlineFPSLimit != fpsLimit
+            || nextFrameDeadlineNS + framePeriodNS < currentTimeNS) {
+        nextFrameDeadlineNS = currentTimeNS + framePeriodNS;
+        deadlineFPSLimit = fpsLimit;
+        return;
+    }
+    // The deadlines advance by exactly one period, so rounding errors of the sleeps do not accumulate
+    const uint64_t deadlineNS = nextFrameDeadlineNS;
+    nextFrameDeadlineNS += framePeriodNS;
+
+    framePacingStatistics.numFrames++;
+    if (currentTimeNS >= deadlineNS) {
+        framePacingStatistics.numMissedDeadlines++;
+        return;
+    }
+
+    // Coarse sleep, then spin for the rest of the time
+    const uint64_t spinWaitNS = uint64_t(spinWaitMicroseconds) * 1000ull;
+    if (deadlineNS - currentTimeNS > spinWaitNS) {
+        sleepUntilNanoseconds(deadlineNS - spinWaitNS);
+    }
+    do {
+        currentTimeNS = getMonotonicNanoseconds();
+    } while (currentTimeNS < deadlineNS);
+
+    double errorMicroseconds = double(currentTimeNS - deadlineNS) * 1e-3;
+    uint64_t numOnTimeFrames = framePacingStatistics.numFrames - framePacingStatistics.numMissedDeadlines;
+    framePacingStatistics.meanErrorMicroseconds +=
+            (errorMicroseconds - framePacingStatistics.meanErrorMicroseconds) / double(numOnTimeFrames);
+    framePacingStatistics.maxErrorMicroseconds =
+            std::max(framePacingStatistics.maxErrorMicroseconds, errorMicroseconds);
+}
+
 void TimerInterface::update()
 {
     if (lastTime == 0) {
@@ -71,8 +169,12 @@ uint64_t TimerInterface::getTicksMicroseconds()
     auto duration = now.time_since_epoch();
     auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
     return microseconds;*/
-    uint64_t currentTime = static_cast<double>(SDL_GetPerformanceCounter() - startFrameTime) / perfFreq * 1e6;
-    return currentTime;
+    return convertTicks(SDL_GetPerformanceCounter() - startFrameTime, perfFreq, 1000000ull);
+}
+
+uint64_t TimerInterface::getTicksNanoseconds()
+{
+    return convertTicks(SDL_GetPerformanceCounter() - startFrameTime, perfFreq, NANOSECONDS_PER_SECOND);
 }
 
 }
@@ -15,6 +15,25 @@
 
 namespace sgl {
 
+/// How waitForFPSLimit waits for the end of the frame.
+enum FramePacingMode {
+    /// One sleep for slightly less than the remaining frame time, i.e., the frame rate is a bit above the FPS limit.
+    FRAME_PACING_SLEEP,
+    /// Sleeps until shortly before an absolute deadline and spin-waits for the rest. The deadlines advance by exactly
+    /// one frame period, so the frames are delivered at steady intervals without drift (e.g. for video recordings).
+    FRAME_PACING_PRECISE
+};
+
+/// Deviation of the wake-up times from the deadlines in the mode FRAME_PACING_PRECISE.
+struct DLL_OBJECT FramePacingStatistics {
+    uint64_t numFrames = 0;
+    /// Frames that were already past their deadline when waitForFPSLimit was called
+    uint64_t numMissedDeadlines = 0;
+    /// Wake-up time minus deadline (only for the frames that did not miss their deadline)
+    double meanErrorMicroseconds = 0.0;
+    double maxErrorMicroseconds = 0.0;
+};
+
 class TimerInterface
 {
 public:
@@ -25,6 +44,7 @@ public:
     void waitForFPSLimit();
 
     uint64_t getTicksMicroseconds();
+    uint64_t getTicksNanoseconds();
     float getTimeInSeconds() { return currentTime / 1e6; }
     uint64_t getElapsedMicroseconds() { return elapsedMicroSeconds; }
     float getElapsedSeconds() { return elapsedMicroSeconds / 1e6; }
@@ -43,6 +63,14 @@ public:
     }
     inline bool getFPSLimitEnabled() { return fpsLimitEnabled; }
     inline unsigned int getTargetFPS() { return fpsLimit; }
+    /// FRAME_PACING_SLEEP is the default.
+    inline void setFramePacingMode(FramePacingMode mode) { framePacingMode = mode; nextFrameDeadlineNS = 0; }
+    inline FramePacingMode getFramePacingMode() { return framePacingMode; }
+    /// The time before the deadline at which FRAME_PACING_PRECISE stops sleeping and starts spin-waiting.
+    /// Should be larger than the sleep granularity of the operating system.
+    inline void setSpinWaitMicroseconds(unsigned int microseconds) { spinWaitMicroseconds = microseconds; }
+    inline const FramePacingStatistics &getFramePacingStatistics() { return framePacingStatistics; }
+    inline void resetFramePacingStatistics() { framePacingStatistics = FramePacingStatistics(); }
 
     /// Sets whether we want fixed FPS for physics updates. You can place functions that expect this fixed
     /// FPS in AppSettings::fixedUpdate(float dt).
@@ -53,12 +81,20 @@ public:
     inline unsigned int getFixedPhysicsFPS() { return physicsFPS; }
 
 private:
+    void waitForFrameDeadline();
+
     uint64_t currentTime, lastTime, elapsedMicroSeconds;
     uint64_t perfFreq;
     uint64_t startFrameTime;
 
     bool fpsLimitEnabled;
     unsigned int fpsLimit;
+    FramePacingMode framePacingMode;
+    unsigned int spinWaitMicroseconds;
+    /// Absolute deadline of the current frame (monotonic clock), or 0 if the pacing needs to be restarted
+    uint64_t nextFrameDeadlineNS;
+    unsigned int deadlineFPSLimit;
+    FramePacingStatistics framePacingStatistics;
     bool fixedPhysicsFPSEnabled;
     unsigned int physicsFPS;
 };
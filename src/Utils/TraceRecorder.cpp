@@ -0,0 +1,275 @@
+/*
+ * TraceRecorder.cpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#include "TraceRecorder.hpp"
+#include <Utils/File/Logfile.hpp>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <fstream>
+#include <cstdio>
+
+namespace sgl {
+
+//! The fields are atomic, as the writer may overwrite a slot while the trace is written.
+struct TraceEventSlot {
+    std::atomic<const char*> name;
+    std::atomic<const char*> category;
+    std::atomic<uint64_t> startTimeNS;
+    std::atomic<uint64_t> durationNS;
+    std::atomic<uint32_t> flags;
+};
+
+#define TRACE_SLOT_FLAG_INSTANT 1u
+#define TRACE_SLOT_FLAG_GPU 2u
+
+/*! Ring buffer written by exactly one thread. Like a sequence lock, the writer increments beginCounter before and
+ * endCounter after writing a slot, so the reader can tell which of the copied slots may have been overwritten. */
+class TraceThreadBuffer
+{
+public:
+    TraceThreadBuffer(size_t capacity, uint32_t threadId) : capacity(capacity), mask(capacity - 1),
+            slots(new TraceEventSlot[capacity]), beginCounter(0), endCounter(0), clearedCounter(0),
+            threadId(threadId) {}
+
+    void write(const char *name, const char *category, uint64_t startTimeNS, uint64_t durationNS, uint32_t flags) {
+        const uint64_t index = endCounter.load(std::memory_order_relaxed);
+        beginCounter.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        TraceEventSlot &slot = slots[index & mask];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.startTimeNS.store(startTimeNS, std::memory_order_relaxed);
+        slot.durationNS.store(durationNS, std::memory_order_relaxed);
+        slot.flags.store(flags, std::memory_order_relaxed);
+        endCounter.store(index + 1, std::memory_order_release);
+    }
+
+    //! Appends the events that were completely written and not overwritten while copying.
+    void read(std::vector<TraceEvent> &events) {
+        const uint64_t end = endCounter.load(std::memory_order_acquire);
+        const uint64_t cleared = clearedCounter.load(std::memory_order_relaxed);
+        uint64_t begin = end > capacity ? end - capacity : 0;
+        begin = std::max(begin, cleared);
+
+        std::vector<TraceEvent> copiedEvents;
+        copiedEvents.reserve(size_t(end - begin));
+        for (uint64_t index = begin; index < end; index++) {
+            const TraceEventSlot &slot = slots[index & mask];
+            const uint32_t flags = slot.flags.load(std::memory_order_relaxed);
+            TraceEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.category = slot.category.load(std::memory_order_relaxed);
+            event.startTimeNS = slot.startTimeNS.load(std::memory_order_relaxed);
+            event.durationNS = slot.durationNS.load(std::memory_order_relaxed);
+            event.type = (flags & TRACE_SLOT_FLAG_INSTANT) != 0 ? TRACE_EVENT_INSTANT : TRACE_EVENT_COMPLETE;
+            event.gpu = (flags & TRACE_SLOT_FLAG_GPU) != 0;
+            copiedEvents.push_back(event);
+        }
+
+        // Index i is valid if the writer did not start writing index i + capacity yet
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writerBegin = beginCounter.load(std::memory_order_relaxed);
+        const uint64_t firstValid = writerBegin > capacity ? writerBegin - capacity : 0;
+        for (uint64_t index = begin; index < end; index++) {
+            if (index >= firstValid) {
+                events.push_back(copiedEvents.at(size_t(index - begin)));
+            }
+        }
+    }
+
+    inline void clear() { clearedCounter.store(endCounter.load(std::memory_order_acquire), std::memory_order_relaxed); }
+    inline uint32_t getThreadId() const { return threadId; }
+    //! Only accessed with the mutex of the recorder locked.
+    std::string threadName;
+
+private:
+    const uint64_t capacity;
+    const uint64_t mask;
+    std::unique_ptr<TraceEventSlot[]> slots;
+    std::atomic<uint64_t> beginCounter;
+    std::atomic<uint64_t> endCounter;
+    std::atomic<uint64_t> clearedCounter; //!< Only written by the reader
+    const uint32_t threadId;
+};
+
+static thread_local TraceThreadBuffer *currentThreadBuffer = nullptr;
+
+static uint64_t getSteadyClockNS()
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+TraceRecorder *TraceRecorder::get()
+{
+    static TraceRecorder *recorder = new TraceRecorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : recording(true), bufferCapacity(TRACE_DEFAULT_BUFFER_CAPACITY)
+{
+    startTimeNS = getSteadyClockNS();
+}
+
+void TraceRecorder::setBufferCapacity(size_t capacity)
+{
+    size_t powerOfTwo = 1;
+    while (powerOfTwo < capacity) {
+        powerOfTwo <<= 1;
+    }
+    bufferCapacity.store(powerOfTwo, std::memory_order_relaxed);
+}
+
+uint64_t TraceRecorder::getTimeNS() const
+{
+    return getSteadyClockNS() - startTimeNS;
+}
+
+TraceThreadBuffer *TraceRecorder::getThreadBuffer()
+{
+    if (currentThreadBuffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentThreadBuffer = new TraceThreadBuffer(
+                bufferCapacity.load(std::memory_order_relaxed), uint32_t(threadBuffers.size() + 1));
+        threadBuffers.push_back(currentThreadBuffer);
+    }
+    return currentThreadBuffer;
+}
+
+void TraceRecorder::recordCompleteEvent(const char *name, const char *category, uint64_t startTimeNS,
+        uint64_t durationNS, bool gpu)
+{
+    if (!getRecording()) {
+        return;
+    }
+    getThreadBuffer()->write(name, category, startTimeNS, durationNS, gpu ? TRACE_SLOT_FLAG_GPU : 0u);
+}
+
+void TraceRecorder::recordInstantEvent(const char *name, const char *category)
+{
+    if (!getRecording()) {
+        return;
+    }
+    getThreadBuffer()->write(name, category, getTimeNS(), 0, TRACE_SLOT_FLAG_INSTANT);
+}
+
+void TraceRecorder::setThreadName(const std::string &name)
+{
+    TraceThreadBuffer *threadBuffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(mutex);
+    threadBuffer->threadName = name;
+}
+
+const char *TraceRecorder::internString(const std::string &str)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return internedStrings.insert(str).first->c_str();
+}
+
+void TraceRecorder::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (TraceThreadBuffer *threadBuffer : threadBuffers) {
+        threadBuffer->clear();
+    }
+}
+
+void TraceRecorder::collectEvents(std::vector<TraceEvent> &events, std::vector<uint32_t> &threadIds)
+{
+    for (TraceThreadBuffer *threadBuffer : threadBuffers) {
+        threadBuffer->read(events);
+        threadIds.resize(events.size(), threadBuffer->getThreadId());
+    }
+}
+
+
+static void writeJsonString(std::ostream &stream, const char *str)
+{
+    stream << '"';
+    for (const char *c = str != nullptr ? str : ""; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            stream << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", unsigned(static_cast<unsigned char>(*c)));
+            stream << escaped;
+        } else {
+            stream << *c;
+        }
+    }
+    stream << '"';
+}
+
+//! Chrome traces use microseconds.
+static void writeMicroseconds(std::ostream &stream, uint64_t timeNS)
+{
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%llu.%03u",
+             static_cast<unsigned long long>(timeNS / 1000u), unsigned(timeNS % 1000u));
+    stream << buffer;
+}
+
+bool TraceRecorder::writeChromeJson(const std::string &filename)
+{
+    std::ofstream file(filename.c_str());
+    if (!file.is_open()) {
+        Logfile::get()->writeError(std::string() + "ERROR: TraceRecorder::writeChromeJson: Cannot open file \""
+                + filename + "\".");
+        return false;
+    }
+
+    std::vector<TraceEvent> events;
+    std::vector<uint32_t> threadIds;
+    std::vector<std::pair<uint32_t, std::string>> threadNames;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        collectEvents(events, threadIds);
+        for (TraceThreadBuffer *threadBuffer : threadBuffers) {
+            threadNames.push_back(std::make_pair(threadBuffer->getThreadId(), threadBuffer->threadName));
+        }
+    }
+
+    // CPU events belong to process 1, GPU regions to process 2 (with the thread ID of the thread that recorded them)
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n";
+    file << "{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":2,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+    for (const std::pair<uint32_t, std::string> &threadName : threadNames) {
+        for (int pid = 1; pid <= 2; pid++) {
+            std::string name = threadName.second.empty()
+                    ? std::string("Thread ") + std::to_string(threadName.first) : threadName.second;
+            file << ",\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" << pid << ",\"tid\":" << threadName.first
+                 << ",\"args\":{\"name\":";
+            writeJsonString(file, name.c_str());
+            file << "}}";
+        }
+    }
+    for (size_t i = 0; i < events.size(); i++) {
+        const TraceEvent &event = events.at(i);
+        file << ",\n{\"ph\":\"" << (event.type == TRACE_EVENT_INSTANT ? "i" : "X") << "\",\"name\":";
+        writeJsonString(file, event.name);
+        file << ",\"cat\":";
+        writeJsonString(file, event.category);
+        file << ",\"pid\":" << (event.gpu ? 2 : 1) << ",\"tid\":" << threadIds.at(i) << ",\"ts\":";
+        writeMicroseconds(file, event.startTimeNS);
+        if (event.type == TRACE_EVENT_INSTANT) {
+            file << ",\"s\":\"t\"}";
+        } else {
+            file << ",\"dur\":";
+            writeMicroseconds(file, event.durationNS);
+            file << "}";
+        }
+    }
+    file << "\n]}\n";
+    file.close();
+
+    Logfile::get()->write(std::string() + "INFO: Wrote " + std::to_string(events.size())
+            + " trace events to \"" + filename + "\".", BLUE);
+    return !file.fail();
+}
+
+}
@@ -0,0 +1,138 @@
+/*!
+ * TraceRecorder.hpp
+ *
+ *  Created on: 18.10.2026
+ *      Author: Christoph Neuhauser
+ */
+
+#ifndef UTILS_TRACERECORDER_HPP_
+#define UTILS_TRACERECORDER_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <Defs.hpp>
+
+/*
+ * Recording of timing regions for timeline tools (chrome://tracing, https://ui.perfetto.dev).
+ * The recorder is only compiled in if SGL_TRACING is defined (CMake option SGL_ENABLE_TRACING). Otherwise, all macros
+ * below expand to nothing, i.e., tracing has no cost at all.
+ * Usage:
+ *   void render() {
+ *       SGL_TRACE_SCOPE("render");
+ *       ...
+ *   }
+ *   sgl::TraceRecorder::get()->writeChromeJson("trace.json");
+ * The names and categories need to stay valid until the trace was written (e.g. string literals or interned strings).
+ */
+#ifdef SGL_TRACING
+#define SGL_TRACE_CONCAT_IMPL(a, b) a##b
+#define SGL_TRACE_CONCAT(a, b) SGL_TRACE_CONCAT_IMPL(a, b)
+#define SGL_TRACE_SCOPE(name) sgl::TraceScope SGL_TRACE_CONCAT(sglTraceScope, __LINE__)((name), "sgl")
+#define SGL_TRACE_SCOPE_CATEGORY(name, category) \
+        sgl::TraceScope SGL_TRACE_CONCAT(sglTraceScope, __LINE__)((name), (category))
+#define SGL_TRACE_INSTANT(name) sgl::TraceRecorder::get()->recordInstantEvent((name), "sgl")
+#define SGL_TRACE_THREAD_NAME(name) sgl::TraceRecorder::get()->setThreadName(name)
+#else
+#define SGL_TRACE_SCOPE(name)
+#define SGL_TRACE_SCOPE_CATEGORY(name, category)
+#define SGL_TRACE_INSTANT(name)
+#define SGL_TRACE_THREAD_NAME(name)
+#endif
+
+namespace sgl {
+
+//! Default number of events kept per thread (the oldest events are overwritten).
+#define TRACE_DEFAULT_BUFFER_CAPACITY (size_t(1) << 16)
+
+enum TraceEventType {
+    TRACE_EVENT_COMPLETE, //!< Region with start time and duration
+    TRACE_EVENT_INSTANT   //!< Point in time
+};
+
+struct DLL_OBJECT TraceEvent {
+    const char *name;
+    const char *category;
+    uint64_t startTimeNS; //!< Relative to the creation of the recorder
+    uint64_t durationNS;
+    TraceEventType type;
+    bool gpu; //!< GPU regions are shown on a separate track of the recording thread
+};
+
+class TraceThreadBuffer;
+
+/*! Records events in per-thread ring buffers. Recording is lock-free: Every thread only writes to its own buffer,
+ * and writing the trace copies the buffers using sequence counters, i.e., the trace can be written at any time while
+ * other threads keep recording. Only the registration of a new thread takes a lock. */
+class DLL_OBJECT TraceRecorder
+{
+public:
+    //! Thread-safe; the recorder is created on first use and never destroyed (threads may record until the exit).
+    static TraceRecorder *get();
+
+    //! Pauses/resumes recording (e.g. to only trace a few frames on demand). Recording is enabled by default.
+    inline void setRecording(bool recording) { this->recording.store(recording, std::memory_order_relaxed); }
+    inline bool getRecording() const { return recording.load(std::memory_order_relaxed); }
+    //! Number of events kept per thread. Only affects threads that did not record events yet.
+    void setBufferCapacity(size_t capacity);
+
+    //! Nanoseconds since the creation of the recorder (steady clock).
+    uint64_t getTimeNS() const;
+    void recordCompleteEvent(const char *name, const char *category, uint64_t startTimeNS, uint64_t durationNS,
+            bool gpu = false);
+    void recordInstantEvent(const char *name, const char *category);
+    //! Names the track of the calling thread (e.g. "Main", "Loader").
+    void setThreadName(const std::string &name);
+    //! Returns a copy of the string that stays valid for the lifetime of the recorder (for names built at runtime).
+    const char *internString(const std::string &str);
+
+    //! Writes all events currently in the buffers in the Chrome trace event format. Returns false on failure.
+    bool writeChromeJson(const std::string &filename);
+    //! Discards all recorded events.
+    void clear();
+
+private:
+    TraceRecorder();
+    TraceThreadBuffer *getThreadBuffer();
+    void collectEvents(std::vector<TraceEvent> &events, std::vector<uint32_t> &threadIds);
+
+    std::atomic<bool> recording;
+    std::atomic<size_t> bufferCapacity;
+    uint64_t startTimeNS;
+
+    //! Protects the list of buffers, the thread names and the interned strings
+    std::mutex mutex;
+    std::vector<TraceThreadBuffer*> threadBuffers;
+    std::set<std::string> internedStrings;
+};
+
+//! Records a complete event for the lifetime of the object.
+class DLL_OBJECT TraceScope
+{
+public:
+    TraceScope(const char *name, const char *category) : name(name), category(category) {
+        TraceRecorder *recorder = TraceRecorder::get();
+        startTimeNS = recorder->getRecording() ? recorder->getTimeNS() : UINT64_MAX;
+    }
+    ~TraceScope() {
+        if (startTimeNS != UINT64_MAX) {
+            TraceRecorder *recorder = TraceRecorder::get();
+            recorder->recordCompleteEvent(name, category, startTimeNS, recorder->getTimeNS() - startTimeNS);
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope &operator=(const TraceScope&) = delete;
+
+private:
+    const char *name;
+    const char *category;
+    uint64_t startTimeNS;
+};
+
+}
+
+/*! UTILS_TRACERECORDER_HPP_ */
+#endif